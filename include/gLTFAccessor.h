@@ -53,6 +53,9 @@ class gLTFAccessor
 		gLTFAccessor (void);
 		virtual ~gLTFAccessor (void) {};
 		void out (void); // prints the content of the gLTFAccessor
+		unsigned int getComponentCount (void) const; // Number of components of the type (e.g. 3 for VEC3)
+		unsigned int getComponentSize (void) const; // Size in bytes of the component type
+		unsigned int getDataSize (void) const; // Size in bytes of all elements (excluding the stride padding)
 
 		// Public members
 		int mComponentType; // default 0
@@ -29,7 +29,7 @@ THE SOFTWARE.
 #define __gLTFAnimation_H__
 
 #include <string>
-#include <map>
+#include <vector>
 #include <iostream>
 #include "gLTFAnimationChannel.h"
 #include "gLTFAnimationSampler.h"
@@ -38,6 +38,16 @@ THE SOFTWARE.
  This file contains the data struture of a gLFTAnimation.
 /************************************************************************************************/
 
+/*****************************************************************/
+/** Refers to a channel by the index of its animation and the    */
+/** index of the channel within that animation                   */
+/*****************************************************************/
+struct gLTFAnimationChannelHandle
+{
+	int mAnimation;
+	int mChannel;
+};
+
 /***************************************************/
 /** Class responsible that represents an Animation */
 /***************************************************/
@@ -50,8 +60,8 @@ class gLTFAnimation
 
 		// Public members
 		std::string mName;
-		std::map<int, gLTFAnimationChannel> mAnimationChannelsMap;
-		std::map<int, gLTFAnimationSampler> mAnimationSamplersMap;
+		std::vector<gLTFAnimationChannel> mAnimationChannels;
+		std::vector<gLTFAnimationSampler> mAnimationSamplers;
 
 		// Derived data
 };
@@ -0,0 +1,87 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __gLTFDocument_H__
+#define __gLTFDocument_H__
+
+#include <vector>
+#include "gLTFAccessor.h"
+#include "gLTFAnimation.h"
+#include "gLTFBuffer.h"
+#include "gLTFBufferView.h"
+#include "gLTFImage.h"
+#include "gLTFMaterial.h"
+#include "gLTFMesh.h"
+#include "gLTFNode.h"
+#include "gLTFSampler.h"
+#include "gLTFSkin.h"
+#include "gLTFTexture.h"
+
+/************************************************************************************************
+ This file contains the data struture of a gLTFDocument. The document holds all top level
+ arrays of a gLTF file; the index of an element in its array is the index used by the gLTF file.
+ The document is filled by the parsers and completed by the data propagation of the executor.
+ After that it isn't changed anymore and is shared (read only) by the creator classes.
+/************************************************************************************************/
+
+/*********************************************************/
+/** Class responsible that represents a parsed gLTF file */
+/*********************************************************/
+class gLTFDocument
+{
+	public:
+		gLTFDocument (void);
+		virtual ~gLTFDocument (void) {};
+		void clear (void); // Removes all elements
+		void out (void); // prints the content of the gLTFDocument
+
+		/* Elements refer to each other by index. These functions resolve the references; they return 0 if the 
+		 * reference is not set or invalid.
+		 */
+		const gLTFMesh* getMeshOfNode (const gLTFNode& node) const;
+		const gLTFNode* getParentNode (const gLTFNode& node) const;
+		const gLTFNode* getJointNode (const gLTFSkin& skin, size_t jointIndex) const;
+		const Ogre::Matrix4& getWorldTransformation (const gLTFNode& node) const; // Returns the identity matrix if not propagated
+
+		// Public members
+		std::vector<gLTFAccessor> mAccessors;
+		std::vector<gLTFMesh> mMeshes;
+		std::vector<gLTFMaterial> mMaterials;
+		std::vector<gLTFTexture> mTextures;
+		std::vector<gLTFImage> mImages;
+		std::vector<gLTFSampler> mSamplers;
+		std::vector<gLTFBufferView> mBufferViews;
+		std::vector<gLTFBuffer> mBuffers;
+		std::vector<gLTFNode> mNodes;
+		std::vector<gLTFAnimation> mAnimations;
+		std::vector<gLTFSkin> mSkins;
+
+		// Derived data
+		std::vector<Ogre::Matrix4> mNodeWorldTransformationsDerived; // World transformation of each node; indexed by node
+};
+
+#endif
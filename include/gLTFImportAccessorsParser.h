@@ -28,7 +28,7 @@ THE SOFTWARE.
 #ifndef __gLTFImportAccessorsParser_H__
 #define __gLTFImportAccessorsParser_H__
 
-#include <map>
+#include <vector>
 #include "gLTFImportConstants.h"
 #include "gLTFAccessor.h"
 #include "rapidjson/document.h"
@@ -38,20 +38,20 @@ class gLTFImportAccessorsParser
 {
 	public:
 		gLTFImportAccessorsParser (void) {
-			mAccessorsMap.clear();
+			mAccessors.clear();
 		};
 		virtual ~gLTFImportAccessorsParser (void) {};
 
 		// Parse the gLTF Accessors (level 1)
 		bool parseAccessors(rapidjson::Value::ConstMemberIterator jsonIterator);
 
-		// Returns the Accessors structure
-		const std::map<int, gLTFAccessor> getParsedAccessors(void) const;
+		// Moves the Accessors structure into the given vector; the parser is empty afterwards
+		void takeParsedAccessors(std::vector<gLTFAccessor>& accessors);
 
 	protected:
 
 	private:
-		std::map<int, gLTFAccessor> mAccessorsMap;
+		std::vector<gLTFAccessor> mAccessors;
 };
 
 #endif
@@ -28,7 +28,7 @@ THE SOFTWARE.
 #ifndef __gLTFImportAnimationChannelsParser_H__
 #define __gLTFImportAnimationChannelsParser_H__
 
-#include <map>
+#include <vector>
 #include "gLTFImportConstants.h"
 #include "gLTFAnimationChannel.h"
 #include "rapidjson/document.h"
@@ -39,22 +39,22 @@ class gLTFImportAnimationChannelsParser
 	public:
 		gLTFImportAnimationChannelsParser (void)
 		{
-			mAnimationChannelsMap.clear();
+			mAnimationChannels.clear();
 		};
 		virtual ~gLTFImportAnimationChannelsParser (void) {};
 
 		// Parse the gLTF AnimationChannels (level 1)
 		bool parseAnimationChannels (rapidjson::Value::ConstMemberIterator jsonIterator);
 
-		// Returns the AnimationChannels structure
-		const std::map<int, gLTFAnimationChannel> getParsedAnimationChannels (void) const;
+		// Moves the AnimationChannels structure into the given vector; the parser is empty afterwards
+		void takeParsedAnimationChannels (std::vector<gLTFAnimationChannel>& animationChannels);
 
 	protected:
 		bool parseTarget(rapidjson::Value::ConstMemberIterator jsonIterator,
 			gLTFAnimationChannel* animationChannel);
 
 	private:
-		std::map<int, gLTFAnimationChannel> mAnimationChannelsMap;
+		std::vector<gLTFAnimationChannel> mAnimationChannels;
 };
 
 #endif
@@ -28,7 +28,7 @@ THE SOFTWARE.
 #ifndef __gLTFImportAnimationSamplersParser_H__
 #define __gLTFImportAnimationSamplersParser_H__
 
-#include <map>
+#include <vector>
 #include "gLTFImportConstants.h"
 #include "gLTFAnimationSampler.h"
 #include "rapidjson/document.h"
@@ -39,20 +39,20 @@ class gLTFImportAnimationSamplersParser
 	public:
 		gLTFImportAnimationSamplersParser (void)
 		{
-			mAnimationSamplersMap.clear();
+			mAnimationSamplers.clear();
 		};
 		virtual ~gLTFImportAnimationSamplersParser (void) {};
 
 		// Parse the gLTF AnimationSamplers (level 1)
 		bool parseAnimationSamplers (rapidjson::Value::ConstMemberIterator jsonIterator);
 
-		// Returns the AnimationSamplers structure
-		const std::map<int, gLTFAnimationSampler> getParsedAnimationSamplers (void) const;
+		// Moves the AnimationSamplers structure into the given vector; the parser is empty afterwards
+		void takeParsedAnimationSamplers (std::vector<gLTFAnimationSampler>& animationSamplers);
 
 	protected:
 
 	private:
-		std::map<int, gLTFAnimationSampler> mAnimationSamplersMap;
+		std::vector<gLTFAnimationSampler> mAnimationSamplers;
 };
 
 #endif
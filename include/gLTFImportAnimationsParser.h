@@ -28,7 +28,7 @@ THE SOFTWARE.
 #ifndef __gLTFImportAnimationsParser_H__
 #define __gLTFImportAnimationsParser_H__
 
-#include <map>
+#include <vector>
 #include "gLTFImportConstants.h"
 #include "gLTFAnimation.h"
 #include "gLTFImportAnimationChannelsParser.h"
@@ -41,20 +41,20 @@ class gLTFImportAnimationsParser
 	public:
 		gLTFImportAnimationsParser (void)
 		{
-			mAnimationsMap.clear();
+			mAnimations.clear();
 		};
 		virtual ~gLTFImportAnimationsParser (void) {};
 
 		// Parse the gLTF Animations (level 1)
 		bool parseAnimations (rapidjson::Value::ConstMemberIterator jsonIterator);
 
-		// Returns the animations structure
-		const std::map<int, gLTFAnimation> getParsedAnimations(void) const;
+		// Moves the animations structure into the given vector; the parser is empty afterwards
+		void takeParsedAnimations(std::vector<gLTFAnimation>& animations);
 
 	protected:
 
 	private:
-		std::map<int, gLTFAnimation> mAnimationsMap;
+		std::vector<gLTFAnimation> mAnimations;
 		gLTFImportAnimationChannelsParser mAnimationChannelsParser;
 		gLTFImportAnimationSamplersParser mAnimationSamplersParser;
 };
@@ -0,0 +1,87 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#ifndef __gLTFImportBonePartitioner_H__
+#define __gLTFImportBonePartitioner_H__
+
+#include <vector>
+#include "gLTFImportConstants.h"
+#include "gLTFStagedSubmesh.h"
+#include "gLTFImportThreadPool.h"
+#include "gLTFImportSpatialSplitter.h"
+
+/** Class responsible for splitting a skinned submesh into partitions that each reference a limited number of bones,
+	so each partition can be skinned on the GPU with one bone palette.
+*/
+class gLTFImportBonePartitioner
+{
+	public:
+		gLTFImportBonePartitioner (void) {};
+		virtual ~gLTFImportBonePartitioner (void) {};
+
+		/* Split the triangles of the submesh into partitions that each reference at most maxBones bones. The triangles
+		 * are grouped greedily; a partition takes every remaining triangle that still fits in its palette, so as few 
+		 * partitions as possible are created. Each partition gets its own compacted vertex range and a bone palette 
+		 * (mBonePalette), which maps the palette index to the bone id.
+		 * A triangle that references more than maxBones bones on its own gets a partition of its own.
+		 * Returns false (and leaves partitions empty) if the submesh is not a triangle list, has no bone influences 
+		 * or already references at most maxBones bones.
+		 */
+		bool partition (const gLTFStagedSubmesh& submesh,
+			unsigned int maxBones,
+			gLTFImportThreadPool& threadPool,
+			std::vector<gLTFStagedSubmesh>& partitions);
+
+		// Returns the number of triangles of the last partitioned submesh that exceed maxBones on their own
+		size_t getOversizedTriangleCount (void) const { return mOversizedTriangleCount; };
+
+	protected:
+		// Determine the bones (with a weight > 0) of each triangle
+		void collectTriangleBones (const gLTFStagedSubmesh& submesh);
+
+		// Add the bones of a triangle to the current palette if they fit; returns false if they don't fit
+		bool addTriangleToPalette (unsigned int triangle, unsigned int maxBones, bool force);
+
+		// Determine the sorted bone ids used by the vertices of a partition
+		void createBonePalette (gLTFStagedSubmesh& partition);
+
+	private:
+		std::vector<unsigned int> mHelperTriangleBones; // Up to 12 bone ids per triangle
+		std::vector<unsigned int> mHelperTriangleBoneStart; // Start of the bones of a triangle (one extra entry at the end)
+		std::vector<unsigned int> mHelperPaletteStamp; // Per bone id; equals mPaletteStamp if the bone is in the current palette
+		unsigned int mPaletteStamp = 0;
+		unsigned int mPaletteSize = 0;
+		std::vector<unsigned int> mHelperTriangles; // Triangle order; the partitions are consecutive ranges
+		std::vector<unsigned int> mHelperRemaining;
+		std::vector<unsigned int> mHelperRejected;
+		std::vector<gLTFImportSpatialSplitter::Range> mHelperRanges;
+		size_t mOversizedTriangleCount = 0;
+		gLTFImportSpatialSplitter mSpatialSplitter; // Used to create the compacted partitions
+};
+
+#endif
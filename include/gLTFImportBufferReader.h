@@ -29,6 +29,7 @@ THE SOFTWARE.
 #define __gLTFImportBufferReader_H__
 
 #include <map>
+#include <vector>
 #include "gLTFImportConstants.h"
 #include "gLTFAccessor.h"
 #include "OgreVector2.h"
@@ -99,6 +100,19 @@ class gLTFImportBufferReader
 		const Ogre::Vector4& readVec4FromFloatBuffer (char* buffer, int count, gLTFAccessor accessor, bool applyMinMax = false);
 		const Ogre::Vector4& skipAndReadVec4FromFloatBuffer (char* buffer, unsigned int skipBytes, gLTFAccessor accessor, bool applyMinMax = false);
 
+		/* Read all elements of a VEC4 accessor (UNSIGNED_BYTE, UNSIGNED_SHORT or FLOAT) at once; values gets 4 floats
+		 * per element. Returns false (and leaves values empty) if the accessor has another type.
+		 */
+		bool readVec4ArrayFromBuffer (const char* buffer, const gLTFAccessor& accessor, std::vector<float>& values);
+
+		/* Read all elements of a FLOAT accessor (of any type) at once; values gets the components of each element.
+		 * Returns false (and leaves values empty) if the accessor has another component type.
+		 */
+		bool readFloatArrayFromBuffer (const char* buffer, const gLTFAccessor& accessor, std::vector<float>& values);
+
+		// Returns the largest value of the array (SIMD reduction); returns 0 if count is 0
+		float computeMaxOfArray (const float* values, size_t count);
+
 		// Read Matrix4
 		const Ogre::Matrix4& readMatrix4FromFloatBuffer (char* buffer, int count, gLTFAccessor accessor, bool applyMinMax = false);
 
@@ -106,6 +120,7 @@ class gLTFImportBufferReader
 		void correctVec2WithMinMax (gLTFAccessor accessor, Ogre::Vector2* vec2);
 		void correctVec3WithMinMax (gLTFAccessor accessor, Ogre::Vector3* vec3);
 		void correctVec4WithMinMax (gLTFAccessor accessor, Ogre::Vector4* vec4);
+		void correctArrayWithMinMax (const gLTFAccessor& accessor, std::vector<float>& values); // Values read by readFloatArrayFromBuffer
 
 	//protected:
 
@@ -28,7 +28,7 @@ THE SOFTWARE.
 #ifndef __gLTFImportBufferViewsParser_H__
 #define __gLTFImportBufferViewsParser_H__
 
-#include <map>
+#include <vector>
 #include "gLTFImportConstants.h"
 #include "gLTFBufferView.h"
 #include "rapidjson/document.h"
@@ -39,20 +39,20 @@ class gLTFImportBufferViewsParser
 	public:
 		gLTFImportBufferViewsParser (void)
 		{
-			mBufferViewsMap.clear();
+			mBufferViews.clear();
 		};
 		virtual ~gLTFImportBufferViewsParser (void) {};
 
 		// Parse the gLTF BufferViews (level 1)
 		bool parseBufferViews (rapidjson::Value::ConstMemberIterator jsonIterator);
 
-		// Returns the BufferViews structure
-		const std::map<int, gLTFBufferView> getParsedBufferViews (void) const;
+		// Moves the BufferViews structure into the given vector; the parser is empty afterwards
+		void takeParsedBufferViews (std::vector<gLTFBufferView>& bufferViews);
 
 	protected:
 
 	private:
-		std::map<int, gLTFBufferView> mBufferViewsMap;
+		std::vector<gLTFBufferView> mBufferViews;
 };
 
 #endif
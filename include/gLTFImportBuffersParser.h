@@ -28,7 +28,7 @@ THE SOFTWARE.
 #ifndef __gLTFImportBuffersParser_H__
 #define __gLTFImportBuffersParser_H__
 
-#include <map>
+#include <vector>
 #include "gLTFImportConstants.h"
 #include "gLTFBuffer.h"
 #include "rapidjson/document.h"
@@ -43,13 +43,13 @@ class gLTFImportBuffersParser
 		// Parse the gLTF Buffers (level 1)
 		bool parseBuffers (const std::string& fileName, rapidjson::Value::ConstMemberIterator jsonIterator); // Include the name of the json/glb file
 
-		// Returns the Buffers structure
-		const std::map<int, gLTFBuffer> getParsedBuffers (void) const;
+		// Moves the Buffers structure into the given vector; the parser is empty afterwards
+		void takeParsedBuffers (std::vector<gLTFBuffer>& buffers);
 
 	protected:
 
 	private:
-		std::map<int, gLTFBuffer> mBuffersMap;
+		std::vector<gLTFBuffer> mBuffers;
 };
 
 #endif
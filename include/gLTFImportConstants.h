@@ -29,6 +29,7 @@ THE SOFTWARE.
 #define __gLTFImportConstants_H__
 
 #include <string>
+#include <vector>
 #include <sstream>
 #include <fstream>
 #include <ctime>
@@ -47,6 +48,13 @@ struct Devnull : std::ostream, std::streambuf
 // Disable the line below when using gLTFTEST, because otherwise Ogre::Image (used for texture transformation) does not work
 #define USE_OGRE_IN_PLUGIN 1
 
+//---------------------------------------------------------------------
+// SSE2 is always available on x64 (and on x86 when compiled with /arch:SSE2); otherwise the scalar code path is used
+#if defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+	#define GLTF_IMPORT_SSE2 1
+	#include <emmintrin.h>
+#endif
+
 //---------------------------------------------------------------------
 static const std::string TAB = "  ";
 static const std::string TABx2 = TAB + TAB;
@@ -61,7 +69,30 @@ static const std::string TABx10 = TAB + TABx9;
 
 static std::string gFileExtension = "";
 static std::string gJsonString = "";
-static const unsigned int MAX_JOINTS_PER_SKIN = 1000;
+static const float KEYFRAME_TIME_TOLERANCE = 0.0001f; // Keyframe times (in seconds) that differ less are regarded equal
+
+//---------------------------------------------------------------------
+/* Checked access to an element of one of the arrays of the gLTF document (accessors, meshes, nodes, ...). The 
+ * arrays are stored densely, so the index in the gLTF file is the index in the vector. Returns 0 if the index 
+ * is out of range (e.g. -1 for a property that is not set).
+ */
+template <typename T>
+const T* getElementByIndex (const std::vector<T>& elements, int index)
+{
+	if (index < 0 || static_cast<size_t>(index) >= elements.size())
+		return 0;
+
+	return &elements[index];
+}
+
+template <typename T>
+T* getElementByIndex (std::vector<T>& elements, int index)
+{
+	if (index < 0 || static_cast<size_t>(index) >= elements.size())
+		return 0;
+
+	return &elements[index];
+}
 
 //---------------------------------------------------------------------
 static const std::string& getFileExtension (const std::string& fileName)
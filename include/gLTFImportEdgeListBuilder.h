@@ -0,0 +1,110 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#ifndef __gLTFImportEdgeListBuilder_H__
+#define __gLTFImportEdgeListBuilder_H__
+
+#include <vector>
+#include <fstream>
+#include "gLTFImportConstants.h"
+#include "gLTFStagedSubmesh.h"
+#include "gLTFImportThreadPool.h"
+
+/** Class responsible for building the edge list (used by stencil shadows) of a mesh, so the OgreMeshTool does not
+	have to rebuild the adjacency from the xml file.
+*/
+class gLTFImportEdgeListBuilder
+{
+	public:
+		gLTFImportEdgeListBuilder (void);
+		virtual ~gLTFImportEdgeListBuilder (void) {};
+
+		// Start a new edge list
+		void clear (void);
+
+		/* Add the staged submesh in the order it is written to the mesh. Only the positions and indices are copied.
+		 * The submesh index is the index of the submesh in the mesh; it is written as vertex set and index set.
+		 * Submeshes that are not a triangle list are ignored (Ogre ignores them as well). A triangle list without 
+		 * indices cannot be part of the edge list; the edge list is then marked incomplete.
+		 */
+		void addSubmesh (const gLTFStagedSubmesh& submesh, unsigned int submeshIndex);
+
+		/* Build the edge list. The vertices of each submesh are welded by position and the edges are connected
+		 * with a hash map of welded edges. The submeshes are processed in parallel.
+		 */
+		void build (gLTFImportThreadPool& threadPool);
+
+		// Write the <edgelists> element; returns false if the edge list is incomplete or empty
+		bool writeToMesh (std::ofstream& dst);
+
+		// Returns true if all triangle submeshes could be added
+		bool isComplete (void) const { return mComplete; };
+
+		// Returns the total number of edges
+		size_t getEdgeCount (void) const;
+
+		// Returns the number of edges that have only one triangle
+		size_t getDegenerateEdgeCount (void) const;
+
+	protected:
+		struct Triangle
+		{
+			unsigned int vertex[3]; // Vertex index in the submesh
+			unsigned int sharedVertex[3]; // Welded vertex index in the submesh
+		};
+
+		struct Edge
+		{
+			unsigned int triangle[2]; // Triangle index in the submesh; triangle[1] is only valid if the edge is not degenerate
+			unsigned int vertex[2];
+			unsigned int sharedVertex[2];
+			bool degenerate;
+		};
+
+		struct SubmeshEdges
+		{
+			unsigned int submeshIndex = 0; // Index of the submesh in the mesh (vertex set and index set)
+			std::vector<float> positionsX;
+			std::vector<float> positionsY;
+			std::vector<float> positionsZ;
+			std::vector<unsigned int> indices;
+			std::vector<unsigned int> sharedVertices; // Welded index per vertex
+			unsigned int sharedVertexCount = 0;
+			std::vector<Triangle> triangles;
+			std::vector<Edge> edges;
+		};
+
+		// Weld the vertices and connect the edges of one submesh
+		void buildSubmesh (SubmeshEdges& submesh);
+
+	private:
+		std::vector<SubmeshEdges> mSubmeshes;
+		bool mComplete;
+};
+
+#endif
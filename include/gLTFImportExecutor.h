@@ -28,10 +28,11 @@ THE SOFTWARE.
 #ifndef __gLTFImportExecutor_H__
 #define __gLTFImportExecutor_H__
 
-#include <map>
+#include <vector>
 #include "hlms_editor_plugin.h"
 #include "gLTFImportConstants.h"
 #include "gLTFMaterial.h"
+#include "gLTFDocument.h"
 #include "gLTFImportAccessorsParser.h"
 #include "gLTFImportMeshesParser.h"
 #include "gLTFImportMaterialsParser.h"
@@ -90,11 +91,13 @@ class gLTFImportExecutor
 		bool propagateMaterials (Ogre::HlmsEditorPluginData* data, int startBinaryBuffer); // Materials are enriched with data from BufferViews, Textures and Images
 		bool propagateAccessors(void); // Accessors are enriched with data from Buffers and BufferViews
 		bool propagateMeshes (Ogre::HlmsEditorPluginData* data); // Primitives are enriched with data from Materials and Accessors
+		void pruneUnusedVertexAttributes (gLTFPrimitive& primitive); // Remove the attributes that are not used by the material
 		bool propagateNodes(Ogre::HlmsEditorPluginData* data);
 		bool propagateAnimations (Ogre::HlmsEditorPluginData* data);
 		bool propagateSkins(Ogre::HlmsEditorPluginData* data);
-		gLTFNode* getTopLevelParentNode (gLTFNode* childNode); // Searches the highest parent in the tree
-		void propagateNodeTransformsToChildren (gLTFNode* node); // Transforms are inherited from the parent
+		void propagateNodeTransformsFromRoot (int rootNodeIndex, 
+			std::vector<int>& queue, 
+			std::vector<bool>& visited); // Transforms are inherited from the parent
 		
 		// Utils
 		const gLTFImage& getImageByTextureIndex (int index);
@@ -102,7 +105,7 @@ class gLTFImportExecutor
 		const std::string& getImageUriByTextureIndex (int index);
 		int getSamplerByTextureIndex (int index);
 		const std::string& getMaterialNameByIndex (int index);
-		void addAnimationsToNode (gLTFNode* node, int nodeIndex); // Add all animations in which a node participates
+		void indexAnimationChannels (void); // Adds a handle of each animation channel to the node it targets
 		const std::string& prepareUri(const std::string&  textureName,
 			Ogre::HlmsEditorPluginData* data,
 			const std::string&  materialName,
@@ -113,7 +116,7 @@ class gLTFImportExecutor
 		gLTFNode* findNodeByIndex (int nodeIndex);
 		void writeTextureEntryToConfig (std::ofstream& texFile, const std::string& uriImage, int& texCount);
 		const std::string& getImageIndexAsString (int textureIndex);
-		gLTFAnimationSampler getAnimationSamplerByAnimationAndSamplerIndex (gLTFAnimation* animation, int samplerIndex);
+		const gLTFAnimationSampler* getAnimationSamplerByAnimationAndSamplerIndex (const gLTFAnimation* animation, int samplerIndex); // Returns 0 if the index is invalid
 		
 		// Copy / extract and texture conversion
 		const std::string& copyImageFile (const std::string& textureName,
@@ -151,19 +154,8 @@ class gLTFImportExecutor
 		gLTFImage mHelperImage;
 		std::string mHelperUri;
 		std::string mHelperOutputFile;
-		gLTFAnimation mHelperAnimation;
-		gLTFAnimationSampler mHelperAnimationSampler;
-		std::map<int, gLTFAccessor> mAccessorsMap;
-		std::map<int, gLTFMesh> mMeshesMap;
-		std::map<int, gLTFMaterial> mMaterialsMap;
-		std::map<int, gLTFTexture> mTexturesMap;
-		std::map<int, gLTFImage> mImagesMap;
-		std::map<int, gLTFSampler> mSamplersMap;
-		std::map<int, gLTFBufferView> mBufferViewsMap;
-		std::map<int, gLTFBuffer> mBuffersMap;
-		std::map<int, gLTFNode> mNodesMap;
-		std::map<int, gLTFAnimation> mAnimationsMap;
-		std::map<int, gLTFSkin> mSkinsMap;
+		gLTFDocument mDocument; // Filled by the parsers, completed by propagateData and read by the creators
+		gLTFImportOptions mOptions; // Resolved once per import in executeImport
 
 		gLTFImportAccessorsParser mAccessorsParser;
 		gLTFImportMeshesParser mMeshesParser;
@@ -28,7 +28,7 @@ THE SOFTWARE.
 #ifndef __gLTFImportImagesParser_H__
 #define __gLTFImportImagesParser_H__
 
-#include <map>
+#include <vector>
 #include "gLTFImportConstants.h"
 #include "gLTFImage.h"
 #include "rapidjson/document.h"
@@ -39,20 +39,20 @@ class gLTFImportImagesParser
 	public:
 		gLTFImportImagesParser (void)
 		{
-			mImagesMap.clear();
+			mImages.clear();
 		};
 		virtual ~gLTFImportImagesParser (void) {};
 
 		// Parse the gLTF images (level 1)
 		bool parseImages (rapidjson::Value::ConstMemberIterator jsonIterator);
 
-		// Returns the images structure
-		const std::map<int, gLTFImage> getParsedImages (void) const;
+		// Moves the images structure into the given vector; the parser is empty afterwards
+		void takeParsedImages (std::vector<gLTFImage>& images);
 
 	protected:
 
 	private:
-		std::map<int, gLTFImage> mImagesMap;
+		std::vector<gLTFImage> mImages;
 };
 
 #endif
@@ -0,0 +1,139 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#ifndef __gLTFImportKeyframeMerger_H__
+#define __gLTFImportKeyframeMerger_H__
+
+#include <vector>
+#include "OgreVector3.h"
+#include "OgreQuaternion.h"
+
+/** Class responsible for combining the translation, rotation and scale channels of one bone into Ogre keyframes.
+	The samples are kept in flat arrays and the sorted times of the channels are combined with a k-way merge, so the 
+	keyframes are built in linear time. The arrays keep their capacity between bones.
+	The channels are evaluated with their gLTF interpolation (LINEAR, STEP or CUBICSPLINE). Because Ogre only 
+	interpolates linearly, STEP and CUBICSPLINE channels are only played back correctly between their keyframes if the
+	channels are resampled at a fixed rate.
+*/
+class gLTFImportKeyframeMerger
+{
+	public:
+		enum Path
+		{
+			TRANSLATION,
+			ROTATION,
+			SCALE
+		};
+
+		enum Interpolation
+		{
+			LINEAR,
+			STEP,
+			CUBICSPLINE
+		};
+
+		struct Keyframe
+		{
+			float time = 0.0f;
+			bool hasTranslation = false;
+			Ogre::Vector3 translation;
+			bool hasRotation = false;
+			Ogre::Quaternion rotation;
+			bool hasScale = false;
+			Ogre::Vector3 scale;
+		};
+
+		gLTFImportKeyframeMerger (void) {};
+		virtual ~gLTFImportKeyframeMerger (void) {};
+
+		// Remove the channels and keyframes
+		void clear (void);
+
+		/* Add the decoded samples of a channel. The times must be increasing (required by the gLTF specs). The values
+		 * contain 3 (translation, scale) or 4 (rotation, xyzw) floats per time; for a CUBICSPLINE channel each time has
+		 * an in-tangent, a value and an out-tangent. Returns false if the number of values does not match the number 
+		 * of times.
+		 */
+		bool addChannel (Path path, Interpolation interpolation, const std::vector<float>& times, const std::vector<float>& values);
+
+		/* Merge the times of all channels into keyframes. Times that differ at most 'tolerance' from the smallest
+		 * pending time are regarded as the same keyframe. A channel without a sample at the time of a keyframe is 
+		 * evaluated at that time, so each keyframe contains the paths of all channels.
+		 */
+		void merge (float tolerance);
+
+		/* Create keyframes at a fixed rate (per second) from the first to the last time of the channels. The channels
+		 * are evaluated in batches per channel.
+		 */
+		void resample (float rate);
+
+		// Evaluate a channel at the given time (clamped to its first and last time); value gets 3 or 4 floats
+		void evaluate (size_t channelIndex, float time, float* value) const;
+
+		const std::vector<Keyframe>& getKeyframes (void) const { return mKeyframes; };
+
+	protected:
+		struct Channel
+		{
+			Path path;
+			Interpolation interpolation;
+			size_t firstTime; // Index in mTimes
+			size_t timeCount;
+			size_t firstValue; // Index in mValues
+			size_t components; // 3 or 4
+		};
+
+		// Value (not a tangent) of sample i
+		const float* getValue (const Channel& channel, size_t i) const;
+
+		// Evaluate a channel between sample 'segment' and the next sample
+		void evaluateSegment (const Channel& channel, size_t segment, float time, float* value) const;
+
+		// Evaluate a LINEAR channel at mHelperTimes; SIMD lerp (translation, scale) or slerp (rotation) into mHelperResult
+		void evaluateLinearBatch (const Channel& channel);
+
+		// Set the path of a channel in a keyframe
+		void setKeyframeValue (Keyframe& keyframe, Path path, const float* value) const;
+
+	private:
+		std::vector<Channel> mChannels;
+		std::vector<float> mTimes; // Times of all channels
+		std::vector<float> mValues; // Values (and tangents) of all channels
+		std::vector<size_t> mCursors; // Next time per channel during the merge
+		std::vector<Keyframe> mKeyframes;
+
+		// Batch evaluation of resampled channels
+		std::vector<float> mHelperTimes;
+		std::vector<float> mHelperA;
+		std::vector<float> mHelperB;
+		std::vector<float> mHelperWeightsA;
+		std::vector<float> mHelperWeightsB;
+		std::vector<float> mHelperResult;
+};
+
+#endif
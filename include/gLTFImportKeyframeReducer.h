@@ -0,0 +1,76 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#ifndef __gLTFImportKeyframeReducer_H__
+#define __gLTFImportKeyframeReducer_H__
+
+#include <vector>
+#include "gLTFImportKeyframeMerger.h"
+
+/** Class responsible for removing the keyframes of a bone track that can be rebuilt by interpolating the remaining 
+	keyframes within a position, rotation and scale tolerance. Sampled animations (e.g. motion capture) often have a 
+	keyframe per frame on every bone, of which many are constant or linear over long spans.
+	A missing translation, rotation or scale in a keyframe is regarded as its default value (zero, identity, one), 
+	which is also how Ogre reads it. The reducer is stateless during reduce(), so tracks can be reduced in parallel.
+*/
+class gLTFImportKeyframeReducer
+{
+	public:
+		gLTFImportKeyframeReducer (void);
+		virtual ~gLTFImportKeyframeReducer (void) {};
+
+		// The rotation tolerance is the angle in radians
+		void setTolerances (float positionTolerance, float rotationTolerance, float scaleTolerance);
+
+		/* Remove the keyframes of a track (sorted by time) that are within the tolerances of the interpolation between
+		 * the keyframes that are kept. The first and last keyframe are always kept. Returns the number of removed keyframes.
+		 */
+		size_t reduce (std::vector<gLTFImportKeyframeMerger::Keyframe>& keyframes) const;
+
+		// Returns true if all keyframes are within the tolerances of the given (bind) pose
+		bool isConstant (const std::vector<gLTFImportKeyframeMerger::Keyframe>& keyframes,
+			const Ogre::Vector3& position,
+			const Ogre::Quaternion& rotation,
+			const Ogre::Vector3& scale) const;
+
+	protected:
+		// Returns true if the keyframe can be rebuilt by interpolating between 'first' and 'last' at its time
+		bool isReconstructable (const gLTFImportKeyframeMerger::Keyframe& first,
+			const gLTFImportKeyframeMerger::Keyframe& last,
+			const gLTFImportKeyframeMerger::Keyframe& keyframe) const;
+
+		bool isPositionEqual (const Ogre::Vector3& a, const Ogre::Vector3& b, float tolerance) const;
+		bool isRotationEqual (const Ogre::Quaternion& a, const Ogre::Quaternion& b) const;
+
+	private:
+		float mPositionTolerance;
+		float mScaleTolerance;
+		float mMaxRotationDistance; // Distance between normalized quaternions that corresponds with the rotation tolerance
+};
+
+#endif
@@ -28,7 +28,7 @@ THE SOFTWARE.
 #ifndef __gLTFImportMaterialsParser_H__
 #define __gLTFImportMaterialsParser_H__
 
-#include <map>
+#include <vector>
 #include "gLTFImportConstants.h"
 #include "gLTFMaterial.h"
 #include "rapidjson/document.h"
@@ -43,8 +43,8 @@ class gLTFImportMaterialsParser
 		// Parse the gLTF materials (level 1)
 		bool parseMaterials(rapidjson::Value::ConstMemberIterator jsonIterator);
 
-		// Returns the material structure
-		const std::map<int, gLTFMaterial> getParsedMaterials(void) const;
+		// Moves the material structure into the given vector; the parser is empty afterwards
+		void takeParsedMaterials(std::vector<gLTFMaterial>& materials);
 		
 	protected:
 		// Parse level 2
@@ -61,7 +61,7 @@ class gLTFImportMaterialsParser
 		Color4 parseColor4 (rapidjson::Value::ConstMemberIterator jsonIterator);
 
 	private:
-		std::map<int, gLTFMaterial> mMaterialsMap;
+		std::vector<gLTFMaterial> mMaterials;
 		PbrMetallicRoughness mPbrMetallicRoughness;
 		NormalTexture mNormalTexture;
 		OcclusionTexture mOcclusionTexture;
@@ -28,7 +28,7 @@ THE SOFTWARE.
 #ifndef __gLTFImportMeshesParser_H__
 #define __gLTFImportMeshesParser_H__
 
-#include <map>
+#include <vector>
 #include "gLTFImportConstants.h"
 #include "gLTFMesh.h"
 #include "gLTFImportPrimitivesParser.h"
@@ -40,21 +40,21 @@ class gLTFImportMeshesParser
 	public:
 		gLTFImportMeshesParser (void)
 		{
-			mMeshesMap.clear();
+			mMeshes.clear();
 		};
 		virtual ~gLTFImportMeshesParser (void) {};
 
 		// Parse the gLTF Meshes (level 1)
 		bool parseMeshes (rapidjson::Value::ConstMemberIterator jsonIterator);
 
-		// Returns the Meshes structure
-		const std::map<int, gLTFMesh> getParsedMeshes(void) const;
+		// Moves the Meshes structure into the given vector; the parser is empty afterwards
+		void takeParsedMeshes(std::vector<gLTFMesh>& meshes);
 
 	protected:
 
 	private:
 		gLTFImportPrimitivesParser mPrimitivesParser;
-		std::map<int, gLTFMesh> mMeshesMap;
+		std::vector<gLTFMesh> mMeshes;
 };
 
 #endif
@@ -28,7 +28,7 @@ THE SOFTWARE.
 #ifndef __gLTFImportNodessParser_H__
 #define __gLTFImportNodessParser_H__
 
-#include <map>
+#include <vector>
 #include "gLTFImportConstants.h"
 #include "gLTFNode.h"
 #include "rapidjson/document.h"
@@ -39,20 +39,20 @@ class gLTFImportNodesParser
 	public:
 		gLTFImportNodesParser (void)
 		{
-			mNodesMap.clear();
+			mNodes.clear();
 		};
 		virtual ~gLTFImportNodesParser (void) {};
 
 		// Parse the gLTF Nodes (level 1)
 		bool parseNodes(rapidjson::Value::ConstMemberIterator jsonIterator);
 
-		// Returns the Nodes structure
-		const std::map<int, gLTFNode> getParsedNodes(void) const;
+		// Moves the Nodes structure into the given vector; the parser is empty afterwards
+		void takeParsedNodes(std::vector<gLTFNode>& nodes);
 
 	protected:
 
 	private:
-		std::map<int, gLTFNode> mNodesMap;
+		std::vector<gLTFNode> mNodes;
 };
 
 #endif
@@ -36,8 +36,21 @@ THE SOFTWARE.
 #include "gLTFAnimation.h"
 #include "gLTFAccessor.h"
 #include "gLTFSkin.h"
+#include "gLTFDocument.h"
+#include "gLTFImportOptions.h"
 #include "hlms_editor_plugin.h"
 #include "gLTFImportBufferReader.h"
+#include "gLTFImportTopologyConverter.h"
+#include "gLTFImportVertexTransformer.h"
+#include "gLTFImportReport.h"
+#include "gLTFImportSpatialSplitter.h"
+#include "gLTFImportEdgeListBuilder.h"
+#include "gLTFImportBonePartitioner.h"
+#include "gLTFImportPoseBuilder.h"
+#include "gLTFImportKeyframeMerger.h"
+#include "gLTFImportKeyframeReducer.h"
+#include "gLTFImportThreadPool.h"
+#include "gLTFStagedSubmesh.h"
 #include "gLTFAnimationChannel.h" 
 #include "OgreVector2.h"
 #include "OgreVector3.h"
@@ -53,11 +66,8 @@ class gLTFImportOgreMeshCreator
 
 		// Create the Ogre Mesh files
 		bool createOgreMeshFiles (Ogre::HlmsEditorPluginData* data,
-			std::map<int, gLTFNode> nodesMap,
-			std::map<int, gLTFMesh> meshesMap,
-			std::map<int, gLTFAnimation> animationsMap,
-			std::map<int, gLTFSkin> skinsMap,
-			std::map<int, gLTFAccessor> accessorMap,
+			const gLTFDocument& document,
+			const gLTFImportOptions& options,
 			int startBinaryBuffer,
 			bool hasAnimations); // Creates *.xml and .mesh files
 
@@ -78,42 +88,156 @@ class gLTFImportOgreMeshCreator
 			int startBinaryBuffer);
 	
 	protected:
-		struct Keyframe
+		// Keyframes of one bone in one gLTF animation
+		struct BoneTrack
 		{
-			float time = 0.0f;
-			bool hasTranslation = false;
-			Ogre::Vector3 translation;
-			bool hasRotation = false;
-			Ogre::Quaternion rotation;
-			bool hasScale = false;
+			size_t clip = 0; // Index in mAnimationClips
+			unsigned int boneId = 0;
+			const std::string* boneName = 0;
+			std::vector<gLTFImportKeyframeMerger::Keyframe> keyframes;
+			Ogre::Vector3 bindPosition;
+			Ogre::Quaternion bindOrientation;
+			Ogre::Vector3 bindScale;
+			bool constant = false; // The keyframes never leave the bind pose
+		};
+
+		// One Ogre skeleton animation; it is made of one gLTF animation
+		struct AnimationClip
+		{
+			std::string name;
+			float length = 0.0f;
+			size_t firstTrack = 0; // The tracks of a clip are consecutive in mBoneTracks
+			size_t trackCount = 0;
+			size_t keyframesBefore = 0;
+			size_t keyframesAfter = 0;
+			size_t removedTracks = 0;
+			std::string xml; // Encoded <animation> element
+		};
+
+		// One bone of the skeleton; joints of different skins that refer to the same node share the bone
+		struct SkeletonBone
+		{
+			int nodeIndex = -1;
+			int parent = -1; // Bone id of the parent bone; -1 for a root bone
+			std::string name;
+		};
+
+		/* Tables of one skin that are derived by the mesh creator. They are kept here (indexed by skin index) instead 
+		 * of in the gLTFSkin, because the document is read only.
+		 */
+		struct SkinTables
+		{
+			std::vector<int> jointIndicesByNode; // Indexed by node index; -1 if the node is not a joint of this skin
+			std::vector<int> boneIds; // Indexed by joint index; -1 if the joint is pruned from the skeleton
+			std::vector<std::string> boneNames; // Indexed by joint index
+		};
+
+		// Decomposed bind pose of one bone
+		struct BindPose
+		{
+			Ogre::Vector3 position;
+			Ogre::Quaternion orientation;
 			Ogre::Vector3 scale;
 		};
 
+		// Static submeshes with the same material (and vertex layout) that are combined into one submesh
+		struct MergeBatch
+		{
+			std::string materialName;
+			gLTFStagedSubmesh submesh;
+			unsigned int primitiveCount = 0;
+		};
+
 		// Write to mesh .xml file
 		bool writeSubmeshToMesh (std::ofstream& dst,
-			gLTFNode node,
-			gLTFMesh mesh,
+			const gLTFNode& node,
+			const gLTFMesh& mesh,
 			Ogre::HlmsEditorPluginData* data,
 			int startBinaryBuffer,
-			Ogre::Matrix4 matrix = Ogre::Matrix4(),
+			Ogre::Matrix4 matrix = Ogre::Matrix4::IDENTITY,
 			bool hasAnimations = false);
 
-		bool writeFacesToMesh(std::ofstream& dst,
-			const gLTFPrimitive& primitive,
+		bool writeStagedSubmeshToMesh (std::ofstream& dst,
+			const std::string& materialName,
+			const std::string& description,
 			Ogre::HlmsEditorPluginData* data,
-			int startBinaryBuffer); // Write all faces
+			const gLTFNode* node = 0,
+			const gLTFPrimitive* primitive = 0,
+			int startBinaryBuffer = 0); // Write the staged submesh (a primitive, a chunk or a merged batch) as one submesh
+
+		void addStagedSubmeshToMergeBatch (std::ofstream& dst,
+			const std::string& materialName,
+			Ogre::HlmsEditorPluginData* data); // Add the staged (static) submesh to the merge batch of its material
+
+		void writeMergeBatchToMesh (std::ofstream& dst,
+			MergeBatch& batch,
+			Ogre::HlmsEditorPluginData* data); // Write a merge batch as one submesh and clear it
+
+		bool stageSubmesh (const gLTFPrimitive& primitive,
+			Ogre::HlmsEditorPluginData* data,
+			int startBinaryBuffer,
+			const Ogre::Matrix4& matrix = Ogre::Matrix4::IDENTITY); // Read all vertex data, convert it to an indexed list and transform it
+
+		void computeBounds (const gLTFPrimitive& primitive, 
+			const Ogre::Matrix4& matrix); // Determine the bounding box and sphere of the staged submesh
+
+		bool writeFacesToMesh(std::ofstream& dst); // Write all faces of the staged submesh
 
 		bool writeVerticesToMesh(std::ofstream& dst,
-			const gLTFPrimitive& primitive, 
+			Ogre::HlmsEditorPluginData* data,
+			bool writePositions = true,
+			bool writeOtherAttributes = true); // Write all vertices of the staged submesh
+		bool useSeparatePositionBuffer (void); // Determine whether the staged submesh gets a position-only vertex buffer
+
+		bool readInfluenceSet (int jointAccessorIndex,
+			int weightAccessorIndex,
 			Ogre::HlmsEditorPluginData* data,
 			int startBinaryBuffer,
-			Ogre::Matrix4 matrix = Ogre::Matrix4()); // Write all vertices of a submesh
+			std::vector<float>& joints,
+			std::vector<float>& weights); // Decode a joints and weights accessor pair (4 values per vertex)
 
-		bool writeBoneAssignmentsToMesh(std::ofstream& dst,
-			gLTFNode node,
+		bool stageBoneInfluences (const gLTFNode& node,
 			const gLTFPrimitive& primitive,
 			Ogre::HlmsEditorPluginData* data, 
-			int startBinaryBuffer); // Write all bone assignments of a submesh
+			int startBinaryBuffer); // Read the joints and weights of the staged submesh
+
+		bool writeBoneAssignmentsToMesh(std::ofstream& dst); // Write all bone assignments of the staged submesh
+
+		bool stageMorphTargets (const gLTFNode& node,
+			const gLTFMesh& mesh,
+			const gLTFPrimitive& primitive,
+			Ogre::HlmsEditorPluginData* data,
+			int startBinaryBuffer,
+			const Ogre::Matrix4& matrix); // Read the morph targets of the staged submesh as sparse displacements
+
+		bool readMorphTargetAttribute (const std::map<std::string, int>& target,
+			const std::string& attribute,
+			int vertexCount,
+			Ogre::HlmsEditorPluginData* data,
+			int startBinaryBuffer,
+			std::vector<float>& values); // Decode one (VEC3) attribute of a morph target; returns false if it is not available
+
+		bool isMorphWeightsAnimated (int nodeIndex, int meshIndex); // Determine whether an animation channel targets the morph weights
+		bool isMorphWeightsAnimated (const gLTFNode& node); // Determine whether an animation channel targets the morph weights of the node
+		bool writePosesToMesh (std::ofstream& dst,
+			Ogre::HlmsEditorPluginData* data,
+			int startBinaryBuffer); // Write the poses of all submeshes and the pose animations of the morph weights
+
+		bool writeStagedSubmeshPartitionsToMesh (std::ofstream& dst,
+			const std::string& materialName,
+			const std::string& description,
+			Ogre::HlmsEditorPluginData* data,
+			const gLTFNode* node,
+			const gLTFPrimitive* primitive,
+			int startBinaryBuffer); // Split the staged submesh into bone palette partitions (if needed) and write them
+
+		bool writeExtremesToMesh (std::ofstream& dst); // Write the bounds of all submeshes as submesh extremes
+		bool writeEdgeListsToMesh (std::ofstream& dst, 
+			Ogre::HlmsEditorPluginData* data,
+			const std::string& meshName); // Build and write the edge list of all submeshes
+
+		void writeBoundsToReport (const std::string& description); // Add the bounds of the staged submesh to the report
+		void writePrunedAttributesToReport (void); // Add the vertex attributes that are not read (and the bytes saved) to the report
 
 		// Write bones to skeleton.xml file
 		bool writeBonesToSkeleton(std::ofstream& dst,
@@ -123,24 +247,30 @@ class gLTFImportOgreMeshCreator
 		// Write bone hierarchy to skeleton.xml file
 		bool writeBoneHierarchyToSkeleton (std::ofstream& dst);
 
-		// Write animation to skeleton.xml file
+		/* Write animations to skeleton.xml file. Each gLTF animation (e.g. "Walk" or "Run") becomes one Ogre animation
+		 * with a track for every bone it moves, over all skins. The clips are encoded in parallel and written in the
+		 * order of the gLTF animations.
+		 */
 		bool writeAnimationsToSkeleton (std::ofstream& dst,
 			Ogre::HlmsEditorPluginData* data,
 			int startBinaryBuffer);
 
-		// Write keyframe header to skeleton.xml file
-		bool writeKeyframesToSkeleton (std::ofstream& dst,
-			//const gLTFSkin& skin,
-			//unsigned int jointIndex,
-			std::vector<gLTFAnimationChannel>* animationChannelsForNode,
+		/* Decode the channels of one bone in one gLTF animation and merge them into keyframes (in mKeyframeMerger).
+		 * The channels are given as a range of handles; returns false if none of the handles refers to a channel.
+		 */
+		bool mergeKeyframes (std::vector<gLTFAnimationChannelHandle>::const_iterator first,
+			std::vector<gLTFAnimationChannelHandle>::const_iterator last,
 			Ogre::HlmsEditorPluginData* data,
 			int startBinaryBuffer);
 
+		// Write keyframes to skeleton.xml file
+		bool writeKeyframesToSkeleton (std::ostream& dst,
+			const std::vector<gLTFImportKeyframeMerger::Keyframe>& keyframes);
+
 		// Read attributes from buffer
 		void readPositionsFromUriOrFile (const gLTFPrimitive& primitive,
 			Ogre::HlmsEditorPluginData* data,
-			int startBinaryBuffer,
-			Ogre::Matrix4 matrix = Ogre::Matrix4()); // Read the positions
+			int startBinaryBuffer); // Read the positions
 
 		void readNormalsFromUriOrFile (const gLTFPrimitive& primitive,
 			Ogre::HlmsEditorPluginData* data,
@@ -175,39 +305,20 @@ class gLTFImportOgreMeshCreator
 			const std::string& xmlFileName,
 			const std::string& skeletonFileName);
 
-		bool getCorrectForMinMaxPropertyValue (Ogre::HlmsEditorPluginData* data);
 		bool setMeshFileNamePropertyValue (Ogre::HlmsEditorPluginData* data, const std::string& fileName);
 		bool setSkeletonFileNamePropertyValue (Ogre::HlmsEditorPluginData* data, const std::string& fileName);
-		std::vector<gLTFAnimationChannel> getAnimationChannelsByNode (int nodeIndex);
-		gLTFAnimation getAnimationByIndex (int animationIndex);
-		gLTFNode getNodeByIndex (int nodeIndex);
-			
-		// Returns the property value to generate tangents; returns false if the property isn't available
-		bool isGenerateTangentsProperty (Ogre::HlmsEditorPluginData* data);
-
-		// Returns the property value to generate animations; returns false if the property isn't available
-		bool isGenerateAnimationProperty (Ogre::HlmsEditorPluginData* data);
+		const gLTFAnimationChannel* getAnimationChannel (const gLTFAnimationChannelHandle& handle) const; // Returns 0 if the handle is invalid
 
 		// Determine the time of an animation (assume an animation is a skin)
-		float getMaxTimeOfAnimation (const gLTFSkin& skin,
+		float getMaxTimeOfAnimation (const gLTFAnimation& animation,
 			Ogre::HlmsEditorPluginData* data,
 			int startBinaryBuffer);
 
 		// Determine the largest keyframe time
-		float getMaxTimeOfKeyframes (gLTFAnimationChannel* animationChannel,
+		float getMaxTimeOfKeyframes (const gLTFAnimationChannel* animationChannel,
 			Ogre::HlmsEditorPluginData* data,
 			int startBinaryBuffer);
 
-		/* gLTF's animation system does not map clearly to Ogre's animation system. One animation in gLTF concerns 
-		 * the movement of one part of the model (one or more bones), e.q. moving a leg for walking, while another gLTF 
-		 * animation is involved with moving the other leg. They are individual animations, but a regular (Ogre) animation 
-		 * is a combination of multiple gLTF animations (e.g. "walking").
-		 * The gLTF specs do not make clear which gLTF animations belong to each other, an which do not.
-		 * Current implementation in this plugin assumes that there is only 1 Ogre animation in the skeleton file and
-		 * combines all gLTF animations.
-		 */
-		bool findAllUniqueOgreSkeletonAnimations (void);
-
 		/* The primitives of a mesh refer to a joint index. To not forget the relation between the joint index and the 
 		 * skin, the skin must be determined by the node that also refers to the mesh
 		 */
@@ -215,48 +326,84 @@ class gLTFImportOgreMeshCreator
 
 		/* Because a gLTF model can have multiple skins, the model therefore has joints with the same index. This may give
 		 * an issue when the relation between a vertex and a joint (=bone) is made. The index of a joint alone cannot be used.
-		 * To identify a joint, a unique id must be given. This id is determined based on skin index and joint index.
+		 * The bone id and name of a joint are therefore looked up in the tables of its skin (built by buildSkeleton).
+		 * The id is -1 and the name is empty if the joint is pruned.
 		 */
-		unsigned int getBoneId (unsigned int jointIndex, unsigned int skinIndex);
-		const std::string& getBoneName (unsigned int jointIndex, unsigned int skinIndex);
+		int getBoneId (const SkinTables& skin, unsigned int jointIndex) const;
+		const std::string& getBoneName (const SkinTables& skin, unsigned int jointIndex) const;
 
-		// Returns the InverseBindMatrix of a joint
-		const Ogre::Matrix4& getInverseBindMatrix (unsigned int inverseBindMatricesAccessorIndex,
-			unsigned int jointIndex,
-			Ogre::HlmsEditorPluginData* data,
-			int startBinaryBuffer);
+		// Builds the node index to joint index table of each skin once
+		void buildSkinTables (void);
 
-		// Returns true if this node is referred to as a joint in the given skin
-		bool isNodeAJointInThisSkin (const gLTFSkin& skin, const gLTFNode& node);
+		// Determines the unique Ogre name of each gLTF animation (indexed by animation index)
+		void buildAnimationNames (void);
 
-		// TODO
-		// gLTFNode* findNodeByIndex (int nodeIndex);
+		/* Skeleton optimization. Joints of all skins that refer to the same node become one bone, so skins that share 
+		 * joints share bones. If the property is set, joints that do not influence any vertex and have no weighted 
+		 * descendant are left out (with their tracks). The bones get consecutive ids; the bone ids of the joints of each 
+		 * skin are stored in its skin tables, so the vertex bone assignments use the same ids.
+		 */
+		void buildSkeleton (Ogre::HlmsEditorPluginData* data, int startBinaryBuffer);
+
+		/* Marks the joints (per skin) that have a weight in one of the primitives of a skinned node. Returns false if no 
+		 * joint has a weight at all.
+		 */
+		bool findWeightedJoints (Ogre::HlmsEditorPluginData* data, 
+			int startBinaryBuffer, 
+			std::map<int, std::vector<bool> >& weightedJoints);
+
+		// Returns the joint index of the node in the given skin or -1 if the node is not a joint of the skin
+		int getJointIndex (const SkinTables& skin, int nodeIndex) const;
+
+		// Decomposes the bind pose of all bones of the skeleton into mBindPoses (indexed by bone id)
+		void decomposeBindPoses (void);
+
+		// Returns true if this node is referred to as a joint in the given skin
+		bool isNodeAJointInThisSkin (const SkinTables& skin, const gLTFNode& node) const;
 
 	private:
 		std::string mHelperString;
 		std::string fileNameBufferHelper;
-		std::map <int, Ogre::Vector3> mPositionsMap;
-		std::map <int, Ogre::Vector3> mNormalsMap;
-		std::map <int, Ogre::Vector4> mTangentsMap;
-		std::map <int, Ogre::Vector4> mColor_0AccessorMap;
-		std::map <int, Ogre::Vector2> mTexcoords_0Map;
-		std::map <int, Ogre::Vector2> mTexcoords_1Map;
-		std::map <int, unsigned int> mIndicesMap;
-		std::map<int, gLTFNode> mNodesMap;
-		std::map<int, gLTFMesh> mMeshesMap;
-		std::map<int, gLTFAnimation> mAnimationsMap;
-		std::map<int, gLTFSkin> mSkinsMap;
-		std::map<int, gLTFAccessor> mAccessorMap;
+		gLTFStagedSubmesh mStagedSubmesh; // Vertex and index data of the primitive that is currently written
+		std::vector<gLTFStagedSubmesh::Bounds> mSubmeshBounds; // Bounds of the submeshes in the mesh file that is currently written
+		gLTFImportReport mReport;
+		const gLTFDocument* mDocument; // The document that is currently imported (read only)
+		const gLTFImportOptions* mOptions; // The plugin properties of the current import
+		std::vector<SkinTables> mSkinTables; // Indexed by skin index
 		Ogre::Vector4 mHelperVec4Struct;
 		Ogre::Vector3 mHelperVec3Struct;
 		Ogre::Vector2 mHelperVec2Struct;
 		Ogre::Matrix4 mHelperMatrix4;
 		gLTFImportBufferReader mBufferReader;
-		gLTFAnimation mHelperAnimation;
-		gLTFAnimationChannel mHelperAnimationChannel;
-		gLTFAnimationSampler mHelperAnimationSampler;
-		std::vector<gLTFAnimationChannel> mHelperAnimationChannelVector;
-		gLTFNode mHelperNode;
+		gLTFImportTopologyConverter mTopologyConverter;
+		gLTFImportVertexTransformer mVertexTransformer;
+		gLTFImportSpatialSplitter mSpatialSplitter;
+		gLTFImportThreadPool mThreadPool;
+		gLTFImportEdgeListBuilder mEdgeListBuilder;
+		bool mEdgeListsWritten; // The mesh file that is currently written contains edge lists
+		std::vector<gLTFStagedSubmesh> mHelperChunks;
+		gLTFImportBonePartitioner mBonePartitioner;
+		std::vector<gLTFStagedSubmesh> mHelperPartitions;
+		std::vector<float> mHelperJoints[2]; // Decoded JOINTS_0 and JOINTS_1
+		std::vector<float> mHelperWeights[2]; // Decoded WEIGHTS_0 and WEIGHTS_1
+		gLTFImportPoseBuilder mPoseBuilder;
+		std::vector<float> mHelperTargetPositions; // Decoded POSITION displacements of a morph target
+		std::vector<float> mHelperTargetNormals; // Decoded NORMAL displacements of a morph target
+		gLTFImportKeyframeMerger mKeyframeMerger;
+		std::vector<float> mHelperTimes; // Decoded input of an animation channel
+		std::vector<float> mHelperValues; // Decoded output of an animation channel
+		std::map<int, float> mMaxTimeCache; // Largest time per animation input accessor
+		gLTFImportKeyframeReducer mKeyframeReducer;
+		std::vector<BoneTrack> mBoneTracks; // Tracks of the skeleton animations that are currently written
+		std::vector<AnimationClip> mAnimationClips; // Skeleton animations that are currently written
+		std::vector<std::string> mAnimationNames; // Unique name of each gLTF animation; used by skeleton and pose animations
+		std::vector<SkeletonBone> mSkeletonBones; // Indexed by bone id
+		std::vector<int> mBoneIdsByNode; // Indexed by node index; -1 if the node is not a bone
+		std::vector<BindPose> mBindPoses; // Bind poses of the bones; indexed by bone id
+		std::vector<Ogre::Matrix4> mHelperBindMatrices;
+		bool mMergeStaticSubmeshes; // Only used when all meshes are combined into one mesh
+		std::map<std::string, MergeBatch> mMergeBatches; // Open batches by material/vertex layout
+		size_t mDrawCallsWithoutMerge; // Number of submeshes if nothing was merged
 };
 
 #endif
@@ -0,0 +1,70 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#ifndef __gLTFImportOptions_H__
+#define __gLTFImportOptions_H__
+
+#include <string>
+#include "hlms_editor_plugin.h"
+
+/** The plugin properties (set in the HLMS Editor) of an import. The properties are resolved once at the start of the 
+	import, so the creators do not have to look up a property by name in their (per vertex) loops.
+*/
+struct gLTFImportOptions
+{
+	gLTFImportOptions (void);
+
+	// Read the property values; a property that isn't available keeps its default value
+	void resolve (const Ogre::HlmsEditorPluginData* data);
+
+	// Mesh
+	bool mMeshIsSubmesh; // Create one combined mesh instead of a mesh per gLTF mesh; default false
+	bool mGenerateTangents; // Let OgreMeshTool generate the tangents; default false
+	bool mGenerateEdgeLists; // Default false
+	bool mOptimizeForDesktop; // Default false
+	bool mCorrectForMinMax; // Clamp the values of an accessor to its min/max; default false
+	bool mPruneVertexAttributes; // Remove the vertex attributes that are not used by the material; default false
+	bool mSeparatePositionBuffer; // Default false
+	bool mImportMorphTargets; // Default true
+	unsigned int mSplitPrimitiveTriangles; // Target number of triangles per chunk; default 0 (no split)
+	bool mMergeStaticSubmeshes; // Default false
+	unsigned int mMergeMaxVertices; // Default 65535
+	float mBoneWeightThreshold; // Default 0
+	unsigned int mMaxBonesPerSubmesh; // Default 0 (no partitioning)
+
+	// Skeleton and animations
+	bool mGenerateAnimation; // Default false
+	bool mOptimizeSkeleton; // Merge shared joints and prune unweighted joints; default true
+	bool mReduceKeyframes; // Default false
+	float mKeyframePositionTolerance; // Default 0.0001
+	float mKeyframeRotationTolerance; // In degrees; default 0.05
+	float mKeyframeScaleTolerance; // Default 0.0001
+	unsigned int mAnimationResampleRate; // Keyframes per second; default 0 (no resampling)
+};
+
+#endif
@@ -28,13 +28,14 @@ THE SOFTWARE.
 #ifndef __gLTFImportPbsMaterialsCreator_H__
 #define __gLTFImportPbsMaterialsCreator_H__
 
-#include <map>
+#include <vector>
 #include "gLTFImportConstants.h"
 #include "hlms_editor_plugin.h"
 #include "gLTFMaterial.h"
 #include "gLTFTexture.h"
 #include "gLTFImage.h"
 #include "gLTFSampler.h"
+#include "gLTFDocument.h"
 
 /** Class responsible for creation of Ogre PBS materials */
 class gLTFImportPbsMaterialsCreator
@@ -49,17 +50,14 @@ class gLTFImportPbsMaterialsCreator
 
 		// Create the Ogre Pbs Material files
 		bool createOgrePbsMaterialFiles(Ogre::HlmsEditorPluginData* data,
-			std::map<int, gLTFMaterial> materialsMap,
-			std::map<int, gLTFTexture> texturesMap,
-			std::map<int, gLTFImage> imagesMap,
-			std::map<int, gLTFSampler> samplersMap); // Creates *.material.json files and copy images
+			const gLTFDocument& document); // Creates *.material.json files and copy images
 
 	protected:
 		// Create json blocks
 		// Sampler
 		bool createSamplerJsonBlock(std::ofstream* dst, 
 			const gLTFMaterial& material, 
-			std::map<int, gLTFSampler> samplersMap);
+			const std::vector<gLTFSampler>& samplers);
 
 		// Macro
 		bool createMacroJsonBlock(std::ofstream* dst, const gLTFMaterial& material);
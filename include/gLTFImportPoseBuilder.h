@@ -0,0 +1,122 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#ifndef __gLTFImportPoseBuilder_H__
+#define __gLTFImportPoseBuilder_H__
+
+#include <vector>
+#include <fstream>
+#include "gLTFImportConstants.h"
+#include "gLTFStagedSubmesh.h"
+#include "gLTFImportVertexTransformer.h"
+#include "OgreMatrix4.h"
+
+/** Class responsible for converting the morph targets of a primitive into Ogre poses. The displacements are stored 
+	sparsely; only vertices with a non-zero displacement are kept, so meshes with many targets do not multiply the
+	vertex data.
+*/
+class gLTFImportPoseBuilder
+{
+	public:
+		// Morph target of the staged primitive; the vertices are gLTF (source) vertex indices in increasing order
+		struct SparseTarget
+		{
+			std::vector<unsigned int> vertices;
+			std::vector<float> positionsX;
+			std::vector<float> positionsY;
+			std::vector<float> positionsZ;
+			std::vector<float> normalsX; // Empty if the target has no normal displacements
+			std::vector<float> normalsY;
+			std::vector<float> normalsZ;
+		};
+
+		// Pose of a written submesh
+		struct Pose
+		{
+			unsigned int submeshIndex = 0;
+			int nodeIndex = -1; // -1 if the pose is not related to a node (mesh files per gLTF mesh)
+			int meshIndex = -1;
+			unsigned int targetIndex = 0;
+			std::string name;
+			std::vector<unsigned int> vertices;
+			std::vector<float> positions; // 3 floats per vertex
+			std::vector<float> normals; // 3 floats per vertex; empty if the target has no normal displacements
+		};
+
+		gLTFImportPoseBuilder (void) {};
+		virtual ~gLTFImportPoseBuilder (void) {};
+
+		// Start a new mesh file; removes the poses and the staged targets
+		void clear (void);
+
+		// Start the targets of a new primitive
+		void beginStagedTargets (int nodeIndex, int meshIndex, const std::string& name);
+
+		/* Add a morph target of the staged primitive. The positions and normals are the decoded accessors (3 floats per
+		 * vertex); normals may be 0. If positions is 0, an empty target is added. Only the vertices with a non-zero displacement are kept.
+		 */
+		void addStagedTarget (const float* positions, const float* normals, size_t vertexCount);
+
+		bool hasStagedTargets (void) const { return !mStagedTargets.empty(); };
+		size_t getStagedTargetCount (void) const { return mStagedTargets.size(); };
+
+		/* Transform the displacements of the staged targets. Only the upper 3x3 of the matrix is used; normal
+		 * displacements are transformed by its inverse-transpose and not renormalized.
+		 */
+		void transformStagedTargets (const Ogre::Matrix4& matrix);
+
+		// Add the weighted displacements of the staged targets to the submesh (default weights that are not animated)
+		void applyStagedTargets (gLTFStagedSubmesh& submesh, const std::vector<float>& weights);
+
+		// Create a pose per staged target for a written submesh; its vertices are mapped to their gLTF vertex
+		void addPoses (const gLTFStagedSubmesh& submesh, unsigned int submeshIndex);
+
+		const std::vector<Pose>& getPoses (void) const { return mPoses; };
+
+		// Write the <poses> element; returns false if there are no poses
+		bool writePosesToMesh (std::ofstream& dst);
+
+		/* Determine the vertices of which the 3 components of a or b are not all zero (SIMD zero-scan). Both arrays
+		 * contain 3 floats per vertex; b may be 0.
+		 */
+		void findNonZeroVertices (const float* a, const float* b, size_t vertexCount, std::vector<unsigned int>& vertices);
+
+	protected:
+		// Returns the index in the sparse target of a gLTF vertex, or -1 if the vertex is not displaced
+		int findTargetVertex (const SparseTarget& target, unsigned int sourceVertexIndex) const;
+
+	private:
+		std::vector<SparseTarget> mStagedTargets;
+		int mStagedNodeIndex = -1;
+		int mStagedMeshIndex = -1;
+		std::string mStagedName;
+		std::vector<Pose> mPoses;
+		gLTFImportVertexTransformer mVertexTransformer;
+};
+
+#endif
@@ -28,7 +28,7 @@ THE SOFTWARE.
 #ifndef __gLTFImportPrimitivesParser_H__
 #define __gLTFImportPrimitivesParser_H__
 
-#include <map>
+#include <vector>
 #include "gLTFImportConstants.h"
 #include "gLTFPrimitive.h"
 #include "rapidjson/document.h"
@@ -39,20 +39,20 @@ class gLTFImportPrimitivesParser
 	public:
 		gLTFImportPrimitivesParser (void)
 		{
-			mPrimitivesMap.clear();
+			mPrimitives.clear();
 		};
 		virtual ~gLTFImportPrimitivesParser (void) {};
 
 		// Parse the gLTF Primitives (level 1)
 		bool parsePrimitives (rapidjson::Value::ConstMemberIterator jsonIterator);
 
-		// Returns the Primitives structure
-		const std::map<int, gLTFPrimitive> getParsedPrimitives(void) const;
+		// Moves the Primitives structure into the given vector; the parser is empty afterwards
+		void takeParsedPrimitives(std::vector<gLTFPrimitive>& primitives);
 
 	protected:
 
 	private:
-		std::map<int, gLTFPrimitive> mPrimitivesMap;
+		std::vector<gLTFPrimitive> mPrimitives;
 };
 
 #endif
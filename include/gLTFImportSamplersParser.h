@@ -28,7 +28,7 @@ THE SOFTWARE.
 #ifndef __gLTFImportSamplersParser_H__
 #define __gLTFImportSamplersParser_H__
 
-#include <map>
+#include <vector>
 #include "gLTFImportConstants.h"
 #include "gLTFSampler.h"
 #include "rapidjson/document.h"
@@ -39,20 +39,20 @@ class gLTFImportSamplersParser
 	public:
 		gLTFImportSamplersParser (void)
 		{
-			mSamplersMap.clear();
+			mSamplers.clear();
 		};
 		virtual ~gLTFImportSamplersParser (void) {};
 
 		// Parse the gLTF Samplers (level 1)
 		bool parseSamplers (rapidjson::Value::ConstMemberIterator jsonIterator);
 
-		// Returns the Samplers structure
-		const std::map<int, gLTFSampler> getParsedSamplers(void) const;
+		// Moves the Samplers structure into the given vector; the parser is empty afterwards
+		void takeParsedSamplers(std::vector<gLTFSampler>& samplers);
 
 	protected:
 
 	private:
-		std::map<int, gLTFSampler> mSamplersMap;
+		std::vector<gLTFSampler> mSamplers;
 };
 
 #endif
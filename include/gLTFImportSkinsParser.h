@@ -28,7 +28,7 @@ THE SOFTWARE.
 #ifndef __gLTFImportSkinsParser_H__
 #define __gLTFImportSkinsParser_H__
 
-#include <map>
+#include <vector>
 #include "gLTFImportConstants.h"
 #include "gLTFSkin.h"
 #include "rapidjson/document.h"
@@ -38,20 +38,20 @@ class gLTFImportSkinsParser
 {
 	public:
 		gLTFImportSkinsParser (void) {
-			mSkinsMap.clear();
+			mSkins.clear();
 		};
 		virtual ~gLTFImportSkinsParser (void) {};
 
 		// Parse the gLTF Skins (level 1)
 		bool parseSkins (rapidjson::Value::ConstMemberIterator jsonIterator);
 
-		// Returns the Skins structure
-		const std::map<int, gLTFSkin> getParsedSkins (void) const;
+		// Moves the Skins structure into the given vector; the parser is empty afterwards
+		void takeParsedSkins (std::vector<gLTFSkin>& skins);
 
 	protected:
 
 	private:
-		std::map<int, gLTFSkin> mSkinsMap;
+		std::vector<gLTFSkin> mSkins;
 };
 
 #endif
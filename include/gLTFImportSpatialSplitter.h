@@ -0,0 +1,91 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#ifndef __gLTFImportSpatialSplitter_H__
+#define __gLTFImportSpatialSplitter_H__
+
+#include <vector>
+#include "gLTFImportConstants.h"
+#include "gLTFStagedSubmesh.h"
+#include "gLTFImportThreadPool.h"
+#include "gLTFImportVertexTransformer.h"
+
+/** Class responsible for splitting a large triangle list into spatially coherent chunks, so each chunk can be
+	culled individually.
+*/
+class gLTFImportSpatialSplitter
+{
+	public:
+		// Range of triangles in a triangle order
+		struct Range
+		{
+			size_t begin = 0;
+			size_t end = 0;
+		};
+
+		gLTFImportSpatialSplitter (void) {};
+		virtual ~gLTFImportSpatialSplitter (void) {};
+
+		/* Split the triangles of the submesh into chunks of at most targetTriangleCount triangles. The triangles are 
+		 * partitioned like a BVH; the set of triangles is recursively split at the median of the triangle centroids
+		 * along the longest axis. Each chunk gets its own compacted vertex range (only the vertices it references), 
+		 * its own index buffer and its own bounds. The chunks are created in parallel.
+		 * Returns false (and leaves chunks empty) if the submesh is not a triangle list or is small enough.
+		 */
+		bool split (const gLTFStagedSubmesh& submesh,
+			unsigned int targetTriangleCount,
+			gLTFImportThreadPool& threadPool,
+			std::vector<gLTFStagedSubmesh>& chunks);
+
+		/* Create a chunk for each range of triangles. The triangles vector contains triangle indices of the submesh
+		 * and the ranges refer to the triangles vector. The chunks are created in parallel.
+		 */
+		void createChunks (const gLTFStagedSubmesh& submesh,
+			const std::vector<unsigned int>& triangles,
+			const std::vector<Range>& ranges,
+			gLTFImportThreadPool& threadPool,
+			std::vector<gLTFStagedSubmesh>& chunks);
+
+	protected:
+		// Partition mHelperTriangles into ranges of at most targetTriangleCount triangles
+		void partition (size_t begin, size_t end, unsigned int targetTriangleCount);
+
+		// Create a chunk from a number of triangles
+		void createChunk (const gLTFStagedSubmesh& submesh, 
+			const unsigned int* triangles, 
+			size_t triangleCount, 
+			gLTFStagedSubmesh& chunk);
+
+	private:
+		std::vector<unsigned int> mHelperTriangles; // Triangle indices; reordered during partitioning
+		std::vector<float> mHelperCentroids; // 3 floats per triangle
+		std::vector<Range> mHelperRanges;
+		gLTFImportVertexTransformer mVertexTransformer;
+};
+
+#endif
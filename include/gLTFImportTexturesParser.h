@@ -28,7 +28,7 @@ THE SOFTWARE.
 #ifndef __gLTFImportTexturesParser_H__
 #define __gLTFImportTexturesParser_H__
 
-#include <map>
+#include <vector>
 #include "gLTFImportConstants.h"
 #include "gLTFTexture.h"
 #include "rapidjson/document.h"
@@ -39,20 +39,20 @@ class gLTFImportTexturesParser
 	public:
 		gLTFImportTexturesParser (void)
 		{
-			mTexturesMap.clear();
+			mTextures.clear();
 		};
 		virtual ~gLTFImportTexturesParser (void) {};
 
 		// Parse the gLTF Textures (level 1)
 		bool parseTextures (rapidjson::Value::ConstMemberIterator jsonIterator);
 
-		// Returns the Textures structure
-		const std::map<int, gLTFTexture> getParsedTextures (void) const;
+		// Moves the Textures structure into the given vector; the parser is empty afterwards
+		void takeParsedTextures (std::vector<gLTFTexture>& textures);
 
 	protected:
 
 	private:
-		std::map<int, gLTFTexture> mTexturesMap;
+		std::vector<gLTFTexture> mTextures;
 };
 
 #endif
@@ -0,0 +1,75 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#ifndef __gLTFImportThreadPool_H__
+#define __gLTFImportThreadPool_H__
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+/** Class responsible for running independent tasks in parallel. The worker threads are created on first use and
+	are kept alive until the pool is destroyed, so they can be reused for all parallel loops of an import.
+*/
+class gLTFImportThreadPool
+{
+	public:
+		gLTFImportThreadPool (unsigned int threadCount = 0); // 0 means: use the number of hardware threads
+		virtual ~gLTFImportThreadPool (void);
+
+		/* Run task(i) for i = 0..count-1. The calling thread also executes tasks and the function returns when all
+		 * tasks are finished. Tasks must not throw and must not call parallelFor themselves.
+		 */
+		void parallelFor (size_t count, const std::function<void (size_t)>& task);
+
+		// Returns the number of threads (including the calling thread) that execute tasks
+		unsigned int getThreadCount (void) const;
+
+	protected:
+		void startWorkers (void);
+		void workerLoop (void);
+		void runTasks (void);
+
+	private:
+		unsigned int mThreadCount;
+		std::vector<std::thread> mWorkers;
+		std::mutex mMutex;
+		std::condition_variable mJobAvailable;
+		std::condition_variable mJobFinished;
+		const std::function<void (size_t)>* mTask;
+		size_t mTaskCount;
+		std::atomic<size_t> mNextTask;
+		unsigned int mBusyWorkers;
+		unsigned int mGeneration;
+		bool mStop;
+};
+
+#endif
@@ -0,0 +1,71 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __gLTFImportTopologyConverter_H__
+#define __gLTFImportTopologyConverter_H__
+
+#include <vector>
+#include "gLTFImportConstants.h"
+#include "gLTFPrimitive.h"
+#include "gLTFStagedSubmesh.h"
+
+/** Class responsible for converting the topology of a staged submesh into an indexed list */
+class gLTFImportTopologyConverter
+{
+	public:
+		gLTFImportTopologyConverter (void) {};
+		virtual ~gLTFImportTopologyConverter (void) {};
+
+		/* Converts the staged submesh into an indexed line list or triangle list. Strips, fans and loops are
+		 * converted into lists in one index generation pass. A non-indexed triangle list gets an index buffer by 
+		 * welding identical vertices (if weld is true), otherwise the index buffer is sequential.
+		 * Point lists cannot be indexed in an Ogre mesh, so indexed points are expanded into a non-indexed list.
+		 */
+		bool convertToIndexedList (gLTFStagedSubmesh& submesh, bool weld);
+
+	protected:
+		// Generate list indices from the source index sequence (gLTF indices or 0..n-1)
+		void generateListIndices (gLTFStagedSubmesh& submesh, 
+			const std::vector<unsigned int>& source);
+
+		// Merge vertices with identical attributes and create the index buffer
+		void weldVertices (gLTFStagedSubmesh& submesh);
+
+		// Replace the vertices by the vertices referenced by the index buffer
+		void expandIndexedPoints (gLTFStagedSubmesh& submesh);
+
+		// Utils
+		unsigned int hashVertex (const gLTFStagedSubmesh& submesh, unsigned int vertexIndex);
+		bool isVertexEqual (const gLTFStagedSubmesh& submesh, unsigned int vertexIndexA, unsigned int vertexIndexB);
+		void gatherVertices (gLTFStagedSubmesh& submesh, const std::vector<unsigned int>& sourceVertexIndices);
+
+	private:
+		std::vector<unsigned int> mHelperSourceIndices;
+		std::vector<unsigned int> mHelperHashTable;
+};
+
+#endif
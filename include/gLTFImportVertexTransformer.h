@@ -0,0 +1,72 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#ifndef __gLTFImportVertexTransformer_H__
+#define __gLTFImportVertexTransformer_H__
+
+#include <vector>
+#include "gLTFImportConstants.h"
+#include "gLTFStagedSubmesh.h"
+#include "OgreMatrix3.h"
+#include "OgreMatrix4.h"
+
+/** Class responsible for transforming the staged vertex data of a submesh with a node matrix. The positions, normals 
+	and tangents are stored as SoA arrays, so 4 vertices are transformed per SSE instruction.
+*/
+class gLTFImportVertexTransformer
+{
+	public:
+		gLTFImportVertexTransformer (void) {};
+		virtual ~gLTFImportVertexTransformer (void) {};
+
+		/* Transform the positions, normals and tangents of the staged submesh.
+		 * Positions are transformed by the full matrix. Normals are transformed by the inverse-transpose of the upper 3x3,
+		 * so non-uniform scaling does not skew them. Tangents lie in the surface and are transformed by the upper 3x3.
+		 * Normals and tangents are renormalized. If the matrix mirrors the geometry (negative determinant), the handedness 
+		 * of the tangents (w component) is flipped.
+		 */
+		void transformSubmesh (gLTFStagedSubmesh& submesh, const Ogre::Matrix4& matrix);
+
+		// Kernels; the arrays contain 'count' elements
+		void transformPositions (float* x, float* y, float* z, size_t count, const Ogre::Matrix4& matrix);
+		void transformDirections (float* x, float* y, float* z, size_t count, const Ogre::Matrix3& matrix);
+		void flipHandedness (float* w, size_t count);
+
+		// Determine the minimum and maximum of the positions (SIMD reduction); returns false if count is 0
+		bool computeMinMax (const float* x, 
+			const float* y, 
+			const float* z, 
+			size_t count, 
+			Ogre::Vector3& min, 
+			Ogre::Vector3& max);
+
+		// Transform an axis aligned box and return the axis aligned box that encloses the result
+		void transformAabb (Ogre::Vector3& min, Ogre::Vector3& max, const Ogre::Matrix4& matrix);
+};
+
+#endif
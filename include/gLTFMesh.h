@@ -30,6 +30,7 @@ THE SOFTWARE.
 
 #include <string>
 #include <map>
+#include <vector>
 #include <iostream>
 #include "gLTFPrimitive.h"
 
@@ -49,8 +50,9 @@ class gLTFMesh
 		void out (void); // prints the content of the gLTFMesh
 
 		// Public members
-		std::map<int, gLTFPrimitive> mPrimitiveMap;
+		std::vector<gLTFPrimitive> mPrimitives;
 		int mWeight;
+		std::vector<float> mWeights; // Default weights of the morph targets
 		std::string mName;
 
 		// Derived members
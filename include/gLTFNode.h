@@ -31,7 +31,6 @@ THE SOFTWARE.
 #include <string>
 #include <vector>
 #include <iostream>
-#include "gLTFMesh.h"
 #include "gLTFAnimation.h"
 #include "OgreMatrix4.h"
 
@@ -48,7 +47,6 @@ class gLTFNode
 		gLTFNode(void);
 		virtual ~gLTFNode(void) {};
 		void out (void); // prints the content of the gLTFNode
-		bool hasAnimationName (const std::string& animationName);
 
 		// Public members
 		int mCamera; // unused for now
@@ -67,12 +65,9 @@ class gLTFNode
 		std::string mName;
 
 		// Derived data
-		gLTFMesh mMeshDerived; // from mesh
-		bool mTransformationCalculated;
-		Ogre::Matrix4 mCalculatedTransformation;
-		Ogre::Matrix4 mLocalTransformation;
-		gLTFNode* mParentNode;
-		std::vector<gLTFAnimation> mAnimationVector;
+		Ogre::Matrix4 mLocalTransformation; // The world transformation is stored in gLTFDocument
+		int mParentNodeDerived; // Index of the parent node; -1 for a root node
+		std::vector<gLTFAnimationChannelHandle> mAnimationChannelsDerived; // Channels that target this node, ordered by animation
 		int mNodeIndex;
 
 };
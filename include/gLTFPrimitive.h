@@ -30,6 +30,7 @@ THE SOFTWARE.
 
 #include <string>
 #include <map>
+#include <vector>
 #include <iostream>
 
 /************************************************************************************************
@@ -62,7 +63,7 @@ class gLTFPrimitive
 		int mMaterial;
 		int mMode;
 		std::map<std::string, int> mAttributes;
-		// TODO: mTargets
+		std::vector<std::map<std::string, int> > mTargets; // Morph targets; attribute name -> accessor index
 
 		// Derived members
 		std::string mMaterialNameDerived;
@@ -74,7 +75,11 @@ class gLTFPrimitive
 		int mColor_0AccessorDerived;
 		int mJoints_0AccessorDerived;
 		int mWeights_0AccessorDerived;
+		int mJoints_1AccessorDerived;
+		int mWeights_1AccessorDerived;
 		int mPrimitiveIndex;
+		std::string mPrunedAttributesDerived; // Attributes that are not used by the material and therefore not read
+		unsigned int mPrunedBytesDerived; // Size of the data of the pruned attributes
 };
 
 #endif
@@ -29,9 +29,8 @@ THE SOFTWARE.
 #define __gLTFSkin_H__
 
 #include <string>
-#include <map>
+#include <vector>
 #include <iostream>
-#include "gLTFNode.h"
 
 /************************************************************************************************
  This file contains the data struture of a gLFTSkin.
@@ -50,11 +49,8 @@ class gLTFSkin
 		// Public members
 		int mInverseBindMatrices;
 		int mSkeleton;
-		std::map<int, int> mJoints;
+		std::vector<int> mJoints; // Node index of each joint
 		std::string mName;
-
-		// Derived data
-		std::map<int, gLTFNode> mNodesDerived;
 };
 
 #endif
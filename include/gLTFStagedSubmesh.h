@@ -0,0 +1,106 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __gLTFStagedSubmesh_H__
+#define __gLTFStagedSubmesh_H__
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include "OgreVector2.h"
+#include "OgreVector3.h"
+#include "OgreVector4.h"
+
+/************************************************************************************************
+ This file contains the data struture of a gLTFStagedSubmesh. This is an intermediate structure
+ that holds the decoded vertex and index data of one primitive, before it is written to an
+ Ogre 3d mesh file.
+/************************************************************************************************/
+
+/********************************************************/
+/** Class responsible that represents a staged Submesh */
+/********************************************************/
+class gLTFStagedSubmesh
+{
+	public:
+		// Axis aligned bounding box and bounding sphere of the (transformed) submesh
+		struct Bounds
+		{
+			Ogre::Vector3 min;
+			Ogre::Vector3 max;
+			Ogre::Vector3 center;
+			float radius = 0.0f;
+			bool valid = false;
+			bool fromAccessor = false; // True if derived from the min/max of the position accessor
+		};
+
+		// Bones (unique bone id over all skins) and weights that influence one vertex; a weight of 0 means unused
+		struct BoneInfluences
+		{
+			unsigned int bones[4];
+			float weights[4];
+		};
+
+		gLTFStagedSubmesh (void);
+		virtual ~gLTFStagedSubmesh (void) {};
+		void out (void); // prints the content of the gLTFStagedSubmesh
+		void clear (void); // Reset the data, so the object can be reused for the next primitive
+		unsigned int getVertexCount (void) const;
+		unsigned int getSourceVertexIndex (unsigned int vertexIndex) const; // Index of the vertex in the gLTF accessors
+		bool needs32BitIndices (void) const;
+		void swap (gLTFStagedSubmesh& other); // Exchange the data with another staged submesh (without copying)
+		void append (const gLTFStagedSubmesh& other); // Append the vertices and indices of a submesh with the same layout and mode
+		void resizePositions (unsigned int count);
+		void resizeNormals (unsigned int count);
+		void resizeTangents (unsigned int count);
+
+		// Public members; positions, normals and tangents are stored per component (SoA), so they can be transformed in batches
+		std::vector<float> mPositionsX;
+		std::vector<float> mPositionsY;
+		std::vector<float> mPositionsZ;
+		std::vector<float> mNormalsX;
+		std::vector<float> mNormalsY;
+		std::vector<float> mNormalsZ;
+		std::vector<float> mTangentsX;
+		std::vector<float> mTangentsY;
+		std::vector<float> mTangentsZ;
+		std::vector<float> mTangentsW;
+		std::vector<Ogre::Vector4> mColours;
+		std::vector<Ogre::Vector2> mTexcoords_0;
+		std::vector<Ogre::Vector2> mTexcoords_1;
+		std::vector<unsigned int> mIndices;
+		bool mHasIndices; // If false, mIndices is not used (non-indexed point list)
+		int mMode; // gLTFPrimitive::Mode; after topology conversion this is POINTS, LINES or TRIANGLES
+		Bounds mBounds;
+		std::vector<BoneInfluences> mBoneInfluences; // Only filled if the bone assignments are written
+
+		// Derived data
+		std::vector<unsigned int> mSourceVertexIndices; // Filled when vertices are welded; empty means 1:1
+		std::vector<unsigned int> mBonePalette; // Bones used by a partition of a skinned submesh (palette index -> bone id)
+};
+
+#endif
@@ -66,3 +66,45 @@ void gLTFAccessor::out (void)
 {
 	OUT << "***************** Debug: gLTFAccessor *****************\n";
 }
+
+//---------------------------------------------------------------------
+unsigned int gLTFAccessor::getComponentCount (void) const
+{
+	if (mType == "SCALAR")
+		return 1;
+	if (mType == "VEC2")
+		return 2;
+	if (mType == "VEC3")
+		return 3;
+	if (mType == "VEC4" || mType == "MAT2")
+		return 4;
+	if (mType == "MAT3")
+		return 9;
+	if (mType == "MAT4")
+		return 16;
+	return 0;
+}
+
+//---------------------------------------------------------------------
+unsigned int gLTFAccessor::getComponentSize (void) const
+{
+	switch (mComponentType)
+	{
+		case BYTE:
+		case UNSIGNED_BYTE:
+			return 1;
+		case SHORT:
+		case UNSIGNED_SHORT:
+			return 2;
+		case UNSIGNED_INT:
+		case FLOAT:
+			return 4;
+	}
+	return 0;
+}
+
+//---------------------------------------------------------------------
+unsigned int gLTFAccessor::getDataSize (void) const
+{
+	return mCount * getComponentCount() * getComponentSize();
+}
@@ -33,8 +33,8 @@
 gLTFAnimation::gLTFAnimation(void)
 {
 	mName = "";
-	mAnimationChannelsMap.clear();
-	mAnimationSamplersMap.clear();
+	mAnimationChannels.clear();
+	mAnimationSamplers.clear();
 }
 
 //---------------------------------------------------------------------
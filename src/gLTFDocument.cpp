@@ -0,0 +1,100 @@
+/*
+  -----------------------------------------------------------------------------
+  This source file is part of OGRE
+  (Object-oriented Graphics Rendering Engine)
+  For the latest info, see http://www.ogre3d.org/
+
+  Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+  -----------------------------------------------------------------------------
+*/
+
+#include "gLTFImportConstants.h"
+#include "gLTFDocument.h"
+
+//---------------------------------------------------------------------
+gLTFDocument::gLTFDocument (void)
+{
+}
+
+//---------------------------------------------------------------------
+void gLTFDocument::clear (void)
+{
+	mAccessors.clear();
+	mMeshes.clear();
+	mMaterials.clear();
+	mTextures.clear();
+	mImages.clear();
+	mSamplers.clear();
+	mBufferViews.clear();
+	mBuffers.clear();
+	mNodes.clear();
+	mAnimations.clear();
+	mSkins.clear();
+	mNodeWorldTransformationsDerived.clear();
+}
+
+//---------------------------------------------------------------------
+const gLTFMesh* gLTFDocument::getMeshOfNode (const gLTFNode& node) const
+{
+	return getElementByIndex(mMeshes, node.mMesh);
+}
+
+//---------------------------------------------------------------------
+const gLTFNode* gLTFDocument::getParentNode (const gLTFNode& node) const
+{
+	return getElementByIndex(mNodes, node.mParentNodeDerived);
+}
+
+//---------------------------------------------------------------------
+const gLTFNode* gLTFDocument::getJointNode (const gLTFSkin& skin, size_t jointIndex) const
+{
+	if (jointIndex >= skin.mJoints.size())
+		return 0;
+
+	return getElementByIndex(mNodes, skin.mJoints[jointIndex]);
+}
+
+//---------------------------------------------------------------------
+const Ogre::Matrix4& gLTFDocument::getWorldTransformation (const gLTFNode& node) const
+{
+	const Ogre::Matrix4* matrix = getElementByIndex(mNodeWorldTransformationsDerived, node.mNodeIndex);
+	if (!matrix)
+		return Ogre::Matrix4::IDENTITY;
+
+	return *matrix;
+}
+
+//---------------------------------------------------------------------
+void gLTFDocument::out (void)
+{
+	OUT << "***************** Debug: gLTFDocument *****************\n";
+	OUT << "accessors = " << mAccessors.size() << "\n";
+	OUT << "meshes = " << mMeshes.size() << "\n";
+	OUT << "materials = " << mMaterials.size() << "\n";
+	OUT << "textures = " << mTextures.size() << "\n";
+	OUT << "images = " << mImages.size() << "\n";
+	OUT << "samplers = " << mSamplers.size() << "\n";
+	OUT << "bufferViews = " << mBufferViews.size() << "\n";
+	OUT << "buffers = " << mBuffers.size() << "\n";
+	OUT << "nodes = " << mNodes.size() << "\n";
+	OUT << "animations = " << mAnimations.size() << "\n";
+	OUT << "skins = " << mSkins.size() << "\n";
+}
@@ -34,6 +34,7 @@ bool gLTFImportAccessorsParser::parseAccessors (rapidjson::Value::ConstMemberIte
 	OUT << TAB << "Perform gLTFImportAccessorsParser::parseAccessors\n";
 
 	int index = 0;
+	mAccessors.clear();
 	const rapidjson::Value& array = jsonIterator->value;
 
 	OUT << TAB << "Loop through accessors array\n";
@@ -89,17 +90,20 @@ bool gLTFImportAccessorsParser::parseAccessors (rapidjson::Value::ConstMemberIte
 				// ******** 7. min ********
 				accessor.mMinAvailable = true;
 				const rapidjson::Value& minArray = it->value;
-				for (rapidjson::SizeType iMin = 0; iMin < minArray.Size(); iMin++)
+				for (rapidjson::SizeType iMin = 0; iMin < minArray.Size() && iMin < 16; iMin++)
 				{
-					if (minArray[iMin].IsInt())
+					/* Always store the float value; rapidjson's IsFloat() only returns true if the double can be converted
+					 * to a float without loss of precision, so most of the float values would be skipped otherwise.
+					 * Integer values are also stored as int (used for indices).
+					 */
+					if (minArray[iMin].IsNumber())
 					{
-						accessor.mMinInt[iMin] = minArray[iMin].GetInt();
-						OUT << TABx2 << "value ==> " << accessor.mMinInt[iMin] << "\n";
+						accessor.mMinFloat[iMin] = (float)minArray[iMin].GetDouble();
+						OUT << TABx2 << "value ==> " << accessor.mMinFloat[iMin] << "\n";
 					}
-					else if (minArray[iMin].IsFloat())
+					if (minArray[iMin].IsInt())
 					{
-						accessor.mMinFloat[iMin] = minArray[iMin].GetFloat();
-						OUT << TABx2 << "value ==> " << accessor.mMinFloat[iMin] << "\n";
+						accessor.mMinInt[iMin] = minArray[iMin].GetInt();
 					}
 				}
 			}
@@ -108,17 +112,17 @@ bool gLTFImportAccessorsParser::parseAccessors (rapidjson::Value::ConstMemberIte
 				// ******** 8. max ********
 				accessor.mMaxAvailable = true;
 				const rapidjson::Value& maxArray = it->value;
-				for (rapidjson::SizeType iMax = 0; iMax < maxArray.Size(); iMax++)
+				for (rapidjson::SizeType iMax = 0; iMax < maxArray.Size() && iMax < 16; iMax++)
 				{
-					if (maxArray[iMax].IsInt())
+					// Same as min
+					if (maxArray[iMax].IsNumber())
 					{
-						accessor.mMaxInt[iMax] = maxArray[iMax].GetInt();
-						OUT << TABx2 << "value ==> " << accessor.mMaxInt[iMax] << "\n";
+						accessor.mMaxFloat[iMax] = (float)maxArray[iMax].GetDouble();
+						OUT << TABx2 << "value ==> " << accessor.mMaxFloat[iMax] << "\n";
 					}
-					if (maxArray[iMax].IsFloat())
+					if (maxArray[iMax].IsInt())
 					{
-						accessor.mMaxFloat[iMax] = maxArray[iMax].GetFloat();
-						OUT << TABx2 << "value ==> " << accessor.mMaxFloat[iMax] << "\n";
+						accessor.mMaxInt[iMax] = maxArray[iMax].GetInt();
 					}
 				}
 			}
@@ -135,7 +139,7 @@ bool gLTFImportAccessorsParser::parseAccessors (rapidjson::Value::ConstMemberIte
 			}
 		}
 		
-		mAccessorsMap[index] = accessor;
+		mAccessors.push_back(accessor);
 		++index;
 	}
 
@@ -143,7 +147,8 @@ bool gLTFImportAccessorsParser::parseAccessors (rapidjson::Value::ConstMemberIte
 }
 
 //---------------------------------------------------------------------
-const std::map<int, gLTFAccessor> gLTFImportAccessorsParser::getParsedAccessors(void) const
+void gLTFImportAccessorsParser::takeParsedAccessors(std::vector<gLTFAccessor>& accessors)
 {
-	return mAccessorsMap;
+	accessors.swap(mAccessors);
+	mAccessors.clear();
 }
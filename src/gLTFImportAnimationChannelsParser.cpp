@@ -35,6 +35,7 @@ bool gLTFImportAnimationChannelsParser::parseAnimationChannels (rapidjson::Value
 	OUT << TAB << "Perform gLTFImportAnimationChannelsParser::parseAnimationChannels\n";
 
 	int index = 0;
+	mAnimationChannels.clear();
 	const rapidjson::Value& array = jsonIterator->value;
 
 	OUT << TAB << "Loop through animation channels array\n";
@@ -62,7 +63,7 @@ bool gLTFImportAnimationChannelsParser::parseAnimationChannels (rapidjson::Value
 			}
 		}
 		
-		mAnimationChannelsMap[index] = animationChannel;
+		mAnimationChannels.push_back(animationChannel);
 		++index;
 	}
 
@@ -99,9 +100,10 @@ bool gLTFImportAnimationChannelsParser::parseTarget (rapidjson::Value::ConstMemb
 }
 
 //---------------------------------------------------------------------
-const std::map<int, gLTFAnimationChannel> gLTFImportAnimationChannelsParser::getParsedAnimationChannels (void) const
+void gLTFImportAnimationChannelsParser::takeParsedAnimationChannels (std::vector<gLTFAnimationChannel>& animationChannels)
 {
-	return mAnimationChannelsMap;
+	animationChannels.swap(mAnimationChannels);
+	mAnimationChannels.clear();
 }
 
 
@@ -35,6 +35,7 @@ bool gLTFImportAnimationSamplersParser::parseAnimationSamplers (rapidjson::Value
 	OUT << TAB << "Perform gLTFImportAnimationSamplersParser::parseAnimationSamplers\n";
 
 	int index = 0;
+	mAnimationSamplers.clear();
 	const rapidjson::Value& array = jsonIterator->value;
 
 	OUT << TAB << "Loop through animation samplers array\n";
@@ -69,7 +70,7 @@ bool gLTFImportAnimationSamplersParser::parseAnimationSamplers (rapidjson::Value
 			}
 		}
 		
-		mAnimationSamplersMap[index] = animationSampler;
+		mAnimationSamplers.push_back(animationSampler);
 		++index;
 	}
 
@@ -77,9 +78,10 @@ bool gLTFImportAnimationSamplersParser::parseAnimationSamplers (rapidjson::Value
 }
 
 //---------------------------------------------------------------------
-const std::map<int, gLTFAnimationSampler> gLTFImportAnimationSamplersParser::getParsedAnimationSamplers (void) const
+void gLTFImportAnimationSamplersParser::takeParsedAnimationSamplers (std::vector<gLTFAnimationSampler>& animationSamplers)
 {
-	return mAnimationSamplersMap;
+	animationSamplers.swap(mAnimationSamplers);
+	mAnimationSamplers.clear();
 }
 
 
@@ -35,6 +35,7 @@ bool gLTFImportAnimationsParser::parseAnimations (rapidjson::Value::ConstMemberI
 	OUT << TAB << "Perform gLTFImportAnimationsParser::parseAnimations\n";
 
 	int index = 0;
+	mAnimations.clear();
 	const rapidjson::Value& array = jsonIterator->value;
 
 	OUT << TAB << "Loop through animations array\n";
@@ -53,13 +54,13 @@ bool gLTFImportAnimationsParser::parseAnimations (rapidjson::Value::ConstMemberI
 			{
 				// ******** 1. channels ********
 				mAnimationChannelsParser.parseAnimationChannels(it);
-				animation.mAnimationChannelsMap = mAnimationChannelsParser.getParsedAnimationChannels();
+				mAnimationChannelsParser.takeParsedAnimationChannels(animation.mAnimationChannels);
 			}
 			if (it->value.IsArray() && key == "samplers")
 			{
 				// ******** 2. samplers ********
 				mAnimationSamplersParser.parseAnimationSamplers(it);
-				animation.mAnimationSamplersMap = mAnimationSamplersParser.getParsedAnimationSamplers();
+				mAnimationSamplersParser.takeParsedAnimationSamplers(animation.mAnimationSamplers);
 			}
 			if (it->value.IsString() && key == "name")
 			{
@@ -75,7 +76,7 @@ bool gLTFImportAnimationsParser::parseAnimations (rapidjson::Value::ConstMemberI
 			animation.mName = "Anim_" + generateRandomString();
 		}
 
-		mAnimationsMap[index] = animation;
+		mAnimations.push_back(animation);
 		++index;
 	}
 
@@ -83,9 +84,10 @@ bool gLTFImportAnimationsParser::parseAnimations (rapidjson::Value::ConstMemberI
 }
 
 //---------------------------------------------------------------------
-const std::map<int, gLTFAnimation> gLTFImportAnimationsParser::getParsedAnimations (void) const
+void gLTFImportAnimationsParser::takeParsedAnimations (std::vector<gLTFAnimation>& animations)
 {
-	return mAnimationsMap;
+	animations.swap(mAnimations);
+	mAnimations.clear();
 }
 
 
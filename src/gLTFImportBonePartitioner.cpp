@@ -0,0 +1,173 @@
+/*
+  -----------------------------------------------------------------------------
+  This source file is part of OGRE
+  (Object-oriented Graphics Rendering Engine)
+  For the latest info, see http://www.ogre3d.org/
+
+  Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+  -----------------------------------------------------------------------------
+*/
+
+#include <algorithm>
+#include "gLTFImportBonePartitioner.h"
+#include "gLTFPrimitive.h"
+
+//---------------------------------------------------------------------
+bool gLTFImportBonePartitioner::partition (const gLTFStagedSubmesh& submesh,
+	unsigned int maxBones,
+	gLTFImportThreadPool& threadPool,
+	std::vector<gLTFStagedSubmesh>& partitions)
+{
+	partitions.clear();
+	mOversizedTriangleCount = 0;
+	if (submesh.mMode != gLTFPrimitive::TRIANGLES || !submesh.mHasIndices || maxBones == 0)
+		return false;
+	if (submesh.mBoneInfluences.empty() || submesh.mBoneInfluences.size() != submesh.getVertexCount())
+		return false;
+
+	collectTriangleBones(submesh);
+	size_t triangleCount = submesh.mIndices.size() / 3;
+
+	// Nothing to do if all triangles fit in one palette
+	++mPaletteStamp;
+	mPaletteSize = 0;
+	for (unsigned int t = 0; t < triangleCount; ++t)
+		addTriangleToPalette(t, 0xFFFFFFFF, true);
+	if (mPaletteSize <= maxBones)
+		return false;
+
+	/* Greedy grouping. A partition takes every remaining triangle of which the bones still fit in its palette.
+	 * A triangle that is rejected may fit later, if the palette got bones of other triangles in the meantime, so
+	 * the remaining triangles are visited again as long as the palette grows.
+	 */
+	mHelperRemaining.resize(triangleCount);
+	for (unsigned int t = 0; t < triangleCount; ++t)
+		mHelperRemaining[t] = t;
+	mHelperTriangles.clear();
+	mHelperRanges.clear();
+	std::vector<unsigned int>::const_iterator it;
+	while (!mHelperRemaining.empty())
+	{
+		gLTFImportSpatialSplitter::Range range;
+		range.begin = mHelperTriangles.size();
+		++mPaletteStamp;
+		mPaletteSize = 0;
+		unsigned int paletteSizeBefore;
+		do
+		{
+			paletteSizeBefore = mPaletteSize;
+			mHelperRejected.clear();
+			for (it = mHelperRemaining.begin(); it != mHelperRemaining.end(); ++it)
+			{
+				if (addTriangleToPalette(*it, maxBones, mHelperTriangles.size() == range.begin))
+					mHelperTriangles.push_back(*it);
+				else
+					mHelperRejected.push_back(*it);
+			}
+			mHelperRemaining.swap(mHelperRejected);
+		} while (mPaletteSize != paletteSizeBefore && !mHelperRemaining.empty());
+
+		range.end = mHelperTriangles.size();
+		mHelperRanges.push_back(range);
+	}
+
+	// Create the partitions (compacted vertices) in parallel and determine their palettes
+	mSpatialSplitter.createChunks(submesh, mHelperTriangles, mHelperRanges, threadPool, partitions);
+	std::vector<gLTFStagedSubmesh>::iterator itPartitions;
+	for (itPartitions = partitions.begin(); itPartitions != partitions.end(); ++itPartitions)
+		createBonePalette(*itPartitions);
+
+	OUT << TABx3 << "Partitioned " << triangleCount << " triangles into " << partitions.size() << 
+		" partitions of at most " << maxBones << " bones\n";
+	return true;
+}
+
+//---------------------------------------------------------------------
+void gLTFImportBonePartitioner::collectTriangleBones (const gLTFStagedSubmesh& submesh)
+{
+	size_t triangleCount = submesh.mIndices.size() / 3;
+	mHelperTriangleBones.clear();
+	mHelperTriangleBoneStart.resize(triangleCount + 1);
+	unsigned int maxBone = 0;
+	for (size_t t = 0; t < triangleCount; ++t)
+	{
+		unsigned int start = (unsigned int)mHelperTriangleBones.size();
+		mHelperTriangleBoneStart[t] = start;
+		for (size_t corner = 0; corner < 3; ++corner)
+		{
+			const gLTFStagedSubmesh::BoneInfluences& influences = submesh.mBoneInfluences[submesh.mIndices[t * 3 + corner]];
+			for (size_t i = 0; i < 4; ++i)
+			{
+				if (influences.weights[i] <= 0.0f)
+					continue;
+
+				// Only add the bone once per triangle
+				unsigned int bone = influences.bones[i];
+				if (std::find(mHelperTriangleBones.begin() + start, mHelperTriangleBones.end(), bone) == mHelperTriangleBones.end())
+					mHelperTriangleBones.push_back(bone);
+				maxBone = bone > maxBone ? bone : maxBone;
+			}
+		}
+	}
+	mHelperTriangleBoneStart[triangleCount] = (unsigned int)mHelperTriangleBones.size();
+
+	// Reset the stamps; a bone is in the current palette if its stamp equals mPaletteStamp
+	mHelperPaletteStamp.assign(maxBone + 1, 0);
+	mPaletteStamp = 0;
+}
+
+//---------------------------------------------------------------------
+bool gLTFImportBonePartitioner::addTriangleToPalette (unsigned int triangle, unsigned int maxBones, bool force)
+{
+	unsigned int begin = mHelperTriangleBoneStart[triangle];
+	unsigned int end = mHelperTriangleBoneStart[triangle + 1];
+	unsigned int newBones = 0;
+	for (unsigned int i = begin; i < end; ++i)
+		if (mHelperPaletteStamp[mHelperTriangleBones[i]] != mPaletteStamp)
+			++newBones;
+
+	if (mPaletteSize + newBones > maxBones)
+	{
+		if (!force)
+			return false;
+		++mOversizedTriangleCount;
+	}
+
+	for (unsigned int i = begin; i < end; ++i)
+		mHelperPaletteStamp[mHelperTriangleBones[i]] = mPaletteStamp;
+	mPaletteSize += newBones;
+	return true;
+}
+
+//---------------------------------------------------------------------
+void gLTFImportBonePartitioner::createBonePalette (gLTFStagedSubmesh& partition)
+{
+	partition.mBonePalette.clear();
+	std::vector<gLTFStagedSubmesh::BoneInfluences>::const_iterator it;
+	for (it = partition.mBoneInfluences.begin(); it != partition.mBoneInfluences.end(); ++it)
+		for (size_t i = 0; i < 4; ++i)
+			if (it->weights[i] > 0.0f)
+				partition.mBonePalette.push_back(it->bones[i]);
+
+	std::sort(partition.mBonePalette.begin(), partition.mBonePalette.end());
+	partition.mBonePalette.erase(std::unique(partition.mBonePalette.begin(), partition.mBonePalette.end()), 
+		partition.mBonePalette.end());
+}
@@ -397,6 +397,124 @@ const Ogre::Vector4& gLTFImportBufferReader::readVec4FromUnsignedShortBuffer(cha
 	return mHelperVec4;
 }
 
+//---------------------------------------------------------------------
+template <typename T> static void readVec4Array (const char* buffer, 
+	unsigned int count, 
+	int stride, 
+	std::vector<float>& values)
+{
+	T raw[4];
+	stride = stride > 0 ? stride : 4 * sizeof(T);
+	for (unsigned int i = 0; i < count; ++i)
+	{
+		memcpy(raw, &buffer[i * stride], sizeof(raw));
+		values[i * 4] = (float)raw[0];
+		values[i * 4 + 1] = (float)raw[1];
+		values[i * 4 + 2] = (float)raw[2];
+		values[i * 4 + 3] = (float)raw[3];
+	}
+}
+
+//---------------------------------------------------------------------
+bool gLTFImportBufferReader::readVec4ArrayFromBuffer (const char* buffer, 
+	const gLTFAccessor& accessor, 
+	std::vector<float>& values)
+{
+	values.clear();
+	if (!buffer || accessor.mType != "VEC4")
+		return false;
+
+	values.resize(accessor.mCount * 4);
+	switch (accessor.mComponentType)
+	{
+		case gLTFAccessor::UNSIGNED_BYTE:
+			readVec4Array<unsigned char>(buffer, accessor.mCount, accessor.mByteStrideDerived, values);
+			return true;
+		case gLTFAccessor::UNSIGNED_SHORT:
+			readVec4Array<unsigned short>(buffer, accessor.mCount, accessor.mByteStrideDerived, values);
+			return true;
+		case gLTFAccessor::FLOAT:
+			readVec4Array<float>(buffer, accessor.mCount, accessor.mByteStrideDerived, values);
+			return true;
+	}
+
+	values.clear();
+	return false;
+}
+
+//---------------------------------------------------------------------
+bool gLTFImportBufferReader::readFloatArrayFromBuffer (const char* buffer, 
+	const gLTFAccessor& accessor, 
+	std::vector<float>& values)
+{
+	values.clear();
+	unsigned int componentCount = accessor.getComponentCount();
+	if (!buffer || accessor.mComponentType != gLTFAccessor::FLOAT || componentCount == 0 || accessor.mCount <= 0)
+		return false;
+
+	// Tightly packed elements are copied at once; otherwise per element
+	size_t elementSize = componentCount * sizeof(float);
+	values.resize(accessor.mCount * componentCount);
+	if (accessor.mByteStrideDerived <= 0 || static_cast<size_t>(accessor.mByteStrideDerived) == elementSize)
+	{
+		memcpy(&values[0], buffer, values.size() * sizeof(float));
+		return true;
+	}
+
+	for (int i = 0; i < accessor.mCount; ++i)
+		memcpy(&values[i * componentCount], &buffer[i * accessor.mByteStrideDerived], elementSize);
+
+	return true;
+}
+
+//---------------------------------------------------------------------
+float gLTFImportBufferReader::computeMaxOfArray (const float* values, size_t count)
+{
+	if (count == 0)
+		return 0.0f;
+
+	float maxValue = values[0];
+	size_t i = 0;
+
+#ifdef GLTF_IMPORT_SSE2
+	if (count >= 4)
+	{
+		// 4 running maxima; reduced to one value afterwards
+		__m128 vmax = _mm_loadu_ps(values);
+		for (i = 4; i + 4 <= count; i += 4)
+			vmax = _mm_max_ps(vmax, _mm_loadu_ps(values + i));
+		vmax = _mm_max_ps(vmax, _mm_shuffle_ps(vmax, vmax, _MM_SHUFFLE(1, 0, 3, 2)));
+		vmax = _mm_max_ps(vmax, _mm_shuffle_ps(vmax, vmax, _MM_SHUFFLE(2, 3, 0, 1)));
+		maxValue = _mm_cvtss_f32(vmax);
+	}
+#endif
+
+	// Remaining values (or all values if SSE2 is not available)
+	for (; i < count; ++i)
+		maxValue = values[i] > maxValue ? values[i] : maxValue;
+
+	return maxValue;
+}
+
+//---------------------------------------------------------------------
+void gLTFImportBufferReader::correctArrayWithMinMax (const gLTFAccessor& accessor, std::vector<float>& values)
+{
+	unsigned int componentCount = accessor.getComponentCount();
+	if (componentCount == 0 || componentCount > 16)
+		return;
+
+	size_t count = values.size();
+	unsigned int component = 0;
+	for (size_t i = 0; i < count; ++i)
+	{
+		if (accessor.mMinAvailable && values[i] < accessor.mMinFloat[component])
+			values[i] = accessor.mMinFloat[component];
+		if (accessor.mMaxAvailable && values[i] > accessor.mMaxFloat[component])
+			values[i] = accessor.mMaxFloat[component];
+		component = component + 1 == componentCount ? 0 : component + 1;
+	}
+}
+
 //---------------------------------------------------------------------
 void gLTFImportBufferReader::correctVec2WithMinMax(gLTFAccessor accessor, Ogre::Vector2* vec2)
 {
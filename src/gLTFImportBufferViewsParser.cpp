@@ -34,6 +34,7 @@ bool gLTFImportBufferViewsParser::parseBufferViews (rapidjson::Value::ConstMembe
 	OUT << TAB << "Perform gLTFImportBufferViewsParser::parseBufferViews\n";
 
 	int source = 0;
+	mBufferViews.clear();
 	const rapidjson::Value& array = jsonIterator->value;
 
 	OUT << TAB << "Loop through BufferViews array\n";
@@ -86,7 +87,7 @@ bool gLTFImportBufferViewsParser::parseBufferViews (rapidjson::Value::ConstMembe
 			}
 		}
 
-		mBufferViewsMap[source] = bufferView;
+		mBufferViews.push_back(bufferView);
 		++source;
 	}
 
@@ -94,7 +95,8 @@ bool gLTFImportBufferViewsParser::parseBufferViews (rapidjson::Value::ConstMembe
 }
 
 //---------------------------------------------------------------------
-const std::map<int, gLTFBufferView> gLTFImportBufferViewsParser::getParsedBufferViews (void) const
+void gLTFImportBufferViewsParser::takeParsedBufferViews (std::vector<gLTFBufferView>& bufferViews)
 {
-	return mBufferViewsMap;
+	bufferViews.swap(mBufferViews);
+	mBufferViews.clear();
 }
@@ -34,6 +34,7 @@ bool gLTFImportBuffersParser::parseBuffers (const std::string& fileName, rapidjs
 	OUT << TAB << "Perform gLTFImportBuffersParser::parseBuffers\n";
 
 	int source = 0;
+	mBuffers.clear();
 	const rapidjson::Value& array = jsonIterator->value;
 
 	OUT << TAB << "Loop through Buffers array\n";
@@ -75,7 +76,7 @@ bool gLTFImportBuffersParser::parseBuffers (const std::string& fileName, rapidjs
 			*/
 			buffer.mUri = fileName;
 		}
-		mBuffersMap[source] = buffer;
+		mBuffers.push_back(buffer);
 		++source;
 	}
 
@@ -83,7 +84,8 @@ bool gLTFImportBuffersParser::parseBuffers (const std::string& fileName, rapidjs
 }
 
 //---------------------------------------------------------------------
-const std::map<int, gLTFBuffer> gLTFImportBuffersParser::getParsedBuffers (void) const
+void gLTFImportBuffersParser::takeParsedBuffers (std::vector<gLTFBuffer>& buffers)
 {
-	return mBuffersMap;
+	buffers.swap(mBuffers);
+	mBuffers.clear();
 }
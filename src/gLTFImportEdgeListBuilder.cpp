@@ -0,0 +1,273 @@
+/*
+  -----------------------------------------------------------------------------
+  This source file is part of OGRE
+  (Object-oriented Graphics Rendering Engine)
+  For the latest info, see http://www.ogre3d.org/
+
+  Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+  -----------------------------------------------------------------------------
+*/
+
+#include <unordered_map>
+#include <cstring>
+#include "gLTFImportEdgeListBuilder.h"
+#include "gLTFPrimitive.h"
+
+static const unsigned int NO_TRIANGLE = 0xFFFFFFFF;
+
+struct WeldKey
+{
+	unsigned int bits[3];
+	bool operator== (const WeldKey& other) const
+	{
+		return bits[0] == other.bits[0] && bits[1] == other.bits[1] && bits[2] == other.bits[2];
+	}
+};
+
+struct WeldKeyHash
+{
+	size_t operator() (const WeldKey& key) const
+	{
+		// FNV-1a over the three components
+		unsigned int hash = 2166136261u;
+		for (size_t i = 0; i < 3; ++i)
+		{
+			hash ^= key.bits[i];
+			hash *= 16777619u;
+		}
+		return hash;
+	}
+};
+
+//---------------------------------------------------------------------
+static WeldKey makeWeldKey (float x, float y, float z)
+{
+	// Adding 0 turns -0 into +0, so both weld to the same vertex
+	float position[3] = { x + 0.0f, y + 0.0f, z + 0.0f };
+	WeldKey key;
+	memcpy(key.bits, position, sizeof(key.bits));
+	return key;
+}
+
+//---------------------------------------------------------------------
+gLTFImportEdgeListBuilder::gLTFImportEdgeListBuilder (void) :
+	mComplete(true)
+{
+}
+
+//---------------------------------------------------------------------
+void gLTFImportEdgeListBuilder::clear (void)
+{
+	mSubmeshes.clear();
+	mComplete = true;
+}
+
+//---------------------------------------------------------------------
+void gLTFImportEdgeListBuilder::addSubmesh (const gLTFStagedSubmesh& submesh, unsigned int submeshIndex)
+{
+	if (submesh.mMode != gLTFPrimitive::TRIANGLES)
+		return;
+
+	if (!submesh.mHasIndices)
+	{
+		mComplete = false;
+		return;
+	}
+
+	mSubmeshes.push_back(SubmeshEdges());
+	SubmeshEdges& edges = mSubmeshes.back();
+	edges.submeshIndex = submeshIndex;
+	edges.positionsX = submesh.mPositionsX;
+	edges.positionsY = submesh.mPositionsY;
+	edges.positionsZ = submesh.mPositionsZ;
+	edges.indices = submesh.mIndices;
+}
+
+//---------------------------------------------------------------------
+void gLTFImportEdgeListBuilder::build (gLTFImportThreadPool& threadPool)
+{
+	if (!mComplete)
+		return;
+
+	threadPool.parallelFor(mSubmeshes.size(), [this](size_t i)
+	{
+		buildSubmesh(mSubmeshes[i]);
+	});
+}
+
+//---------------------------------------------------------------------
+void gLTFImportEdgeListBuilder::buildSubmesh (SubmeshEdges& submesh)
+{
+	// Weld the vertices by position
+	size_t vertexCount = submesh.positionsX.size();
+	std::unordered_map<WeldKey, unsigned int, WeldKeyHash> weldMap;
+	weldMap.reserve(vertexCount);
+	submesh.sharedVertices.resize(vertexCount);
+	for (size_t i = 0; i < vertexCount; ++i)
+	{
+		WeldKey key = makeWeldKey(submesh.positionsX[i], submesh.positionsY[i], submesh.positionsZ[i]);
+		std::pair<std::unordered_map<WeldKey, unsigned int, WeldKeyHash>::iterator, bool> result =
+			weldMap.insert(std::make_pair(key, submesh.sharedVertexCount));
+		if (result.second)
+			++submesh.sharedVertexCount;
+		submesh.sharedVertices[i] = result.first->second;
+	}
+
+	/* Connect the edges. An edge of a triangle (v0, v1) is shared with the triangle that has the edge (v1, v0),
+	 * so a new edge is stored with key (v0, v1) and a triangle looks for its reversed edge. A matched edge is
+	 * removed from the map, so an edge never gets more than two triangles.
+	 */
+	size_t triangleCount = submesh.indices.size() / 3;
+	std::unordered_map<unsigned long long, unsigned int> edgeMap;
+	edgeMap.reserve(triangleCount * 3 / 2);
+	submesh.triangles.resize(triangleCount);
+	submesh.edges.clear();
+	submesh.edges.reserve(triangleCount * 3 / 2);
+	for (unsigned int t = 0; t < triangleCount; ++t)
+	{
+		Triangle& triangle = submesh.triangles[t];
+		for (size_t i = 0; i < 3; ++i)
+		{
+			triangle.vertex[i] = submesh.indices[t * 3 + i];
+			triangle.sharedVertex[i] = submesh.sharedVertices[triangle.vertex[i]];
+		}
+
+		for (size_t i = 0; i < 3; ++i)
+		{
+			size_t j = (i + 1) % 3;
+			unsigned long long shared0 = triangle.sharedVertex[i];
+			unsigned long long shared1 = triangle.sharedVertex[j];
+			std::unordered_map<unsigned long long, unsigned int>::iterator it = edgeMap.find((shared1 << 32) | shared0);
+			if (it != edgeMap.end())
+			{
+				Edge& edge = submesh.edges[it->second];
+				edge.triangle[1] = t;
+				edge.degenerate = false;
+				edgeMap.erase(it);
+				continue;
+			}
+
+			Edge edge;
+			edge.triangle[0] = t;
+			edge.triangle[1] = NO_TRIANGLE;
+			edge.vertex[0] = triangle.vertex[i];
+			edge.vertex[1] = triangle.vertex[j];
+			edge.sharedVertex[0] = triangle.sharedVertex[i];
+			edge.sharedVertex[1] = triangle.sharedVertex[j];
+			edge.degenerate = true;
+			edgeMap.insert(std::make_pair((shared0 << 32) | shared1, static_cast<unsigned int>(submesh.edges.size())));
+			submesh.edges.push_back(edge);
+		}
+	}
+
+	// The input is not needed anymore
+	std::vector<float>().swap(submesh.positionsX);
+	std::vector<float>().swap(submesh.positionsY);
+	std::vector<float>().swap(submesh.positionsZ);
+	std::vector<unsigned int>().swap(submesh.indices);
+}
+
+//---------------------------------------------------------------------
+bool gLTFImportEdgeListBuilder::writeToMesh (std::ofstream& dst)
+{
+	if (!mComplete || mSubmeshes.empty())
+		return false;
+
+	/* Ogre uses one edge list for all submeshes. Each submesh is a vertex set and an index set (submeshes do not
+	 * share vertices). The triangle indices and welded vertex indices are global, so they are offset per submesh.
+	 */
+	bool closed = getDegenerateEdgeCount() == 0;
+	dst << TAB << "<edgelists>\n";
+	dst << TABx2 << "<edgelist lodIndex = \"0\" isClosed = \"" << (closed ? "true" : "false") << "\">\n";
+
+	// Triangles
+	dst << TABx3 << "<triangles>\n";
+	unsigned int sharedVertexOffset = 0;
+	for (size_t s = 0; s < mSubmeshes.size(); ++s)
+	{
+		const SubmeshEdges& submesh = mSubmeshes[s];
+		std::vector<Triangle>::const_iterator it;
+		for (it = submesh.triangles.begin(); it != submesh.triangles.end(); ++it)
+		{
+			dst << TABx4 << "<triangle vertexSet=\"" << submesh.submeshIndex << "\" indexSet=\"" << submesh.submeshIndex <<
+				"\" v0=\"" << it->vertex[0] << "\" v1=\"" << it->vertex[1] << "\" v2=\"" << it->vertex[2] <<
+				"\" sv0=\"" << it->sharedVertex[0] + sharedVertexOffset <<
+				"\" sv1=\"" << it->sharedVertex[1] + sharedVertexOffset <<
+				"\" sv2=\"" << it->sharedVertex[2] + sharedVertexOffset << "\" />\n";
+		}
+		sharedVertexOffset += submesh.sharedVertexCount;
+	}
+	dst << TABx3 << "</triangles>\n";
+
+	// Edge groups; one per vertex set
+	dst << TABx3 << "<edgegroups>\n";
+	unsigned int triangleOffset = 0;
+	sharedVertexOffset = 0;
+	for (size_t s = 0; s < mSubmeshes.size(); ++s)
+	{
+		const SubmeshEdges& submesh = mSubmeshes[s];
+		dst << TABx4 << "<edgegroup vertexSet=\"" << submesh.submeshIndex << "\" triangleStart=\"" << triangleOffset <<
+			"\" triangleCount=\"" << submesh.triangles.size() << "\">\n";
+		std::vector<Edge>::const_iterator it;
+		for (it = submesh.edges.begin(); it != submesh.edges.end(); ++it)
+		{
+			dst << TABx5 << "<edge triangle0=\"" << it->triangle[0] + triangleOffset <<
+				"\" triangle1=\"" << (it->degenerate ? NO_TRIANGLE : it->triangle[1] + triangleOffset) <<
+				"\" svertex0=\"" << it->sharedVertex[0] + sharedVertexOffset <<
+				"\" svertex1=\"" << it->sharedVertex[1] + sharedVertexOffset <<
+				"\" vertex0=\"" << it->vertex[0] << "\" vertex1=\"" << it->vertex[1] <<
+				"\" degenerate=\"" << (it->degenerate ? "true" : "false") << "\" />\n";
+		}
+		dst << TABx4 << "</edgegroup>\n";
+		triangleOffset += static_cast<unsigned int>(submesh.triangles.size());
+		sharedVertexOffset += submesh.sharedVertexCount;
+	}
+	dst << TABx3 << "</edgegroups>\n";
+
+	dst << TABx2 << "</edgelist>\n";
+	dst << TAB << "</edgelists>\n";
+	return true;
+}
+
+//---------------------------------------------------------------------
+size_t gLTFImportEdgeListBuilder::getEdgeCount (void) const
+{
+	size_t count = 0;
+	std::vector<SubmeshEdges>::const_iterator it;
+	for (it = mSubmeshes.begin(); it != mSubmeshes.end(); ++it)
+		count += it->edges.size();
+	return count;
+}
+
+//---------------------------------------------------------------------
+size_t gLTFImportEdgeListBuilder::getDegenerateEdgeCount (void) const
+{
+	size_t count = 0;
+	std::vector<SubmeshEdges>::const_iterator it;
+	for (it = mSubmeshes.begin(); it != mSubmeshes.end(); ++it)
+	{
+		std::vector<Edge>::const_iterator itEdge;
+		for (itEdge = it->edges.begin(); itEdge != it->edges.end(); ++itEdge)
+			if (itEdge->degenerate)
+				++count;
+	}
+	return count;
+}
@@ -45,17 +45,7 @@ gLTFImportExecutor::gLTFImportExecutor(void)
 	mTexturesConfigFileName = "";
 	mMeshesConfigFileName = "";
 
-	mAnimationsMap.clear();
-	mSkinsMap.clear();
-	mAccessorsMap.clear();
-	mMeshesMap.clear();
-	mMaterialsMap.clear();
-	mTexturesMap.clear();
-	mImagesMap.clear();
-	mSamplersMap.clear();
-	mBufferViewsMap.clear();
-	mBuffersMap.clear();
-	mNodesMap.clear();
+	mDocument.clear();
 }
 
 //---------------------------------------------------------------------
@@ -65,6 +55,9 @@ bool gLTFImportExecutor::executeImport (Ogre::HlmsEditorPluginData* data)
 
 	bool result = true;
 
+	// Resolve the plugin properties once; the creators only use the resolved values
+	mOptions.resolve(data);
+
 	// Determine filenames
 	std::string fullyQualifiedImportPath = data->mInImportPath + data->mInFileDialogBaseName + "/";
 	std::string fullyQualifiedBaseName = fullyQualifiedImportPath + data->mInFileDialogBaseName;
@@ -94,11 +87,7 @@ bool gLTFImportExecutor::executeImport (Ogre::HlmsEditorPluginData* data)
 		propagateData (data, startBinaryBuffer);
 
 		// Create the Material files
-		result = mPbsMaterialsCreator.createOgrePbsMaterialFiles(data, 
-			mMaterialsMap, 
-			mTexturesMap, 
-			mImagesMap,
-			mSamplersMap);
+		result = mPbsMaterialsCreator.createOgrePbsMaterialFiles(data, mDocument);
 
 		// In case of a full binary file the start of the buffer is +8 bytes
 		if (extension == "glb")
@@ -106,11 +95,8 @@ bool gLTFImportExecutor::executeImport (Ogre::HlmsEditorPluginData* data)
 		
 		// Create the Meshes
 		result = mOgreMeshCreator.createOgreMeshFiles (data, 
-			mNodesMap, 
-			mMeshesMap, 
-			mAnimationsMap,
-			mSkinsMap,
-			mAccessorsMap, 
+			mDocument, 
+			mOptions,
 			startBinaryBuffer,
 			mHasAnimations);
 	}
@@ -237,58 +223,58 @@ bool gLTFImportExecutor::executeJson (const std::string& fileName,
 		if (it->value.IsArray() && name == "animations")
 		{
 			mAnimationsParser.parseAnimations(it); // Parse the animations
-			mAnimationsMap = mAnimationsParser.getParsedAnimations();
+			mAnimationsParser.takeParsedAnimations(mDocument.mAnimations);
 			mHasAnimations = true;
 		}
 		if (it->value.IsArray() && name == "skins")
 		{
 			mSkinsParser.parseSkins(it); // Parse the skins
-			mSkinsMap = mSkinsParser.getParsedSkins();
+			mSkinsParser.takeParsedSkins(mDocument.mSkins);
 		}
 		if (it->value.IsArray() && name == "nodes")
 		{
 			mNodesParser.parseNodes(it); // Parse the nodes
-			mNodesMap = mNodesParser.getParsedNodes();
+			mNodesParser.takeParsedNodes(mDocument.mNodes);
 		}
 		if (it->value.IsArray() && name == "accessors")
 		{
 			mAccessorsParser.parseAccessors(it); // Parse the accessors
-			mAccessorsMap = mAccessorsParser.getParsedAccessors();
+			mAccessorsParser.takeParsedAccessors(mDocument.mAccessors);
 		}
 		if (it->value.IsArray() && name == "meshes")
 		{
 			mMeshesParser.parseMeshes(it); // Parse the meshes
-			mMeshesMap = mMeshesParser.getParsedMeshes();
+			mMeshesParser.takeParsedMeshes(mDocument.mMeshes);
 		}
 		if (it->value.IsArray() && name == "materials")
 		{
 			mMaterialsParser.parseMaterials(it); // Parse the materials
-			mMaterialsMap = mMaterialsParser.getParsedMaterials();
+			mMaterialsParser.takeParsedMaterials(mDocument.mMaterials);
 		}
 		if (it->value.IsArray() && name == "textures")
 		{
 			mTexturesParser.parseTextures(it); // Parse the textures
-			mTexturesMap = mTexturesParser.getParsedTextures();
+			mTexturesParser.takeParsedTextures(mDocument.mTextures);
 		}
 		if (it->value.IsArray() && name == "images")
 		{
 			mImagesParser.parseImages(it); // Parse the images
-			mImagesMap = mImagesParser.getParsedImages();
+			mImagesParser.takeParsedImages(mDocument.mImages);
 		}
 		if (it->value.IsArray() && name == "samplers")
 		{
 			mSamplersParser.parseSamplers(it); // Parse the samplers
-			mSamplersMap = mSamplersParser.getParsedSamplers();
+			mSamplersParser.takeParsedSamplers(mDocument.mSamplers);
 		}
 		if (it->value.IsArray() && name == "bufferViews")
 		{
 			mBufferViewsParser.parseBufferViews(it); // Parse the bufferViews
-			mBufferViewsMap = mBufferViewsParser.getParsedBufferViews();
+			mBufferViewsParser.takeParsedBufferViews(mDocument.mBufferViews);
 		}
 		if (it->value.IsArray() && name == "buffers")
 		{
 			mBuffersParser.parseBuffers(fileName, it); // Parse the buffers
-			mBuffersMap = mBuffersParser.getParsedBuffers();
+			mBuffersParser.takeParsedBuffers(mDocument.mBuffers);
 		}
 
 		gLTFImportBuffersParser mBuffersParser;
@@ -313,6 +299,7 @@ bool gLTFImportExecutor::propagateData (Ogre::HlmsEditorPluginData* data, int st
 	propagateMeshes(data);
 	propagateNodes(data);
 	propagateAnimations(data);
+	indexAnimationChannels();
 	propagateSkins(data);
 	return true;
 }
@@ -322,21 +309,14 @@ bool gLTFImportExecutor::propagateBufferViews (void)
 {
 	// Loop through bufferviews and propagate the data
 	OUT << TABx3 << "Perform gLTFImportExecutor::propagateBufferViews\n";
-	std::map<int, gLTFBufferView>::iterator itBufferViews;
-	int bufferIndex;
-	std::string uriBuffer;
-	if (mBuffersMap.size() > 0)
+	std::vector<gLTFBufferView>::iterator itBufferViews;
+	const gLTFBuffer* buffer;
+	for (itBufferViews = mDocument.mBufferViews.begin(); itBufferViews != mDocument.mBufferViews.end(); itBufferViews++)
 	{
-		for (itBufferViews = mBufferViewsMap.begin(); itBufferViews != mBufferViewsMap.end(); itBufferViews++)
-		{
-			bufferIndex = (itBufferViews->second).mBufferIndex;
-			if (bufferIndex > -1)
-			{
-				// Assume uriBuffer is a file
-				uriBuffer = mBuffersMap[bufferIndex].mUri;
-				(itBufferViews->second).mUriDerived = uriBuffer;
-			}
-		}
+		// Assume uriBuffer is a file
+		buffer = getElementByIndex(mDocument.mBuffers, itBufferViews->mBufferIndex);
+		if (buffer)
+			itBufferViews->mUriDerived = buffer->mUri;
 	}
 
 	return true;
@@ -347,7 +327,7 @@ bool gLTFImportExecutor::propagateMaterials (Ogre::HlmsEditorPluginData* data, i
 {
 	// Loop through materials and propagate the data
 	OUT << TABx3 << "Perform gLTFImportExecutor::propagateMaterials\n";
-	std::map<int, gLTFMaterial>::iterator itMaterials;
+	std::vector<gLTFMaterial>::iterator itMaterials;
 	std::string materialName;
 	std::string uriImage;
 	int textureIndex;
@@ -369,9 +349,9 @@ bool gLTFImportExecutor::propagateMaterials (Ogre::HlmsEditorPluginData* data, i
 	std::string stringTexCount;
 	std::string randomString = generateRandomString();
 	bool fileWritten = false;
-	for (itMaterials = mMaterialsMap.begin(); itMaterials != mMaterialsMap.end(); itMaterials++)
+	for (itMaterials = mDocument.mMaterials.begin(); itMaterials != mDocument.mMaterials.end(); itMaterials++)
 	{
-		materialName = (itMaterials->second).mName;
+		materialName = itMaterials->mName;
 
 		// Write and entry in the materials config file
 		ogreFullyQualifiedMaterialFileName = fullyQualifiedImportPath + materialName + ".material.json";
@@ -385,7 +365,7 @@ bool gLTFImportExecutor::propagateMaterials (Ogre::HlmsEditorPluginData* data, i
 		*/
 
 		// 0. baseColorTexture
-		textureIndex = (itMaterials->second).mPbrMetallicRoughness.mBaseColorTexture.mIndex;
+		textureIndex = itMaterials->mPbrMetallicRoughness.mBaseColorTexture.mIndex;
 		stringTexCount = getImageIndexAsString(textureIndex);
 		uriImage = prepareUri(randomString + "baseColorTexture" + stringTexCount,
 			data,
@@ -393,12 +373,12 @@ bool gLTFImportExecutor::propagateMaterials (Ogre::HlmsEditorPluginData* data, i
 			textureIndex,
 			startBinaryBuffer,
 			fileWritten);
-		(itMaterials->second).mPbrMetallicRoughness.mBaseColorTexture.mUri = uriImage;
+		itMaterials->mPbrMetallicRoughness.mBaseColorTexture.mUri = uriImage;
 		if (fileWritten)
 			writeTextureEntryToConfig(texFile, uriImage, texCount);
 
 		// 1. emissiveTexture
-		textureIndex = (itMaterials->second).mEmissiveTexture.mIndex;
+		textureIndex = itMaterials->mEmissiveTexture.mIndex;
 		stringTexCount = getImageIndexAsString(textureIndex);
 		uriImage = prepareUri(randomString + "emissiveTexture" + stringTexCount,
 			data,
@@ -406,12 +386,12 @@ bool gLTFImportExecutor::propagateMaterials (Ogre::HlmsEditorPluginData* data, i
 			textureIndex,
 			startBinaryBuffer,
 			fileWritten);
-		(itMaterials->second).mEmissiveTexture.mUri = uriImage;
+		itMaterials->mEmissiveTexture.mUri = uriImage;
 		if (fileWritten)
 			writeTextureEntryToConfig(texFile, uriImage, texCount);
 
 		// 2. normalTexture
-		textureIndex = (itMaterials->second).mNormalTexture.mIndex;
+		textureIndex = itMaterials->mNormalTexture.mIndex;
 		stringTexCount = getImageIndexAsString(textureIndex);
 		uriImage = prepareUri(randomString + "normalTexture" + stringTexCount,
 			data,
@@ -419,12 +399,12 @@ bool gLTFImportExecutor::propagateMaterials (Ogre::HlmsEditorPluginData* data, i
 			textureIndex,
 			startBinaryBuffer,
 			fileWritten);
-		(itMaterials->second).mNormalTexture.mUri = uriImage;
+		itMaterials->mNormalTexture.mUri = uriImage;
 		if (fileWritten)
 			writeTextureEntryToConfig(texFile, uriImage, texCount);
 
 		// 3. mOcclusionTexture
-		textureIndex = (itMaterials->second).mOcclusionTexture.mIndex;
+		textureIndex = itMaterials->mOcclusionTexture.mIndex;
 		stringTexCount = getImageIndexAsString(textureIndex);
 		uriImage = prepareUri(randomString + "occlusionTexture" + stringTexCount,
 			data,
@@ -432,7 +412,7 @@ bool gLTFImportExecutor::propagateMaterials (Ogre::HlmsEditorPluginData* data, i
 			textureIndex,
 			startBinaryBuffer,
 			fileWritten);
-		(itMaterials->second).mOcclusionTexture.mUri = uriImage;
+		itMaterials->mOcclusionTexture.mUri = uriImage;
 		if (fileWritten)
 		{
 			writeTextureEntryToConfig(texFile, uriImage, texCount);
@@ -443,7 +423,7 @@ bool gLTFImportExecutor::propagateMaterials (Ogre::HlmsEditorPluginData* data, i
 
 		// 4. metallicRoughnessTexture
 		// Although not used by Ogre3d materials, they are still copied/extracted and used for metallicTexture and roughnessTexture
-		textureIndex = (itMaterials->second).mPbrMetallicRoughness.mMetallicRoughnessTexture.mIndex;
+		textureIndex = itMaterials->mPbrMetallicRoughness.mMetallicRoughnessTexture.mIndex;
 		stringTexCount = getImageIndexAsString(textureIndex);
 		uriImage = prepareUri(randomString + "metallicRoughnessTexture" + stringTexCount,
 			data,
@@ -451,13 +431,13 @@ bool gLTFImportExecutor::propagateMaterials (Ogre::HlmsEditorPluginData* data, i
 			textureIndex,
 			startBinaryBuffer,
 			fileWritten);
-		(itMaterials->second).mPbrMetallicRoughness.mMetallicRoughnessTexture.mUri = uriImage;
+		itMaterials->mPbrMetallicRoughness.mMetallicRoughnessTexture.mUri = uriImage;
 		if (fileWritten)
 			writeTextureEntryToConfig(texFile, uriImage, texCount);
 
 		// 5. metallicTexture (copy of metallicRoughnessTexture)
 		// The metallicRoughnessTexture is used as if it was a metallicTexture
-		textureIndex = (itMaterials->second).mPbrMetallicRoughness.mMetallicRoughnessTexture.mIndex;
+		textureIndex = itMaterials->mPbrMetallicRoughness.mMetallicRoughnessTexture.mIndex;
 		stringTexCount = getImageIndexAsString(textureIndex);
 		uriImage = prepareUri(randomString + "metallicTexture" + stringTexCount,
 			data,
@@ -465,7 +445,7 @@ bool gLTFImportExecutor::propagateMaterials (Ogre::HlmsEditorPluginData* data, i
 			textureIndex,
 			startBinaryBuffer,
 			fileWritten);
-		(itMaterials->second).mPbrMetallicRoughness.mMetallicTexture.mUri = uriImage;
+		itMaterials->mPbrMetallicRoughness.mMetallicTexture.mUri = uriImage;
 		if (fileWritten)
 		{
 			writeTextureEntryToConfig(texFile, uriImage, texCount);
@@ -476,7 +456,7 @@ bool gLTFImportExecutor::propagateMaterials (Ogre::HlmsEditorPluginData* data, i
 
 		// 6. roughnessTexture (copy of metallicRoughnessTexture)
 		// The metallicRoughnessTexture is used as if it was a roughnessTexture
-		textureIndex = (itMaterials->second).mPbrMetallicRoughness.mMetallicRoughnessTexture.mIndex;
+		textureIndex = itMaterials->mPbrMetallicRoughness.mMetallicRoughnessTexture.mIndex;
 		stringTexCount = getImageIndexAsString(textureIndex);
 		uriImage = prepareUri(randomString + "roughnessTexture" + stringTexCount,
 			data,
@@ -484,7 +464,7 @@ bool gLTFImportExecutor::propagateMaterials (Ogre::HlmsEditorPluginData* data, i
 			textureIndex,
 			startBinaryBuffer,
 			fileWritten);
-		(itMaterials->second).mPbrMetallicRoughness.mRoughnessTexture.mUri = uriImage;
+		itMaterials->mPbrMetallicRoughness.mRoughnessTexture.mUri = uriImage;
 		if (fileWritten)
 		{
 			writeTextureEntryToConfig(texFile, uriImage, texCount);
@@ -494,7 +474,7 @@ bool gLTFImportExecutor::propagateMaterials (Ogre::HlmsEditorPluginData* data, i
 		}
 
 		// 7. Extension: KHR diffuseTexture
-		textureIndex = (itMaterials->second).mKHR_PbrSpecularGlossiness.mKHR_DiffuseTexture.mIndex;
+		textureIndex = itMaterials->mKHR_PbrSpecularGlossiness.mKHR_DiffuseTexture.mIndex;
 		stringTexCount = getImageIndexAsString(textureIndex);
 		uriImage = prepareUri(randomString + "diffuseTexture" + stringTexCount,
 			data, 
@@ -502,12 +482,12 @@ bool gLTFImportExecutor::propagateMaterials (Ogre::HlmsEditorPluginData* data, i
 			textureIndex, 
 			startBinaryBuffer,
 			fileWritten);
-		(itMaterials->second).mKHR_PbrSpecularGlossiness.mKHR_DiffuseTexture.mUri = uriImage;
+		itMaterials->mKHR_PbrSpecularGlossiness.mKHR_DiffuseTexture.mUri = uriImage;
 		if (fileWritten)
 			writeTextureEntryToConfig(texFile, uriImage, texCount);
 
 		// 8. Extension: KHR specularGlossinessTexture
-		textureIndex = (itMaterials->second).mKHR_PbrSpecularGlossiness.mKHR_SpecularGlossinessTexture.mIndex;
+		textureIndex = itMaterials->mKHR_PbrSpecularGlossiness.mKHR_SpecularGlossinessTexture.mIndex;
 		stringTexCount = getImageIndexAsString(textureIndex);
 		uriImage = prepareUri(randomString + "specularGlossinessTexture" + stringTexCount,
 			data, 
@@ -515,13 +495,13 @@ bool gLTFImportExecutor::propagateMaterials (Ogre::HlmsEditorPluginData* data, i
 			textureIndex, 
 			startBinaryBuffer,
 			fileWritten);
-		(itMaterials->second).mKHR_PbrSpecularGlossiness.mKHR_SpecularGlossinessTexture.mUri = uriImage;
+		itMaterials->mKHR_PbrSpecularGlossiness.mKHR_SpecularGlossinessTexture.mUri = uriImage;
 		if (fileWritten)
 			writeTextureEntryToConfig(texFile, uriImage, texCount);
 
 		// 9. Extension: glossinessTexture (roughness) (copy of KHR_specularGlossinessTexture)
 		// The specularGlossinessTexture is used as if it was a glossiness texture/roughness texture
-		textureIndex = (itMaterials->second).mKHR_PbrSpecularGlossiness.mKHR_SpecularGlossinessTexture.mIndex;
+		textureIndex = itMaterials->mKHR_PbrSpecularGlossiness.mKHR_SpecularGlossinessTexture.mIndex;
 		stringTexCount = getImageIndexAsString(textureIndex);
 		uriImage = prepareUri(randomString + "glossinessTexture" + stringTexCount,
 			data, 
@@ -529,7 +509,7 @@ bool gLTFImportExecutor::propagateMaterials (Ogre::HlmsEditorPluginData* data, i
 			textureIndex, 
 			startBinaryBuffer,
 			fileWritten);
-		(itMaterials->second).mKHR_PbrSpecularGlossiness.mKHR_GlossinessTexture.mUri = uriImage;
+		itMaterials->mKHR_PbrSpecularGlossiness.mKHR_GlossinessTexture.mUri = uriImage;
 		if (fileWritten)
 		{
 			writeTextureEntryToConfig(texFile, uriImage, texCount);
@@ -540,7 +520,7 @@ bool gLTFImportExecutor::propagateMaterials (Ogre::HlmsEditorPluginData* data, i
 
 		// 10. Extension: KHR specularTexture (copy of KHR_specularGlossinessTexture)
 		// The specularGlossinessTexture is used as if it was a specular texture
-		textureIndex = (itMaterials->second).mKHR_PbrSpecularGlossiness.mKHR_SpecularGlossinessTexture.mIndex;
+		textureIndex = itMaterials->mKHR_PbrSpecularGlossiness.mKHR_SpecularGlossinessTexture.mIndex;
 		stringTexCount = getImageIndexAsString(textureIndex);
 		uriImage = prepareUri(randomString + "specularTexture" + stringTexCount,
 			data, 
@@ -548,7 +528,7 @@ bool gLTFImportExecutor::propagateMaterials (Ogre::HlmsEditorPluginData* data, i
 			textureIndex, 
 			startBinaryBuffer,
 			fileWritten);
-		(itMaterials->second).mKHR_PbrSpecularGlossiness.mKHR_SpecularTexture.mUri = uriImage;
+		itMaterials->mKHR_PbrSpecularGlossiness.mKHR_SpecularTexture.mUri = uriImage;
 		if (fileWritten)
 		{
 			writeTextureEntryToConfig(texFile, uriImage, texCount);
@@ -558,24 +538,24 @@ bool gLTFImportExecutor::propagateMaterials (Ogre::HlmsEditorPluginData* data, i
 		}
 
 		// Add the samplers to the material
-		sampler = getSamplerByTextureIndex((itMaterials->second).mEmissiveTexture.mIndex);
-		(itMaterials->second).mEmissiveTexture.mSampler = sampler;
-		sampler = getSamplerByTextureIndex((itMaterials->second).mNormalTexture.mIndex);
-		(itMaterials->second).mNormalTexture.mSampler = sampler;
-		sampler = getSamplerByTextureIndex((itMaterials->second).mOcclusionTexture.mIndex);
-		(itMaterials->second).mOcclusionTexture.mSampler = sampler;
-		sampler = getSamplerByTextureIndex((itMaterials->second).mPbrMetallicRoughness.mBaseColorTexture.mIndex);
-		(itMaterials->second).mPbrMetallicRoughness.mBaseColorTexture.mSampler = sampler;
-		sampler = getSamplerByTextureIndex((itMaterials->second).mPbrMetallicRoughness.mMetallicRoughnessTexture.mIndex);
-		(itMaterials->second).mPbrMetallicRoughness.mMetallicRoughnessTexture.mSampler = sampler;
-		(itMaterials->second).mPbrMetallicRoughness.mMetallicTexture.mSampler = sampler;
-		(itMaterials->second).mPbrMetallicRoughness.mRoughnessTexture.mSampler = sampler;
-		sampler = getSamplerByTextureIndex((itMaterials->second).mKHR_PbrSpecularGlossiness.mKHR_DiffuseTexture.mIndex);
-		(itMaterials->second).mKHR_PbrSpecularGlossiness.mKHR_DiffuseTexture.mSampler = sampler;
-		sampler = getSamplerByTextureIndex((itMaterials->second).mKHR_PbrSpecularGlossiness.mKHR_SpecularGlossinessTexture.mIndex);
-		(itMaterials->second).mKHR_PbrSpecularGlossiness.mKHR_SpecularGlossinessTexture.mSampler = sampler;
-		(itMaterials->second).mKHR_PbrSpecularGlossiness.mKHR_GlossinessTexture.mSampler = sampler;
-		(itMaterials->second).mKHR_PbrSpecularGlossiness.mKHR_SpecularTexture.mSampler = sampler;
+		sampler = getSamplerByTextureIndex(itMaterials->mEmissiveTexture.mIndex);
+		itMaterials->mEmissiveTexture.mSampler = sampler;
+		sampler = getSamplerByTextureIndex(itMaterials->mNormalTexture.mIndex);
+		itMaterials->mNormalTexture.mSampler = sampler;
+		sampler = getSamplerByTextureIndex(itMaterials->mOcclusionTexture.mIndex);
+		itMaterials->mOcclusionTexture.mSampler = sampler;
+		sampler = getSamplerByTextureIndex(itMaterials->mPbrMetallicRoughness.mBaseColorTexture.mIndex);
+		itMaterials->mPbrMetallicRoughness.mBaseColorTexture.mSampler = sampler;
+		sampler = getSamplerByTextureIndex(itMaterials->mPbrMetallicRoughness.mMetallicRoughnessTexture.mIndex);
+		itMaterials->mPbrMetallicRoughness.mMetallicRoughnessTexture.mSampler = sampler;
+		itMaterials->mPbrMetallicRoughness.mMetallicTexture.mSampler = sampler;
+		itMaterials->mPbrMetallicRoughness.mRoughnessTexture.mSampler = sampler;
+		sampler = getSamplerByTextureIndex(itMaterials->mKHR_PbrSpecularGlossiness.mKHR_DiffuseTexture.mIndex);
+		itMaterials->mKHR_PbrSpecularGlossiness.mKHR_DiffuseTexture.mSampler = sampler;
+		sampler = getSamplerByTextureIndex(itMaterials->mKHR_PbrSpecularGlossiness.mKHR_SpecularGlossinessTexture.mIndex);
+		itMaterials->mKHR_PbrSpecularGlossiness.mKHR_SpecularGlossinessTexture.mSampler = sampler;
+		itMaterials->mKHR_PbrSpecularGlossiness.mKHR_GlossinessTexture.mSampler = sampler;
+		itMaterials->mKHR_PbrSpecularGlossiness.mKHR_SpecularTexture.mSampler = sampler;
 
 		// TODO: Add sampler for KHR
 
@@ -616,17 +596,22 @@ void gLTFImportExecutor::writeTextureEntryToConfig (std::ofstream& texFile, cons
 bool gLTFImportExecutor::propagateAccessors(void)
 {
 	OUT << TABx3 << "Perform gLTFImportExecutor::propagateAccessors\n";
-	std::map<int, gLTFAccessor>::iterator itAccessors;
+	std::vector<gLTFAccessor>::iterator itAccessors;
+	const gLTFBufferView* bufferView;
 
 	// Iterate though the accessors
-	for (itAccessors = mAccessorsMap.begin(); itAccessors != mAccessorsMap.end(); itAccessors++)
+	for (itAccessors = mDocument.mAccessors.begin(); itAccessors != mDocument.mAccessors.end(); itAccessors++)
 	{
-		(itAccessors->second).mBufferIndexDerived = mBufferViewsMap[(itAccessors->second).mBufferView].mBufferIndex;
-		(itAccessors->second).mByteOffsetBufferViewDerived = mBufferViewsMap[(itAccessors->second).mBufferView].mByteOffset;
-		(itAccessors->second).mByteLengthDerived = mBufferViewsMap[(itAccessors->second).mBufferView].mByteLength;
-		(itAccessors->second).mByteStrideDerived = mBufferViewsMap[(itAccessors->second).mBufferView].mByteStride;
-		(itAccessors->second).mTargetDerived = mBufferViewsMap[(itAccessors->second).mBufferView].mTarget;
-		(itAccessors->second).mUriDerived = mBufferViewsMap[(itAccessors->second).mBufferView].mUriDerived;
+		bufferView = getElementByIndex(mDocument.mBufferViews, itAccessors->mBufferView);
+		if (!bufferView)
+			continue; // Accessor without a bufferView (or an invalid one); there is no data to read
+
+		itAccessors->mBufferIndexDerived = bufferView->mBufferIndex;
+		itAccessors->mByteOffsetBufferViewDerived = bufferView->mByteOffset;
+		itAccessors->mByteLengthDerived = bufferView->mByteLength;
+		itAccessors->mByteStrideDerived = bufferView->mByteStride;
+		itAccessors->mTargetDerived = bufferView->mTarget;
+		itAccessors->mUriDerived = bufferView->mUriDerived;
 	}
 
 	return true;
@@ -636,44 +621,52 @@ bool gLTFImportExecutor::propagateAccessors(void)
 bool gLTFImportExecutor::propagateMeshes (Ogre::HlmsEditorPluginData* data)
 {
 	OUT << TABx3 << "Perform gLTFImportExecutor::propagateMeshes\n";
-	std::map<int, gLTFMesh>::iterator itMeshes;
-	std::map<int, gLTFPrimitive>::iterator itPrimitives;
+	std::vector<gLTFMesh>::iterator itMeshes;
+	std::vector<gLTFPrimitive>::iterator itPrimitives;
 	std::string materialName;
 	gLTFAccessor accessor;
 
 	// Iterate though the meshes
-	for (itMeshes = mMeshesMap.begin(); itMeshes  != mMeshesMap.end(); itMeshes++)
+	for (itMeshes = mDocument.mMeshes.begin(); itMeshes  != mDocument.mMeshes.end(); itMeshes++)
 	{
 		// Iterate though the primitives
-		for (itPrimitives = (itMeshes->second).mPrimitiveMap.begin(); itPrimitives != (itMeshes->second).mPrimitiveMap.end(); itPrimitives++)
+		for (itPrimitives = itMeshes->mPrimitives.begin(); itPrimitives != itMeshes->mPrimitives.end(); itPrimitives++)
 		{
-			(itPrimitives->second).mMaterialNameDerived = getMaterialNameByIndex((itPrimitives->second).mMaterial);
+			itPrimitives->mMaterialNameDerived = getMaterialNameByIndex(itPrimitives->mMaterial);
 
 			// Iterate through Attribute map
 			std::map<std::string, int>::iterator itAttr;
-			for (itAttr = (itPrimitives->second).mAttributes.begin(); itAttr != (itPrimitives->second).mAttributes.end(); itAttr++)
+			for (itAttr = itPrimitives->mAttributes.begin(); itAttr != itPrimitives->mAttributes.end(); itAttr++)
 			{
 				// Assign the 
 				if (itAttr->first == "POSITION")
 				{
-					(itPrimitives->second).mPositionAccessorDerived = itAttr->second;
+					itPrimitives->mPositionAccessorDerived = itAttr->second;
 				}
 				if (itAttr->first == "NORMAL")
-					(itPrimitives->second).mNormalAccessorDerived = itAttr->second;
+					itPrimitives->mNormalAccessorDerived = itAttr->second;
 				if (itAttr->first == "TANGENT")
-					(itPrimitives->second).mTangentAccessorDerived = itAttr->second;
+					itPrimitives->mTangentAccessorDerived = itAttr->second;
 				if (itAttr->first == "TEXCOORD_0")
-					(itPrimitives->second).mTexcoord_0AccessorDerived = itAttr->second;
+					itPrimitives->mTexcoord_0AccessorDerived = itAttr->second;
 				if (itAttr->first == "TEXCOORD_1")
-					(itPrimitives->second).mTexcoord_1AccessorDerived = itAttr->second;
+					itPrimitives->mTexcoord_1AccessorDerived = itAttr->second;
 				if (itAttr->first == "COLOR_0")
-					(itPrimitives->second).mColor_0AccessorDerived = itAttr->second;
+					itPrimitives->mColor_0AccessorDerived = itAttr->second;
 				if (itAttr->first == "JOINTS_0")
-					(itPrimitives->second).mJoints_0AccessorDerived = itAttr->second;
+					itPrimitives->mJoints_0AccessorDerived = itAttr->second;
 				if (itAttr->first == "WEIGHTS_0")
-					(itPrimitives->second).mWeights_0AccessorDerived = itAttr->second;
+					itPrimitives->mWeights_0AccessorDerived = itAttr->second;
+				if (itAttr->first == "JOINTS_1")
+					itPrimitives->mJoints_1AccessorDerived = itAttr->second;
+				if (itAttr->first == "WEIGHTS_1")
+					itPrimitives->mWeights_1AccessorDerived = itAttr->second;
 			}
 
+			// Do not read attributes that are not used by the material
+			if (mOptions.mPruneVertexAttributes)
+				pruneUnusedVertexAttributes(*itPrimitives);
+
 			// TODO: Progagate more...
 		}
 	}
@@ -681,28 +674,127 @@ bool gLTFImportExecutor::propagateMeshes (Ogre::HlmsEditorPluginData* data)
 	return true;
 }
 
+//---------------------------------------------------------------------
+void gLTFImportExecutor::pruneUnusedVertexAttributes (gLTFPrimitive& primitive)
+{
+	OUT << TABx4 << "Perform gLTFImportExecutor::pruneUnusedVertexAttributes\n";
+	const gLTFMaterial* pMaterial = getElementByIndex(mDocument.mMaterials, primitive.mMaterial);
+	if (!pMaterial)
+		return;
+
+	// Determine which attributes are used by the material
+	const gLTFMaterial& material = *pMaterial;
+	const MaterialGenericTexture* textures[] = {
+		&material.mPbrMetallicRoughness.mBaseColorTexture,
+		&material.mPbrMetallicRoughness.mMetallicRoughnessTexture,
+		&material.mPbrMetallicRoughness.mMetallicTexture,
+		&material.mPbrMetallicRoughness.mRoughnessTexture,
+		&material.mNormalTexture,
+		&material.mOcclusionTexture,
+		&material.mEmissiveTexture,
+		&material.mKHR_PbrSpecularGlossiness.mKHR_DiffuseTexture,
+		&material.mKHR_PbrSpecularGlossiness.mKHR_SpecularGlossinessTexture,
+		&material.mKHR_PbrSpecularGlossiness.mKHR_GlossinessTexture,
+		&material.mKHR_PbrSpecularGlossiness.mKHR_SpecularTexture };
+	bool usesTexcoord_1 = false;
+	for (size_t i = 0; i < sizeof(textures) / sizeof(textures[0]); ++i)
+		if (textures[i]->isTextureAvailable() && textures[i]->mTextCoord == 1)
+			usesTexcoord_1 = true;
+	bool usesTangents = material.mNormalTexture.isTextureAvailable();
+
+	/* The generated Pbs datablocks do not use vertex colours, so COLOR_0 is never used.
+	 * Setting the accessor to -1 means that the buffer data is never read.
+	 */
+	int* accessors[] = {
+		&primitive.mTexcoord_1AccessorDerived,
+		&primitive.mTangentAccessorDerived,
+		&primitive.mColor_0AccessorDerived };
+	const char* names[] = { "TEXCOORD_1", "TANGENT", "COLOR_0" };
+	bool used[] = { usesTexcoord_1, usesTangents, false };
+	for (size_t i = 0; i < 3; ++i)
+	{
+		if (used[i] || *accessors[i] < 0)
+			continue;
+
+		const gLTFAccessor* accessor = getElementByIndex(mDocument.mAccessors, *accessors[i]);
+		if (accessor)
+			primitive.mPrunedBytesDerived += accessor->getDataSize();
+		if (primitive.mPrunedAttributesDerived != "")
+			primitive.mPrunedAttributesDerived += " ";
+		primitive.mPrunedAttributesDerived += names[i];
+		*accessors[i] = -1;
+	}
+}
+
 //---------------------------------------------------------------------
 bool gLTFImportExecutor::propagateNodes (Ogre::HlmsEditorPluginData* data)
 {
 	OUT << TABx3 << "Perform gLTFImportExecutor::propagateNodes\n";
 
-	// Propagate the mesh to the node and the transformations to child nodes
-	std::map<int, gLTFNode>::iterator itNodes;
-	std::map<int, gLTFNode>::iterator itNodesEnd = mNodesMap.end();
-	gLTFMesh mesh;
-	gLTFAnimation animation;
-	int index = 0;
-	
-	// Iterate though the nodes, propagate transformation to childres and set the derived mesh object
-	for (itNodes = mNodesMap.begin(); itNodes != itNodesEnd; itNodes++)
+	/* Propagate the transformations to child nodes. The mesh of a node is not copied into the node; it is 
+	 * resolved with gLTFDocument::getMeshOfNode.
+	 * First determine the parent of each node from the children arrays, so the roots are known. Then walk through
+	 * the trees and calculate the world transformations. Both steps are linear in the number of nodes.
+	 */
+	int nodeCount = (int)mDocument.mNodes.size();
+	int nodeIndex;
+	size_t i;
+	for (nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex)
+		mDocument.mNodes[nodeIndex].mParentNodeDerived = -1;
+
+	for (nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex)
 	{
-		gLTFNode* node = &itNodes->second;
-		addAnimationsToNode(node, index); // Add all animations to this node
-		node = getTopLevelParentNode(node); // Search for the toplevel node in the tree and start from there
-		propagateNodeTransformsToChildren(&(itNodes->second));
-		mesh = mMeshesMap[itNodes->second.mMesh];
-		itNodes->second.mMeshDerived = mesh;
-		++index;
+		const std::vector<int>& children = mDocument.mNodes[nodeIndex].mChildren;
+		for (i = 0; i < children.size(); ++i)
+		{
+			gLTFNode* childNode = findNodeByIndex(children[i]);
+			if (!childNode)
+			{
+				OUT << TABx3 << "Warning: Child " << children[i] << " of node " << nodeIndex << " does not refer to a node\n";
+				continue;
+			}
+
+			// A node has only one parent according to the specs; the first parent is used
+			if (childNode->mParentNodeDerived > -1)
+			{
+				if (childNode->mParentNodeDerived != nodeIndex)
+					OUT << TABx3 << "Warning: Node " << children[i] << " has multiple parents (node " << 
+						childNode->mParentNodeDerived << " and node " << nodeIndex << "); node " << nodeIndex << " is ignored\n";
+				continue;
+			}
+			childNode->mParentNodeDerived = nodeIndex;
+		}
+	}
+
+	mDocument.mNodeWorldTransformationsDerived.assign(nodeCount, Ogre::Matrix4::IDENTITY);
+	std::vector<bool> visited(nodeCount, false);
+	std::vector<int> queue;
+	queue.reserve(nodeCount);
+	for (nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex)
+	{
+		if (mDocument.mNodes[nodeIndex].mParentNodeDerived < 0)
+			propagateNodeTransformsFromRoot(nodeIndex, queue, visited);
+	}
+
+	/* Nodes that cannot be reached from a root are part of a parent cycle (or below one). Walk up from such a node
+	 * until a node repeats; that node is on the cycle. The cycle is broken by making that node a root, so the parent
+	 * chains always end. All nodes on the walk are below the new root, so each node is walked only once.
+	 */
+	std::vector<bool> walked(nodeCount, false);
+	for (nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex)
+	{
+		if (visited[nodeIndex])
+			continue;
+
+		int cycleNodeIndex = nodeIndex;
+		while (!walked[cycleNodeIndex])
+		{
+			walked[cycleNodeIndex] = true;
+			cycleNodeIndex = mDocument.mNodes[cycleNodeIndex].mParentNodeDerived;
+		}
+		OUT << TABx3 << "Warning: Node " << cycleNodeIndex << " is part of a parent cycle; it is used as a root node\n";
+		mDocument.mNodes[cycleNodeIndex].mParentNodeDerived = -1;
+		propagateNodeTransformsFromRoot(cycleNodeIndex, queue, visited);
 	}
 
 	return true;
@@ -714,24 +806,28 @@ bool gLTFImportExecutor::propagateAnimations (Ogre::HlmsEditorPluginData* data)
 	OUT << TABx3 << "Perform gLTFImportExecutor::propagateAnimations\n";
 
 	// Propagate animation data
-	std::map<int, gLTFAnimation>::iterator itAnimation;
-	std::map<int, gLTFAnimation>::iterator itAnimationEnd = mAnimationsMap.end();
-	std::map<int, gLTFAnimationChannel>::iterator itAnimationChannel;
+	std::vector<gLTFAnimation>::iterator itAnimation;
+	std::vector<gLTFAnimation>::iterator itAnimationEnd = mDocument.mAnimations.end();
+	std::vector<gLTFAnimationChannel>::iterator itAnimationChannel;
 	gLTFAnimation* animation;
-	gLTFAnimationSampler animationSampler;
+	const gLTFAnimationSampler* animationSampler;
 	int index = 0;
 
 	// Iterate though the animations, propagate sampler data to channelobjects
-	for (itAnimation = mAnimationsMap.begin(); itAnimation != itAnimationEnd; itAnimation++)
+	for (itAnimation = mDocument.mAnimations.begin(); itAnimation != itAnimationEnd; itAnimation++)
 	{
-		animation = &itAnimation->second;
-		for (itAnimationChannel = animation->mAnimationChannelsMap.begin(); 
-			itAnimationChannel != animation->mAnimationChannelsMap.end(); itAnimationChannel++)
+		animation = &*itAnimation;
+		for (itAnimationChannel = animation->mAnimationChannels.begin(); 
+			itAnimationChannel != animation->mAnimationChannels.end(); itAnimationChannel++)
 		{
-			animationSampler = getAnimationSamplerByAnimationAndSamplerIndex(animation, (itAnimationChannel->second).mSampler);
-			(itAnimationChannel->second).mInputDerived = animationSampler.mInput;
-			(itAnimationChannel->second).mInterpolationDerived = animationSampler.mInterpolation;
-			(itAnimationChannel->second).mOutputDerived = animationSampler.mOutput;
+			// A channel without a valid sampler keeps its default (invalid) accessors
+			animationSampler = getAnimationSamplerByAnimationAndSamplerIndex(animation, itAnimationChannel->mSampler);
+			if (!animationSampler)
+				continue;
+
+			itAnimationChannel->mInputDerived = animationSampler->mInput;
+			itAnimationChannel->mInterpolationDerived = animationSampler->mInterpolation;
+			itAnimationChannel->mOutputDerived = animationSampler->mOutput;
 		}
 		++index;
 	}
@@ -744,34 +840,20 @@ bool gLTFImportExecutor::propagateSkins (Ogre::HlmsEditorPluginData* data)
 {
 	OUT << TABx3 << "Perform gLTFImportExecutor::propagateSkins\n";
 
-	// Propagate skin data
-	std::map<int, gLTFSkin>::iterator itSkin;
-	std::map<int, gLTFSkin>::iterator itSkinEnd = mSkinsMap.end();
-	std::map<int, int>::iterator itJoint;
-	std::map<int, int>::iterator itJointEnd;
-	gLTFSkin skin;
-	int nodeIndex;
-	int jointIndex;
-	gLTFNode* pNode;
-	gLTFNode node;
+	/* The joints of a skin are node indices; the node of a joint is resolved with gLTFDocument::getJointNode,
+	 * so the nodes are not copied into the skin. Only report joints that do not refer to a node.
+	 */
+	std::vector<gLTFSkin>::iterator itSkin;
+	std::vector<gLTFSkin>::iterator itSkinEnd = mDocument.mSkins.end();
+	size_t jointIndex;
 
-	// Iterate though the skins, propagate nodes
-	for (itSkin = mSkinsMap.begin(); itSkin != itSkinEnd; itSkin++)
+	// Iterate though the skins and validate the joints
+	for (itSkin = mDocument.mSkins.begin(); itSkin != itSkinEnd; itSkin++)
 	{
-		skin = itSkin->second;
-		itJointEnd = (skin.mJoints).end();
-		jointIndex = 0;
-		for (itJoint = (skin.mJoints).begin(); itJoint != itJointEnd; itJoint++)
+		for (jointIndex = 0; jointIndex < itSkin->mJoints.size(); ++jointIndex)
 		{
-			nodeIndex = itJoint->second; // node index is value of joint
-			pNode = findNodeByIndex(nodeIndex);
-			if (pNode)
-			{
-				// Assign the node to the same index as the joint
-				node = *pNode;
-				(itSkin->second).mNodesDerived[jointIndex] = node;
-			}
-			++jointIndex;
+			if (!mDocument.getJointNode(*itSkin, jointIndex))
+				OUT << TABx3 << "Warning: Joint " << jointIndex << " of skin " << itSkin->mName << " does not refer to a node\n";
 		}
 
 		// TEST
@@ -784,75 +866,40 @@ bool gLTFImportExecutor::propagateSkins (Ogre::HlmsEditorPluginData* data)
 }
 
 //---------------------------------------------------------------------
-gLTFNode* gLTFImportExecutor::getTopLevelParentNode (gLTFNode* childNode)
+void gLTFImportExecutor::propagateNodeTransformsFromRoot (int rootNodeIndex, 
+	std::vector<int>& queue, 
+	std::vector<bool>& visited)
 {
-	OUT << TABx3 << "Perform gLTFImportExecutor::getTopLevelParentNode\n";
-
-	std::map<int, gLTFNode>::iterator itNodes;
-	std::map<int, gLTFNode>::iterator itNodesEnd = mNodesMap.end();
-	std::vector<int>::iterator itChildNodes;
-	std::vector<int>::iterator itChildNodesEnd;
-	gLTFNode* node;
-	int count;
-
-	// Iterate trough all node to look for the parent of the childNode (there is only one parent according to the specs)
-	for (itNodes = mNodesMap.begin(); itNodes != itNodesEnd; itNodes++)
+	/* Breadth first walk through the tree below the root node; a parent is always visited before its children, so
+	 * the world transformation of the parent is available when the one of the child is calculated.
+	 */
+	std::vector<Ogre::Matrix4>& worldTransformations = mDocument.mNodeWorldTransformationsDerived;
+	size_t head = queue.size();
+	worldTransformations[rootNodeIndex] = mDocument.mNodes[rootNodeIndex].mLocalTransformation;
+	visited[rootNodeIndex] = true;
+	queue.push_back(rootNodeIndex);
+	while (head < queue.size())
 	{
-		node = &itNodes->second;
-		itChildNodesEnd = node->mChildren.end();
-		count = 0;
-		for (itChildNodes = node->mChildren.begin(); itChildNodes != itChildNodesEnd; itChildNodes++)
+		int nodeIndex = queue[head++];
+		const std::vector<int>& children = mDocument.mNodes[nodeIndex].mChildren;
+		for (size_t i = 0; i < children.size(); ++i)
 		{
-			if (childNode == findNodeByIndex(node->mChildren[count]))
-			{
-				// node is the parent of childNode, Search the parent of node recursive
-				node = getTopLevelParentNode(node);
-				return node;
-			}
-			count++;
+			// Only follow the edge that was accepted as the parent of the child
+			gLTFNode* childNode = findNodeByIndex(children[i]);
+			if (!childNode || childNode->mParentNodeDerived != nodeIndex || visited[children[i]])
+				continue;
+
+			worldTransformations[children[i]] = worldTransformations[nodeIndex] * childNode->mLocalTransformation;
+			visited[children[i]] = true;
+			queue.push_back(children[i]);
 		}
 	}
-
-	return childNode; // There is no parent
-}
-
-//---------------------------------------------------------------------
-void gLTFImportExecutor::propagateNodeTransformsToChildren (gLTFNode* node)
-{
-	OUT << TABx3 << "Perform gLTFImportExecutor::propagateNodeTransformsToChildren\n";
-
-	std::vector<int>::iterator itChildNodes;
-	std::vector<int>::iterator itChildNodesEnd;
-	gLTFNode* childNode;
-	int count;
-
-	itChildNodesEnd = node->mChildren.end();
-	count = 0;
-	for (itChildNodes = node->mChildren.begin(); itChildNodes != itChildNodesEnd; itChildNodes++)
-	{
-		childNode = findNodeByIndex(node->mChildren[count]);
-		childNode->mParentNode = node; // Set the parentnode
-		if (childNode && !childNode->mTransformationCalculated)
-		{
-			childNode->mCalculatedTransformation = node->mCalculatedTransformation * childNode->mCalculatedTransformation;
-			childNode->mTransformationCalculated = true;
-			propagateNodeTransformsToChildren(childNode); // Propagate to the lower tree
-		}
-		count++;
-	}
 }
 
 //---------------------------------------------------------------------
 gLTFNode* gLTFImportExecutor::findNodeByIndex (int nodeIndex)
 {
-	std::map<int, gLTFNode>::iterator it = mNodesMap.find(nodeIndex);
-	if (it != mNodesMap.end())
-	{
-		// Found the node
-		return &(it->second);
-	}
-	
-	return 0;
+	return getElementByIndex(mDocument.mNodes, nodeIndex);
 }
 
 //---------------------------------------------------------------------
@@ -862,16 +909,15 @@ const gLTFImage& gLTFImportExecutor::getImageByTextureIndex (int index)
 
 	mHelperImage = gLTFImage(); // Rest values
 
-	if (index < 0 || index > mTexturesMap.size() - 1)
+	const gLTFTexture* texture = getElementByIndex(mDocument.mTextures, index);
+	if (!texture)
 		return mHelperImage;
 
-	gLTFTexture texture = mTexturesMap[index];
-	int source = texture.mSource;
-
-	if (source < 0 || source > mImagesMap.size() - 1)
+	const gLTFImage* image = getElementByIndex(mDocument.mImages, texture->mSource);
+	if (!image)
 		return mHelperImage;
 
-	mHelperImage = mImagesMap[source];
+	mHelperImage = *image;
 	return mHelperImage;
 }
 
@@ -880,13 +926,11 @@ int gLTFImportExecutor::getImageIndexByTextureIndex (int index)
 {
 	OUT << TABx4 << "Perform gLTFImportExecutor::getImageIndexByTextureIndex\n";
 
-	if (index < 0 || index > mTexturesMap.size() - 1)
+	const gLTFTexture* texture = getElementByIndex(mDocument.mTextures, index);
+	if (!texture)
 		return -1;
 
-	gLTFTexture texture = mTexturesMap[index];
-	int source = texture.mSource;
-	
-	return source;
+	return texture->mSource;
 }
 
 //---------------------------------------------------------------------
@@ -904,11 +948,11 @@ int gLTFImportExecutor::getSamplerByTextureIndex (int index)
 {
 	OUT << TABx4 << "Perform gLTFImportExecutor::getSamplerByTextureIndex\n";
 
-	if (index < 0 || index > mTexturesMap.size() - 1)
+	const gLTFTexture* texture = getElementByIndex(mDocument.mTextures, index);
+	if (!texture)
 		return 0;
 
-	gLTFTexture texture = mTexturesMap[index];
-	return texture.mSampler;
+	return texture->mSampler;
 }
 
 //---------------------------------------------------------------------
@@ -917,11 +961,11 @@ const std::string& gLTFImportExecutor::getMaterialNameByIndex (int index)
 	OUT << TABx4 << "Perform gLTFImportExecutor::getMaterialNameByIndex\n";
 	mHelperMaterialNameString = "BaseWhite";
 
-	std::map<int, gLTFMaterial>::iterator it = mMaterialsMap.find(index);
-	if (it != mMaterialsMap.end())
+	const gLTFMaterial* material = getElementByIndex(mDocument.mMaterials, index);
+	if (material)
 	{
-		// Found the node
-		mHelperMaterialNameString = (it->second).mName;
+		// Found the material
+		mHelperMaterialNameString = material->mName;
 		return mHelperMaterialNameString;
 	}
 
@@ -930,70 +974,42 @@ const std::string& gLTFImportExecutor::getMaterialNameByIndex (int index)
 
 
 //---------------------------------------------------------------------
-void gLTFImportExecutor::addAnimationsToNode (gLTFNode* node, int nodeIndex)
+void gLTFImportExecutor::indexAnimationChannels (void)
 {
-	std::map<int, gLTFAnimation>::iterator it;
-	std::map<int, gLTFAnimation>::iterator itEnd = mAnimationsMap.end();
-	std::map<int, gLTFAnimationChannel>::iterator itChannels;
-	std::map<int, gLTFAnimationChannel>::iterator itChannelsEnd;
-	gLTFAnimation animation;
-	gLTFAnimationChannel animationChannel;
-	for (it = mAnimationsMap.begin(); it != itEnd; it++)
-	{
-		animation = it->second;
-		for (itChannels = animation.mAnimationChannelsMap.begin(); itChannels != animation.mAnimationChannelsMap.end(); itChannels++)
-		{
-			animationChannel = itChannels->second;
-			if (animationChannel.mTargetNode == nodeIndex)
-			{
-				node->mAnimationVector.push_back(animation);
-			}
-		}
-	}
-}
+	OUT << TABx3 << "Perform gLTFImportExecutor::indexAnimationChannels\n";
 
-//---------------------------------------------------------------------
-/*
-gLTFAnimation gLTFImportExecutor::getAnimationByNodeIndex (int nodeIndex)
-{
-	mHelperAnimation = gLTFAnimation();
-	gLTFAnimation animation;
-	gLTFAnimationChannel animationChannel;
-	std::map<int, gLTFAnimation>::iterator it;
-	std::map<int, gLTFAnimation>::iterator itEnd = mAnimationsMap.end();
-	std::map<int, gLTFAnimationChannel>::iterator itChannels;
-	std::map<int, gLTFAnimationChannel>::iterator itChannelsEnd;
-	for (it = mAnimationsMap.begin(); it != itEnd; it++)
+	/* Visit every channel once and add its handle to the node it targets, so consumers only
+	 * have to look at the channels of a node instead of scanning all animations for each node.
+	 * Animations are visited in order, which keeps the handles of a node ordered by animation.
+	 */
+	std::vector<gLTFNode>::iterator itNodes;
+	std::vector<gLTFNode>::iterator itNodesEnd = mDocument.mNodes.end();
+	for (itNodes = mDocument.mNodes.begin(); itNodes != itNodesEnd; ++itNodes)
+		itNodes->mAnimationChannelsDerived.clear();
+
+	gLTFNode* node;
+	gLTFAnimationChannelHandle handle;
+	for (size_t animation = 0; animation < mDocument.mAnimations.size(); ++animation)
 	{
-		animation = it->second;
-		for (itChannels = animation.mAnimationChannelsMap.begin(); itChannels != animation.mAnimationChannelsMap.end(); itChannels++)
+		const std::vector<gLTFAnimationChannel>& channels = mDocument.mAnimations[animation].mAnimationChannels;
+		for (size_t channel = 0; channel < channels.size(); ++channel)
 		{
-			animationChannel = itChannels->second;
-			if (animationChannel.mTargetNode == nodeIndex)
-			{
-				mHelperAnimation = animation;
-				return mHelperAnimation;
-			}
+			node = getElementByIndex(mDocument.mNodes, channels[channel].mTargetNode);
+			if (!node)
+				continue;
+
+			handle.mAnimation = static_cast<int>(animation);
+			handle.mChannel = static_cast<int>(channel);
+			node->mAnimationChannelsDerived.push_back(handle);
 		}
 	}
-
-	return mHelperAnimation;
 }
-*/
 
 //---------------------------------------------------------------------
-gLTFAnimationSampler gLTFImportExecutor::getAnimationSamplerByAnimationAndSamplerIndex(gLTFAnimation* animation, int samplerIndex)
+const gLTFAnimationSampler* gLTFImportExecutor::getAnimationSamplerByAnimationAndSamplerIndex(const gLTFAnimation* animation, 
+	int samplerIndex)
 {
-	mHelperAnimationSampler = gLTFAnimationSampler();
-	std::map<int, gLTFAnimationSampler>::iterator it = animation->mAnimationSamplersMap.find(samplerIndex);
-	if (it != animation->mAnimationSamplersMap.end())
-	{
-		// Found the animation sampler
-		mHelperAnimationSampler = it->second;
-		return mHelperAnimationSampler;
-	}
-
-	return mHelperAnimationSampler;
+	return getElementByIndex(animation->mAnimationSamplers, samplerIndex);
 }
 
 //---------------------------------------------------------------------
@@ -1132,11 +1148,12 @@ const std::string& gLTFImportExecutor::extractAndCreateImageFromFileByTextureInd
 
 	// Get the image; return if it doesn't have a bufferIndex
 	gLTFImage image = getImageByTextureIndex(index);
-	if (image.mBufferView < 0)
+	const gLTFBufferView* pBufferView = getElementByIndex(mDocument.mBufferViews, image.mBufferView);
+	if (!pBufferView)
 		return mHelperString;
 
 	// Get the uri and determine whether it is a file or it contains the bufferdata as base64 encoded string
-	gLTFBufferView bufferView = mBufferViewsMap[image.mBufferView];
+	gLTFBufferView bufferView = *pBufferView;
 	std::string uri = bufferView.mUriDerived; // The uri refers to the (binary) file
 
 	// Uri may not be a base64 encoded one
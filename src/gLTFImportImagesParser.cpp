@@ -34,6 +34,7 @@ bool gLTFImportImagesParser::parseImages (rapidjson::Value::ConstMemberIterator
 	OUT << TAB << "Perform gLTFImportImagesParser::parseImages\n";
 
 	int source = 0;
+	mImages.clear();
 	const rapidjson::Value& array = jsonIterator->value;
 
 	OUT << TAB << "Loop through images array\n";
@@ -73,7 +74,7 @@ bool gLTFImportImagesParser::parseImages (rapidjson::Value::ConstMemberIterator
 		{
 			image.mMimeType = getMimeTypeFromBase64Uri(image.mUri);
 		}
-		mImagesMap[source] = image;
+		mImages.push_back(image);
 		++source;
 	}
 
@@ -81,9 +82,10 @@ bool gLTFImportImagesParser::parseImages (rapidjson::Value::ConstMemberIterator
 }
 
 //---------------------------------------------------------------------
-const std::map<int, gLTFImage> gLTFImportImagesParser::getParsedImages (void) const
+void gLTFImportImagesParser::takeParsedImages (std::vector<gLTFImage>& images)
 {
-	return mImagesMap;
+	images.swap(mImages);
+	mImages.clear();
 }
 
 
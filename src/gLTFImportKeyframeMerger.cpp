@@ -0,0 +1,389 @@
+/*
+  -----------------------------------------------------------------------------
+  This source file is part of OGRE
+  (Object-oriented Graphics Rendering Engine)
+  For the latest info, see http://www.ogre3d.org/
+
+  Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+  -----------------------------------------------------------------------------
+*/
+
+#include "gLTFImportKeyframeMerger.h"
+#include "gLTFImportConstants.h"
+#include <algorithm>
+#include <cmath>
+
+//---------------------------------------------------------------------
+static void computeSlerpWeights (const float* a, const float* b, float s, float& weightA, float& weightB)
+{
+	// Shortest path; close rotations use a normalized lerp, because sin(theta) approaches 0
+	float dot = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+	float sign = dot < 0.0f ? -1.0f : 1.0f;
+	dot = fabsf(dot);
+	if (dot > 0.9995f)
+	{
+		weightA = 1.0f - s;
+		weightB = sign * s;
+		return;
+	}
+
+	float theta = acosf(dot);
+	float sinTheta = sinf(theta);
+	weightA = sinf((1.0f - s) * theta) / sinTheta;
+	weightB = sign * sinf(s * theta) / sinTheta;
+}
+
+//---------------------------------------------------------------------
+static void blendArrays (const float* a, const float* weightsA, const float* b, const float* weightsB, float* result, size_t count)
+{
+	size_t i = 0;
+
+#ifdef GLTF_IMPORT_SSE2
+	for (; i + 4 <= count; i += 4)
+	{
+		_mm_storeu_ps(result + i, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(weightsA + i)),
+			_mm_mul_ps(_mm_loadu_ps(b + i), _mm_loadu_ps(weightsB + i))));
+	}
+#endif
+
+	// Remaining values (or all values if SSE2 is not available)
+	for (; i < count; ++i)
+		result[i] = a[i] * weightsA[i] + b[i] * weightsB[i];
+}
+
+//---------------------------------------------------------------------
+static void normalizeQuaternions (float* q, size_t count)
+{
+	size_t i = 0;
+
+#ifdef GLTF_IMPORT_SSE2
+	// One quaternion per register; the squared length is summed into all 4 lanes. Zero quaternions remain zero
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	__m128 v, lengthSquared;
+	for (; i < count; ++i)
+	{
+		v = _mm_loadu_ps(q + 4 * i);
+		lengthSquared = _mm_mul_ps(v, v);
+		lengthSquared = _mm_add_ps(lengthSquared, _mm_shuffle_ps(lengthSquared, lengthSquared, _MM_SHUFFLE(1, 0, 3, 2)));
+		lengthSquared = _mm_add_ps(lengthSquared, _mm_shuffle_ps(lengthSquared, lengthSquared, _MM_SHUFFLE(2, 3, 0, 1)));
+		v = _mm_mul_ps(v, _mm_and_ps(_mm_div_ps(one, _mm_sqrt_ps(lengthSquared)), _mm_cmpgt_ps(lengthSquared, zero)));
+		_mm_storeu_ps(q + 4 * i, v);
+	}
+#endif
+
+	// All quaternions if SSE2 is not available
+	float length;
+	for (; i < count; ++i)
+	{
+		float* p = q + 4 * i;
+		length = sqrtf(p[0] * p[0] + p[1] * p[1] + p[2] * p[2] + p[3] * p[3]);
+		if (length > 0.0f)
+		{
+			p[0] /= length;
+			p[1] /= length;
+			p[2] /= length;
+			p[3] /= length;
+		}
+	}
+}
+
+//---------------------------------------------------------------------
+void gLTFImportKeyframeMerger::clear (void)
+{
+	mChannels.clear();
+	mTimes.clear();
+	mValues.clear();
+	mKeyframes.clear();
+}
+
+//---------------------------------------------------------------------
+bool gLTFImportKeyframeMerger::addChannel (Path path, 
+	Interpolation interpolation, 
+	const std::vector<float>& times, 
+	const std::vector<float>& values)
+{
+	size_t components = path == ROTATION ? 4 : 3;
+	size_t timeCount = times.size();
+	size_t valuesPerTime = interpolation == CUBICSPLINE ? 3 * components : components;
+	if (timeCount == 0 || values.size() != timeCount * valuesPerTime)
+		return false;
+
+	Channel channel;
+	channel.path = path;
+	channel.interpolation = interpolation;
+	channel.firstTime = mTimes.size();
+	channel.timeCount = timeCount;
+	channel.firstValue = mValues.size();
+	channel.components = components;
+	mTimes.insert(mTimes.end(), times.begin(), times.end());
+	mValues.insert(mValues.end(), values.begin(), values.end());
+	mChannels.push_back(channel);
+	return true;
+}
+
+//---------------------------------------------------------------------
+const float* gLTFImportKeyframeMerger::getValue (const Channel& channel, size_t i) const
+{
+	// A CUBICSPLINE sample is stored as in-tangent, value, out-tangent
+	if (channel.interpolation == CUBICSPLINE)
+		return &mValues[channel.firstValue + (3 * i + 1) * channel.components];
+
+	return &mValues[channel.firstValue + i * channel.components];
+}
+
+//---------------------------------------------------------------------
+void gLTFImportKeyframeMerger::evaluateSegment (const Channel& channel, size_t segment, float time, float* value) const
+{
+	size_t components = channel.components;
+	size_t k;
+	const float* a = getValue(channel, segment);
+	float t0 = mTimes[channel.firstTime + segment];
+	if (channel.interpolation == STEP || segment + 1 >= channel.timeCount || time <= t0)
+	{
+		for (k = 0; k < components; ++k)
+			value[k] = a[k];
+		return;
+	}
+
+	const float* b = getValue(channel, segment + 1);
+	float duration = mTimes[channel.firstTime + segment + 1] - t0;
+	float s = duration > 0.0f ? std::min((time - t0) / duration, 1.0f) : 1.0f;
+	if (channel.interpolation == CUBICSPLINE)
+	{
+		// Hermite spline with the out-tangent of the first sample and the in-tangent of the second sample
+		const float* outTangent = a + components;
+		const float* inTangent = b - components;
+		float s2 = s * s;
+		float s3 = s2 * s;
+		float h00 = 2.0f * s3 - 3.0f * s2 + 1.0f;
+		float h10 = (s3 - 2.0f * s2 + s) * duration;
+		float h01 = -2.0f * s3 + 3.0f * s2;
+		float h11 = (s3 - s2) * duration;
+		for (k = 0; k < components; ++k)
+			value[k] = h00 * a[k] + h10 * outTangent[k] + h01 * b[k] + h11 * inTangent[k];
+		if (channel.path == ROTATION)
+			normalizeQuaternions(value, 1);
+		return;
+	}
+
+	float weightA = 1.0f - s;
+	float weightB = s;
+	if (channel.path == ROTATION)
+		computeSlerpWeights(a, b, s, weightA, weightB);
+	for (k = 0; k < components; ++k)
+		value[k] = weightA * a[k] + weightB * b[k];
+	if (channel.path == ROTATION)
+		normalizeQuaternions(value, 1);
+}
+
+//---------------------------------------------------------------------
+void gLTFImportKeyframeMerger::evaluate (size_t channelIndex, float time, float* value) const
+{
+	const Channel& channel = mChannels[channelIndex];
+	const float* times = &mTimes[channel.firstTime];
+	size_t segment = std::upper_bound(times, times + channel.timeCount, time) - times;
+	evaluateSegment(channel, segment > 0 ? segment - 1 : 0, time, value);
+}
+
+//---------------------------------------------------------------------
+void gLTFImportKeyframeMerger::setKeyframeValue (Keyframe& keyframe, Path path, const float* value) const
+{
+	switch (path)
+	{
+	case TRANSLATION:
+		keyframe.hasTranslation = true;
+		keyframe.translation = Ogre::Vector3(value[0], value[1], value[2]);
+		break;
+	case ROTATION:
+		keyframe.hasRotation = true;
+		keyframe.rotation = Ogre::Quaternion(value[3], value[0], value[1], value[2]);
+		break;
+	case SCALE:
+		keyframe.hasScale = true;
+		keyframe.scale = Ogre::Vector3(value[0], value[1], value[2]);
+		break;
+	}
+}
+
+//---------------------------------------------------------------------
+void gLTFImportKeyframeMerger::merge (float tolerance)
+{
+	mKeyframes.clear();
+	mCursors.assign(mChannels.size(), 0);
+	size_t channelCount = mChannels.size();
+	size_t c;
+	float time;
+	bool pending;
+	float value[4];
+	while (true)
+	{
+		// Smallest pending time; there are at most a few channels per bone, so a linear scan is used
+		pending = false;
+		time = 0.0f;
+		for (c = 0; c < channelCount; ++c)
+		{
+			const Channel& channel = mChannels[c];
+			if (mCursors[c] < channel.timeCount && (!pending || mTimes[channel.firstTime + mCursors[c]] < time))
+			{
+				time = mTimes[channel.firstTime + mCursors[c]];
+				pending = true;
+			}
+		}
+		if (!pending)
+			break;
+
+		// Consume the samples of all channels at this time (within the tolerance); evaluate the other channels
+		mKeyframes.push_back(Keyframe());
+		Keyframe& keyframe = mKeyframes.back();
+		keyframe.time = time;
+		for (c = 0; c < channelCount; ++c)
+		{
+			const Channel& channel = mChannels[c];
+			size_t& cursor = mCursors[c];
+			if (cursor >= channel.timeCount || mTimes[channel.firstTime + cursor] > time + tolerance)
+			{
+				// The cursor is the next sample, so the segment is known
+				evaluateSegment(channel, cursor > 0 ? cursor - 1 : 0, time, value);
+				setKeyframeValue(keyframe, channel.path, value);
+				continue;
+			}
+
+			// Samples of the same channel that collapse into one keyframe; the last one wins
+			while (cursor + 1 < channel.timeCount && mTimes[channel.firstTime + cursor + 1] <= time + tolerance)
+				++cursor;
+
+			setKeyframeValue(keyframe, channel.path, getValue(channel, cursor));
+			++cursor;
+		}
+	}
+}
+
+//---------------------------------------------------------------------
+void gLTFImportKeyframeMerger::evaluateLinearBatch (const Channel& channel)
+{
+	size_t count = mHelperTimes.size();
+	size_t components = channel.components;
+	size_t size = count * components;
+	mHelperA.resize(size);
+	mHelperB.resize(size);
+	mHelperWeightsA.resize(size);
+	mHelperWeightsB.resize(size);
+	mHelperResult.resize(size);
+
+	// Gather the samples around each time and determine their weights; the times are increasing
+	const float* times = &mTimes[channel.firstTime];
+	size_t segment = 0;
+	size_t k;
+	float time, s, weightA, weightB;
+	const float* a;
+	const float* b;
+	for (size_t i = 0; i < count; ++i)
+	{
+		time = mHelperTimes[i];
+		while (segment + 1 < channel.timeCount && times[segment + 1] <= time)
+			++segment;
+
+		a = getValue(channel, segment);
+		b = a;
+		s = 0.0f;
+		if (segment + 1 < channel.timeCount && time > times[segment])
+		{
+			b = getValue(channel, segment + 1);
+			s = std::min((time - times[segment]) / (times[segment + 1] - times[segment]), 1.0f);
+		}
+
+		weightA = 1.0f - s;
+		weightB = s;
+		if (channel.path == ROTATION)
+			computeSlerpWeights(a, b, s, weightA, weightB);
+		for (k = 0; k < components; ++k)
+		{
+			mHelperA[i * components + k] = a[k];
+			mHelperB[i * components + k] = b[k];
+			mHelperWeightsA[i * components + k] = weightA;
+			mHelperWeightsB[i * components + k] = weightB;
+		}
+	}
+
+	// Lerp (or slerp with the weights above) all samples at once
+	blendArrays(&mHelperA[0], &mHelperWeightsA[0], &mHelperB[0], &mHelperWeightsB[0], &mHelperResult[0], size);
+	if (channel.path == ROTATION)
+		normalizeQuaternions(&mHelperResult[0], count);
+}
+
+//---------------------------------------------------------------------
+void gLTFImportKeyframeMerger::resample (float rate)
+{
+	mKeyframes.clear();
+	if (mChannels.empty() || rate <= 0.0f)
+		return;
+
+	// Time span of all channels
+	float start = mTimes[mChannels[0].firstTime];
+	float end = start;
+	std::vector<Channel>::const_iterator it;
+	for (it = mChannels.begin(); it != mChannels.end(); ++it)
+	{
+		start = std::min(start, mTimes[it->firstTime]);
+		end = std::max(end, mTimes[it->firstTime + it->timeCount - 1]);
+	}
+
+	// Uniform times; the last time of the channels is always a keyframe
+	mHelperTimes.clear();
+	size_t steps = static_cast<size_t>(floorf((end - start) * rate));
+	for (size_t i = 0; i <= steps; ++i)
+		mHelperTimes.push_back(start + static_cast<float>(i) / rate);
+	if (end - mHelperTimes.back() > 0.5f / rate)
+		mHelperTimes.push_back(end);
+	else
+		mHelperTimes.back() = end;
+
+	size_t count = mHelperTimes.size();
+	mKeyframes.resize(count);
+	size_t i;
+	for (i = 0; i < count; ++i)
+		mKeyframes[i].time = mHelperTimes[i];
+
+	// Evaluate the channels one by one for all times
+	const float* times;
+	size_t segment;
+	for (it = mChannels.begin(); it != mChannels.end(); ++it)
+	{
+		if (it->interpolation == LINEAR)
+			evaluateLinearBatch(*it);
+		else
+		{
+			mHelperResult.resize(count * it->components);
+			times = &mTimes[it->firstTime];
+			segment = 0;
+			for (i = 0; i < count; ++i)
+			{
+				while (segment + 1 < it->timeCount && times[segment + 1] <= mHelperTimes[i])
+					++segment;
+				evaluateSegment(*it, segment, mHelperTimes[i], &mHelperResult[i * it->components]);
+			}
+		}
+
+		for (i = 0; i < count; ++i)
+			setKeyframeValue(mKeyframes[i], it->path, &mHelperResult[i * it->components]);
+	}
+}
@@ -0,0 +1,172 @@
+/*
+  -----------------------------------------------------------------------------
+  This source file is part of OGRE
+  (Object-oriented Graphics Rendering Engine)
+  For the latest info, see http://www.ogre3d.org/
+
+  Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+  -----------------------------------------------------------------------------
+*/
+
+#include "gLTFImportKeyframeReducer.h"
+#include <cmath>
+
+//---------------------------------------------------------------------
+gLTFImportKeyframeReducer::gLTFImportKeyframeReducer (void)
+{
+	setTolerances(0.001f, 0.001f, 0.001f);
+}
+
+//---------------------------------------------------------------------
+void gLTFImportKeyframeReducer::setTolerances (float positionTolerance, float rotationTolerance, float scaleTolerance)
+{
+	mPositionTolerance = positionTolerance;
+	mScaleTolerance = scaleTolerance;
+	mMaxRotationDistance = 2.0f * sinf(0.25f * rotationTolerance);
+}
+
+//---------------------------------------------------------------------
+static Ogre::Vector3 getTranslation (const gLTFImportKeyframeMerger::Keyframe& keyframe)
+{
+	return keyframe.hasTranslation ? keyframe.translation : Ogre::Vector3(0.0f, 0.0f, 0.0f);
+}
+
+//---------------------------------------------------------------------
+static Ogre::Quaternion getRotation (const gLTFImportKeyframeMerger::Keyframe& keyframe)
+{
+	return keyframe.hasRotation ? keyframe.rotation : Ogre::Quaternion(1.0f, 0.0f, 0.0f, 0.0f);
+}
+
+//---------------------------------------------------------------------
+static Ogre::Vector3 getScale (const gLTFImportKeyframeMerger::Keyframe& keyframe)
+{
+	return keyframe.hasScale ? keyframe.scale : Ogre::Vector3(1.0f, 1.0f, 1.0f);
+}
+
+//---------------------------------------------------------------------
+bool gLTFImportKeyframeReducer::isPositionEqual (const Ogre::Vector3& a, const Ogre::Vector3& b, float tolerance) const
+{
+	return fabsf(a.x - b.x) <= tolerance && fabsf(a.y - b.y) <= tolerance && fabsf(a.z - b.z) <= tolerance;
+}
+
+//---------------------------------------------------------------------
+bool gLTFImportKeyframeReducer::isRotationEqual (const Ogre::Quaternion& a, const Ogre::Quaternion& b) const
+{
+	/* The distance between two unit quaternions is 2 * sin(angle / 4), where angle is the angle of the rotation 
+	 * between them. Unlike the dot product (cos(angle / 2)), it keeps its float precision for small angles. 
+	 * q and -q are the same rotation.
+	 */
+	float lengthA = sqrtf(a.w * a.w + a.x * a.x + a.y * a.y + a.z * a.z);
+	float lengthB = sqrtf(b.w * b.w + b.x * b.x + b.y * b.y + b.z * b.z);
+	if (lengthA <= 0.0f || lengthB <= 0.0f)
+		return lengthA == lengthB;
+
+	float sign = (a.w * b.w + a.x * b.x + a.y * b.y + a.z * b.z) < 0.0f ? -1.0f : 1.0f;
+	float scaleA = 1.0f / lengthA;
+	float scaleB = sign / lengthB;
+	float dw = a.w * scaleA - b.w * scaleB;
+	float dx = a.x * scaleA - b.x * scaleB;
+	float dy = a.y * scaleA - b.y * scaleB;
+	float dz = a.z * scaleA - b.z * scaleB;
+	return dw * dw + dx * dx + dy * dy + dz * dz <= mMaxRotationDistance * mMaxRotationDistance;
+}
+
+//---------------------------------------------------------------------
+bool gLTFImportKeyframeReducer::isReconstructable (const gLTFImportKeyframeMerger::Keyframe& first,
+	const gLTFImportKeyframeMerger::Keyframe& last,
+	const gLTFImportKeyframeMerger::Keyframe& keyframe) const
+{
+	float duration = last.time - first.time;
+	float t = duration > 0.0f ? (keyframe.time - first.time) / duration : 0.0f;
+
+	// Translation and scale are interpolated linearly
+	Ogre::Vector3 a = getTranslation(first);
+	Ogre::Vector3 b = getTranslation(last);
+	if (!isPositionEqual(a + (b - a) * t, getTranslation(keyframe), mPositionTolerance))
+		return false;
+
+	a = getScale(first);
+	b = getScale(last);
+	if (!isPositionEqual(a + (b - a) * t, getScale(keyframe), mScaleTolerance))
+		return false;
+
+	// Rotation; Ogre interpolates skeletal animations with a normalized lerp over the shortest path
+	Ogre::Quaternion qa = getRotation(first);
+	Ogre::Quaternion qb = getRotation(last);
+	float sign = (qa.w * qb.w + qa.x * qb.x + qa.y * qb.y + qa.z * qb.z) < 0.0f ? -1.0f : 1.0f;
+	Ogre::Quaternion q(qa.w + (sign * qb.w - qa.w) * t,
+		qa.x + (sign * qb.x - qa.x) * t,
+		qa.y + (sign * qb.y - qa.y) * t,
+		qa.z + (sign * qb.z - qa.z) * t);
+	return isRotationEqual(q, getRotation(keyframe));
+}
+
+//---------------------------------------------------------------------
+size_t gLTFImportKeyframeReducer::reduce (std::vector<gLTFImportKeyframeMerger::Keyframe>& keyframes) const
+{
+	size_t count = keyframes.size();
+	if (count < 3)
+		return 0;
+
+	/* Greedy pass; a keyframe is removed if all keyframes since the last kept keyframe are reconstructable from
+	 * the last kept keyframe and the next keyframe. The kept keyframes are compacted in place; the write position
+	 * never passes the anchor, so the keyframes that are still compared are not overwritten.
+	 */
+	size_t anchor = 0;
+	size_t written = 1;
+	size_t k;
+	bool removable;
+	for (size_t i = 1; i + 1 < count; ++i)
+	{
+		removable = true;
+		for (k = anchor + 1; k <= i && removable; ++k)
+			removable = isReconstructable(keyframes[anchor], keyframes[i + 1], keyframes[k]);
+
+		if (removable)
+			continue;
+
+		keyframes[written] = keyframes[i];
+		anchor = i;
+		++written;
+	}
+	keyframes[written] = keyframes[count - 1];
+	++written;
+	keyframes.resize(written);
+	return count - written;
+}
+
+//---------------------------------------------------------------------
+bool gLTFImportKeyframeReducer::isConstant (const std::vector<gLTFImportKeyframeMerger::Keyframe>& keyframes,
+	const Ogre::Vector3& position,
+	const Ogre::Quaternion& rotation,
+	const Ogre::Vector3& scale) const
+{
+	std::vector<gLTFImportKeyframeMerger::Keyframe>::const_iterator it;
+	for (it = keyframes.begin(); it != keyframes.end(); ++it)
+	{
+		if (!isPositionEqual(getTranslation(*it), position, mPositionTolerance) ||
+			!isRotationEqual(getRotation(*it), rotation) ||
+			!isPositionEqual(getScale(*it), scale, mScaleTolerance))
+			return false;
+	}
+
+	return true;
+}
@@ -41,6 +41,7 @@ bool gLTFImportMaterialsParser::parseMaterials (rapidjson::Value::ConstMemberIte
 
 	std::string name;
 	int count = 0;
+	mMaterials.clear();
 	const rapidjson::Value& array = jsonIterator->value;
 
 	OUT << TAB << "Loop through materials array\n";
@@ -122,7 +123,7 @@ bool gLTFImportMaterialsParser::parseMaterials (rapidjson::Value::ConstMemberIte
 		}
 		
 		std::replace(material.mName.begin(), material.mName.end(), ' ', '_');
-		mMaterialsMap[count] = material;
+		mMaterials.push_back(material);
 		count++;
 	}
 
@@ -130,9 +131,10 @@ bool gLTFImportMaterialsParser::parseMaterials (rapidjson::Value::ConstMemberIte
 }
 
 //---------------------------------------------------------------------
-const std::map<int, gLTFMaterial> gLTFImportMaterialsParser::getParsedMaterials (void) const
+void gLTFImportMaterialsParser::takeParsedMaterials (std::vector<gLTFMaterial>& materials)
 {
-	return mMaterialsMap;
+	materials.swap(mMaterials);
+	mMaterials.clear();
 }
 
 //---------------------------------------------------------------------
@@ -34,6 +34,7 @@ bool gLTFImportMeshesParser::parseMeshes (rapidjson::Value::ConstMemberIterator
 	OUT << TAB << "Perform gLTFImportMeshesParser::parseMeshes\n";
 
 	int index = 0;
+	mMeshes.clear();
 	const rapidjson::Value& array = jsonIterator->value;
 	for (rapidjson::SizeType i = 0; i < array.Size(); i++)
 	{
@@ -56,7 +57,7 @@ bool gLTFImportMeshesParser::parseMeshes (rapidjson::Value::ConstMemberIterator
 			{
 				// ******** 2. primitives ********
 				mPrimitivesParser.parsePrimitives(it);
-				mesh.mPrimitiveMap = mPrimitivesParser.getParsedPrimitives();
+				mPrimitivesParser.takeParsedPrimitives(mesh.mPrimitives);
 			}
 			if (it->value.IsString() && key == "name")
 			{
@@ -64,6 +65,19 @@ bool gLTFImportMeshesParser::parseMeshes (rapidjson::Value::ConstMemberIterator
 				mesh.mName = it->value.GetString();
 				OUT << TABx2 << "value ==> " << mesh.mName << "\n";
 			}
+			if (it->value.IsArray() && key == "weights")
+			{
+				// ******** 4. weights (default weights of the morph targets) ********
+				const rapidjson::Value& weightsArray = it->value;
+				for (rapidjson::SizeType j = 0; j < weightsArray.Size(); j++)
+				{
+					if (weightsArray[j].IsNumber())
+					{
+						mesh.mWeights.push_back(weightsArray[j].GetFloat());
+						OUT << TABx2 << "value ==> " << mesh.mWeights.back() << "\n";
+					}
+				}
+			}
 		}
 
 		if (mesh.mName.empty())
@@ -73,7 +87,7 @@ bool gLTFImportMeshesParser::parseMeshes (rapidjson::Value::ConstMemberIterator
 		}
 
 		mesh.mMeshIndex = index;
-		mMeshesMap[index] = mesh;
+		mMeshes.push_back(mesh);
 		++index;
 	}
 
@@ -81,7 +95,8 @@ bool gLTFImportMeshesParser::parseMeshes (rapidjson::Value::ConstMemberIterator
 }
 
 //---------------------------------------------------------------------
-const std::map<int, gLTFMesh> gLTFImportMeshesParser::getParsedMeshes (void) const
+void gLTFImportMeshesParser::takeParsedMeshes (std::vector<gLTFMesh>& meshes)
 {
-	return mMeshesMap;
+	meshes.swap(mMeshes);
+	mMeshes.clear();
 }
\ No newline at end of file
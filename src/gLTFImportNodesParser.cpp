@@ -35,6 +35,7 @@ bool gLTFImportNodesParser::parseNodes (rapidjson::Value::ConstMemberIterator js
 
 	std::string name;
 	int index = 0;
+	mNodes.clear();
 	const rapidjson::Value& array = jsonIterator->value;
 
 	OUT << TAB << "Loop through Nodes array\n";
@@ -145,10 +146,10 @@ bool gLTFImportNodesParser::parseNodes (rapidjson::Value::ConstMemberIterator js
 				const rapidjson::Value& weightsArray = it->value;
 				for (rapidjson::SizeType j = 0; j < weightsArray.Size(); j++)
 				{
-					if (weightsArray[j].IsFloat())
+					if (weightsArray[j].IsNumber())
 					{
 						node.mWeights.push_back(weightsArray[j].GetFloat());
-						OUT << TABx2 << "value ==> " << node.mWeights[j] << "\n";
+						OUT << TABx2 << "value ==> " << node.mWeights.back() << "\n";
 					}
 				}
 			}
@@ -222,10 +223,9 @@ bool gLTFImportNodesParser::parseNodes (rapidjson::Value::ConstMemberIterator js
 			node.mName = name;
 		}
 
-		node.mCalculatedTransformation = matrix;
 		node.mLocalTransformation = matrix;
 		node.mNodeIndex = index;
-		mNodesMap[index] = node;
+		mNodes.push_back(node);
 		++index;
 	}
 
@@ -233,7 +233,8 @@ bool gLTFImportNodesParser::parseNodes (rapidjson::Value::ConstMemberIterator js
 }
 
 //---------------------------------------------------------------------
-const std::map<int, gLTFNode> gLTFImportNodesParser::getParsedNodes(void) const
+void gLTFImportNodesParser::takeParsedNodes(std::vector<gLTFNode>& nodes)
 {
-	return mNodesMap;
+	nodes.swap(mNodes);
+	mNodes.clear();
 }
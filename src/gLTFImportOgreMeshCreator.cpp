@@ -26,6 +26,9 @@
   -----------------------------------------------------------------------------
 */
 
+#include <algorithm>
+#include <set>
+#include <sstream>
 #include "gLTFImportOgreMeshCreator.h"
 #include "rapidjson/document.h"
 #include "OgreVector3.h"
@@ -39,58 +42,52 @@ gLTFImportOgreMeshCreator::gLTFImportOgreMeshCreator (void)
 {
 	mHelperString = "";
 	fileNameBufferHelper = "";
-	mPositionsMap.clear();
-	mNormalsMap.clear();
-	mTangentsMap.clear();
-	mColor_0AccessorMap.clear();
-	mTexcoords_0Map.clear();
-	mTexcoords_1Map.clear();
-	mIndicesMap.clear();
-	mNodesMap.clear();
-	mMeshesMap.clear();
-	mAnimationsMap.clear();
-	mAccessorMap.clear();
+	mStagedSubmesh.clear();
+	mMergeStaticSubmeshes = false;
+	mDrawCallsWithoutMerge = 0;
+	mEdgeListsWritten = false;
+	mDocument = 0;
+	mOptions = 0;
+	mSkinTables.clear();
 }
 
 //---------------------------------------------------------------------
 bool gLTFImportOgreMeshCreator::createOgreMeshFiles (Ogre::HlmsEditorPluginData* data,
-	std::map<int, gLTFNode> nodesMap,
-	std::map<int, gLTFMesh> meshesMap,
-	std::map<int, gLTFAnimation> animationsMap,
-	std::map<int, gLTFSkin> skinsMap,
-	std::map<int, gLTFAccessor> accessorMap,
+	const gLTFDocument& document,
+	const gLTFImportOptions& options,
 	int startBinaryBuffer,
 	bool hasAnimations)
 {
 	OUT << "\nPerform gLTFImportOgreMeshCreator::createOgreMeshFiles\n";
 	OUT << "------------------------------------------------------\n";
 
-	mNodesMap = nodesMap;
-	mMeshesMap = meshesMap;
-	mAnimationsMap = animationsMap;
-	mAccessorMap = accessorMap;
-	mSkinsMap = skinsMap;
-
-	// First get the property value (from the HLMS Editor)
-	std::map<std::string, Ogre::HlmsEditorPluginData::PLUGIN_PROPERTY> properties = data->mInPropertiesMap;
-	std::map<std::string, Ogre::HlmsEditorPluginData::PLUGIN_PROPERTY>::iterator it = properties.find("mesh_is_submesh");
-	if (it != properties.end())
+	mDocument = &document;
+	mOptions = &options;
+	mSkinTables.assign(document.mSkins.size(), SkinTables());
+	mMaxTimeCache.clear();
+	buildSkinTables();
+	buildAnimationNames();
+	buildSkeleton(data, startBinaryBuffer);
+	mReport.clear();
+	writePrunedAttributesToReport();
+
+	// The default way of processing is to create individual meshes
+	bool result;
+	if (mOptions->mMeshIsSubmesh)
 	{
-		// Property found; determine its value
-		if ((it->second).boolValue)
-		{
-			if (isGenerateAnimationProperty(data))
-				createCombinedOgreSkeletonFile(data, startBinaryBuffer, hasAnimations);
-			return createCombinedOgreMeshFile(data, startBinaryBuffer, hasAnimations);
-		}
-		else
-			return createIndividualOgreMeshFiles (data, startBinaryBuffer);
+		if (mOptions->mGenerateAnimation)
+			createCombinedOgreSkeletonFile(data, startBinaryBuffer, hasAnimations);
+		result = createCombinedOgreMeshFile(data, startBinaryBuffer, hasAnimations);
 	}
 	else
-	{
-		// Property not found; the default way of processing is to create individual meshes
-		return createIndividualOgreMeshFiles(data, startBinaryBuffer);
-	}
+		result = createIndividualOgreMeshFiles(data, startBinaryBuffer);
+
+	// Write the import report next to the mesh files
+	std::string reportFileName = data->mInImportPath + data->mInFileDialogBaseName + "/" + data->mInFileDialogBaseName + "_report.txt";
+	mReport.write(reportFileName);
+	OUT << TABx2 << "Written report file " << reportFileName << "\n";
+
+	return result;
 }
 
 //---------------------------------------------------------------------
@@ -105,14 +102,13 @@ bool gLTFImportOgreMeshCreator::createIndividualOgreMeshFiles (Ogre::HlmsEditorP
 	std::ofstream meshFile(mMeshesConfigFileName);
 
 	// Iterate through meshes and create for each mesh an Ogre .xml file
-	std::map<int, gLTFMesh>::iterator it;
-	gLTFMesh mesh;
+	std::vector<gLTFMesh>::const_iterator it;
 	std::string ogreFullyQualifiedMeshXmlFileName;
 	std::string ogreFullyQualifiedMeshMeshFileName;
 	unsigned int meshIndex = 0;
-	for (it = mMeshesMap.begin(); it != mMeshesMap.end(); it++)
+	for (it = mDocument->mMeshes.begin(); it != mDocument->mMeshes.end(); it++)
 	{
-		mesh = it->second;
+		const gLTFMesh& mesh = *it;
 		if (!mesh.mName.empty())
 		{
 			ogreFullyQualifiedMeshXmlFileName = fullyQualifiedImportPath + mesh.mName + ".xml";
@@ -130,9 +126,17 @@ bool gLTFImportOgreMeshCreator::createIndividualOgreMeshFiles (Ogre::HlmsEditorP
 			dst << TAB << "<submeshes>\n";
 
 			gLTFNode dummyNode;
-			writeSubmeshToMesh(dst, dummyNode, mesh, data, startBinaryBuffer); // Do not perform any transformation
+			mSubmeshBounds.clear();
+			mEdgeListBuilder.clear();
+			mPoseBuilder.clear();
+			mMergeStaticSubmeshes = false;
+			mReport.beginSection("Bounds of mesh " + mesh.mName);
+			writeSubmeshToMesh(dst, dummyNode, mesh, data, startBinaryBuffer, Ogre::Matrix4::IDENTITY); // Do not perform any transformation
 
 			dst << TAB << "</submeshes>\n";
+			writeExtremesToMesh(dst);
+			writePosesToMesh(dst, data, startBinaryBuffer);
+			writeEdgeListsToMesh(dst, data, mesh.mName);
 			dst << "</mesh>\n";
 
 			dst.close();
@@ -164,9 +168,8 @@ bool gLTFImportOgreMeshCreator::createCombinedOgreMeshFile (Ogre::HlmsEditorPlug
 	std::string fullyQualifiedImportPath = data->mInImportPath + data->mInFileDialogBaseName + "/";
 
 	// Create one combined Ogre mesh file (.xml)
-	std::map<int, gLTFNode>::iterator it;
-	gLTFNode node;
-	gLTFMesh mesh;
+	std::vector<gLTFNode>::const_iterator it;
+	const gLTFMesh* mesh;
 
 	std::string ogreFullyQualifiedMeshXmlFileName = fullyQualifiedImportPath + data->mInFileDialogBaseName + ".xml";
 	std::string ogreFullyQualifiedMeshMeshFileName = fullyQualifiedImportPath + data->mInFileDialogBaseName + ".mesh";
@@ -179,27 +182,47 @@ bool gLTFImportOgreMeshCreator::createCombinedOgreMeshFile (Ogre::HlmsEditorPlug
 	// Add xml content
 	dst << "<mesh>\n";
 	dst << TAB << "<submeshes>\n";
+	mSubmeshBounds.clear();
+	mEdgeListBuilder.clear();
+	mPoseBuilder.clear();
+	mReport.beginSection("Bounds of mesh " + data->mInFileDialogBaseName);
+	mMergeStaticSubmeshes = mOptions->mMergeStaticSubmeshes;
+	mMergeBatches.clear();
+	mDrawCallsWithoutMerge = 0;
 
 	// Iterate through all nodes and write the geometry data (vertices) of the related meshes
-	for (it = mNodesMap.begin(); it != mNodesMap.end(); it++)
+	for (it = mDocument->mNodes.begin(); it != mDocument->mNodes.end(); it++)
 	{
-		node = it->second;
-		if (node.mMesh > -1)
+		mesh = mDocument->getMeshOfNode(*it);
+		if (mesh)
 		{
-			mesh = node.mMeshDerived;
-			Ogre::Matrix4 matrix = node.mCalculatedTransformation;
 			writeSubmeshToMesh(dst,
-				node,
-				mesh,
+				*it,
+				*mesh,
 				data, 
 				startBinaryBuffer, 
-				matrix,
+				mDocument->getWorldTransformation(*it),
 				hasAnimations);
 		}
 	}
 
+	// Write the remaining merged batches (in order of material)
+	if (mMergeStaticSubmeshes)
+	{
+		std::map<std::string, MergeBatch>::iterator itBatches;
+		for (itBatches = mMergeBatches.begin(); itBatches != mMergeBatches.end(); ++itBatches)
+			writeMergeBatchToMesh(dst, itBatches->second, data);
+		mMergeBatches.clear();
+
+		mReport.beginSection("Draw calls of mesh " + data->mInFileDialogBaseName);
+		mReport.getStream() << "submeshes before merge = " << mDrawCallsWithoutMerge << "\n";
+		mReport.getStream() << "submeshes after merge = " << mSubmeshBounds.size() << "\n";
+		OUT << TABx2 << "Merged " << mDrawCallsWithoutMerge << " submeshes into " << mSubmeshBounds.size() << " submeshes\n";
+	}
+	mMergeStaticSubmeshes = false;
+
 	dst << TAB << "</submeshes>\n";
-	if (hasAnimations && isGenerateAnimationProperty(data))
+	if (hasAnimations && mOptions->mGenerateAnimation)
 	{
 		dst << TAB <<
 			"<skeletonlink name = \"" <<
@@ -207,6 +230,9 @@ bool gLTFImportOgreMeshCreator::createCombinedOgreMeshFile (Ogre::HlmsEditorPlug
 			".skeleton\" />\n";
 	}
 
+	writeExtremesToMesh(dst);
+	writePosesToMesh(dst, data, startBinaryBuffer);
+	writeEdgeListsToMesh(dst, data, data->mInFileDialogBaseName);
 	dst << "</mesh>\n";
 	dst.close();
 	OUT << TABx2 << "Written mesh .xml file " << ogreFullyQualifiedMeshXmlFileName << "\n";
@@ -235,7 +261,7 @@ bool gLTFImportOgreMeshCreator::createCombinedOgreSkeletonFile (Ogre::HlmsEditor
 	std::string fullyQualifiedImportPath = data->mInImportPath + data->mInFileDialogBaseName + "/";
 
 	// Create one combined Ogre mesh file (.xml)
-	std::map<int, gLTFNode>::iterator it;
+	std::vector<gLTFNode>::iterator it;
 	gLTFNode node;
 
 	std::string ogreFullyQualifiedSkeletonXmlFileName = fullyQualifiedImportPath + data->mInFileDialogBaseName + ".skeleton.xml";
@@ -284,135 +310,73 @@ bool gLTFImportOgreMeshCreator::createCombinedOgreSkeletonFile (Ogre::HlmsEditor
 
 //---------------------------------------------------------------------
 bool gLTFImportOgreMeshCreator::writeSubmeshToMesh (std::ofstream& dst,
-	gLTFNode node,
-	gLTFMesh mesh,
+	const gLTFNode& node,
+	const gLTFMesh& mesh,
 	Ogre::HlmsEditorPluginData* data,
 	int startBinaryBuffer,
 	Ogre::Matrix4 matrix,
 	bool hasAnimations)
 {
-	std::map<int, gLTFPrimitive>::iterator itPrimitives;
-	gLTFPrimitive primitive;
+	std::vector<gLTFPrimitive>::const_iterator itPrimitives;
 	std::string materialName;
+	std::string description;
 
 	// Iterate through primitives (each primitive is a submesh)
 	unsigned int primitiveIndex = 0;
-	for (itPrimitives = mesh.mPrimitiveMap.begin(); itPrimitives != mesh.mPrimitiveMap.end(); itPrimitives++)
+	for (itPrimitives = mesh.mPrimitives.begin(); itPrimitives != mesh.mPrimitives.end(); itPrimitives++)
 	{
-		primitive = itPrimitives->second;
+		const gLTFPrimitive& primitive = *itPrimitives;
 		materialName = primitive.mMaterialNameDerived;
 		if (materialName == "")
 			materialName = "BaseWhite";
+		description = "mesh " + mesh.mName + ", primitive " + std::to_string(primitiveIndex);
+
+		/* Read the vertex data and convert the topology into an indexed list (or a non-indexed point list).
+		 * Strips, fans and loops do not reach the mesh file; all submeshes are written as lists.
+		 */
+		mStagedSubmesh.clear();
+		mStagedSubmesh.mMode = primitive.mMode;
+		if (primitive.mPositionAccessorDerived > -1)
+			stageSubmesh(primitive, data, startBinaryBuffer, matrix);
+		stageMorphTargets(node, mesh, primitive, data, startBinaryBuffer, matrix);
 
-		/* Write submesh definition
-		 * Do not share vertices. It is not clear whether gLTF shares geometry data, so use the default 'false' value,
-		 * until proven otherwise.
-		 * We always use 32 bit incices (no 16 bit), even if the gLTF file itself uses 16 bits
+		/* Add bone influences in case there are animations
+		 * Only in case there is an animation, these entries are written, otherwise it does not
+		 * make sense.
 		 */
-		dst << TABx2 << "<submesh material = \"" + materialName + "\"";
-		dst << " usesharedvertices = \"false\" use32bitindexes = \"false\" "; // TODO: Hardcoded?
+		if (hasAnimations && mOptions->mGenerateAnimation)
+			stageBoneInfluences(node, primitive, data, startBinaryBuffer);
 
-		// Write operation type
-		switch (primitive.mMode)
+		// Split very large primitives into spatially coherent chunks; each chunk becomes a submesh
+		unsigned int targetTriangleCount = mOptions->mSplitPrimitiveTriangles;
+		if (targetTriangleCount > 0 && mSpatialSplitter.split(mStagedSubmesh, targetTriangleCount, mThreadPool, mHelperChunks))
 		{
-		case gLTFPrimitive::POINTS:
-			dst << "operationtype = \"point_list\">\n";
-			break;
-		case gLTFPrimitive::LINES:
-			dst << "operationtype = \"line_list\">\n";
-			break;
-		case gLTFPrimitive::LINE_LOOP:
-			dst << "operationtype = \"line_list\">\n";
-			break;
-		case gLTFPrimitive::LINE_STRIP:
-			dst << "operationtype = \"triangle_list\">\n";
-			break;
-		case gLTFPrimitive::TRIANGLES:
-			dst << "operationtype = \"triangle_list\">\n";
-			break;
-		case gLTFPrimitive::TRIANGLE_STRIP:
-			dst << "operationtype = \"triangle_strip\">\n";
-			break;
-		case gLTFPrimitive::TRIANGLE_FAN:
-			dst << "operationtype = \"triangle_fan\">\n";
-			break;
+			mReport.getStream() << "primitive " << primitiveIndex << " of mesh " << mesh.mName << 
+				" is split into " << mHelperChunks.size() << " chunks\n";
+			std::vector<gLTFStagedSubmesh>::iterator itChunks;
+			for (itChunks = mHelperChunks.begin(); itChunks != mHelperChunks.end(); ++itChunks)
+			{
+				mStagedSubmesh.swap(*itChunks);
+				writeStagedSubmeshPartitionsToMesh(dst, materialName, description, data, &node, &primitive, startBinaryBuffer);
+			}
+			mDrawCallsWithoutMerge += mHelperChunks.size();
+			mHelperChunks.clear();
 		}
-
-		// Write faces
-		if (primitive.mIndicesAccessor > -1)
+		else if (mMergeStaticSubmeshes && 
+			primitive.mJoints_0AccessorDerived < 0 && 
+			!mPoseBuilder.hasStagedTargets() && 
+			mStagedSubmesh.getVertexCount() > 0)
 		{
-			writeFacesToMesh(dst, primitive, data, startBinaryBuffer);
+			// Static submesh; add it to the batch of its material. The batches are written afterwards
+			addStagedSubmeshToMergeBatch(dst, materialName, data);
+			++mDrawCallsWithoutMerge;
 		}
-
-		// Write geometry
-		if (primitive.mPositionAccessorDerived > -1)
+		else
 		{
-			gLTFAccessor  accessor = mAccessorMap[primitive.mPositionAccessorDerived];
-			dst << TABx3 << "<geometry vertexcount=\"" << accessor.mCount << "\">\n";
-
-			// Write vertexbuffer header
-			std::string hasPositionsText = "\"true\""; // Assume there are always positions, right?
-			std::string hasNormalsText = "\"true\"";
-			std::string hasTangentsText = "\"true\"";
-			std::string numTextCoordsText = "\"0\"";
-			if (primitive.mNormalAccessorDerived < 0)
-				hasNormalsText = "\"false\"";
-			if (primitive.mTangentAccessorDerived < 0 || isGenerateTangentsProperty(data))
-				hasTangentsText = "\"false\"";
-			if (primitive.mTexcoord_0AccessorDerived > -1)
-				numTextCoordsText = "\"1\"";
-			if (primitive.mTexcoord_0AccessorDerived > -1 && primitive.mTexcoord_1AccessorDerived > -1)
-				numTextCoordsText = "\"2\"";
-
-			dst << TABx4 << "<vertexbuffer positions = " << hasPositionsText <<
-				" normals = " << hasNormalsText;
-
-			// Colours
-			if (primitive.mColor_0AccessorDerived > -1)
-				dst << " colours_diffuse = \"true\"";
-
-			// Texture coordinate dimensions (assume float2 for now)
-			if (primitive.mTexcoord_0AccessorDerived > -1)
-				dst << " texture_coord_dimensions_0 = \"float2\"";
-			if (primitive.mTexcoord_0AccessorDerived > -1 && primitive.mTexcoord_1AccessorDerived > -1)
-				dst << " texture_coord_dimensions_1 = \"float2\"";
-
-			// Tangents
-			dst << " tangents = " << hasTangentsText;
-			if (primitive.mTangentAccessorDerived > -1 && !isGenerateTangentsProperty(data))
-				" tangent_dimensions = \"4\"";
-
-			// Texcoords
-			dst << " texture_coords = " << numTextCoordsText <<
-				">\n";
-
-			// Write vertices
-			writeVerticesToMesh(dst,
-				primitive, 
-				data, 
-				startBinaryBuffer, 
-				matrix);
-
-			// Closing tags
-			dst << TABx4 << "</vertexbuffer>\n";
-			dst << TABx3 << "</geometry>\n";
-
-			/* Add none assignment in case there are animations
-			 * Only in case there is an animation, these entries are written, otherwise it does not
-			 * make sense.
-			 */
-			if (hasAnimations && isGenerateAnimationProperty(data))
-			{
-				dst << TABx3 << "<boneassignments>\n";
-
-				// Write bone assignments
-				writeBoneAssignmentsToMesh(dst, node, primitive, data, startBinaryBuffer);
-
-				dst << TABx3 << "</boneassignments>\n";
-			}
+			writeStagedSubmeshPartitionsToMesh(dst, materialName, description, data, &node, &primitive, startBinaryBuffer);
+			++mDrawCallsWithoutMerge;
 		}
 
-		dst << TABx2 << "</submesh>\n";
 		++primitiveIndex;
 	}
 
@@ -420,111 +384,499 @@ bool gLTFImportOgreMeshCreator::writeSubmeshToMesh (std::ofstream& dst,
 }
 
 //---------------------------------------------------------------------
-bool gLTFImportOgreMeshCreator::writeFacesToMesh(std::ofstream& dst,
-	const gLTFPrimitive& primitive,
+bool gLTFImportOgreMeshCreator::writeStagedSubmeshPartitionsToMesh (std::ofstream& dst,
+	const std::string& materialName,
+	const std::string& description,
 	Ogre::HlmsEditorPluginData* data,
+	const gLTFNode* node,
+	const gLTFPrimitive* primitive,
 	int startBinaryBuffer)
 {
-	gLTFAccessor  indicesAccessor = mAccessorMap[primitive.mIndicesAccessor];
-	if (indicesAccessor.mCount == 0)
-		return false;
+	/* GPU skinning uses a limited number of bones per draw call. A skinned submesh that references more bones is
+	 * split into partitions that each reference at most maxBones bones. Ogre maps the bones of each submesh to a 
+	 * compact palette when the mesh is loaded; the palettes are added to the report.
+	 */
+	unsigned int maxBones = mOptions->mMaxBonesPerSubmesh;
+	if (maxBones == 0 || !mBonePartitioner.partition(mStagedSubmesh, maxBones, mThreadPool, mHelperPartitions))
+		return writeStagedSubmeshToMesh(dst, materialName, description, data, node, primitive, startBinaryBuffer);
+
+	mReport.getStream() << description << " is split into " << mHelperPartitions.size() << 
+		" partitions of at most " << maxBones << " bones\n";
+	if (mBonePartitioner.getOversizedTriangleCount() > 0)
+		mReport.getStream() << "warning: " << mBonePartitioner.getOversizedTriangleCount() << 
+			" triangles reference more than " << maxBones << " bones\n";
+
+	unsigned int partitionIndex = 0;
+	std::vector<gLTFStagedSubmesh>::iterator itPartitions;
+	for (itPartitions = mHelperPartitions.begin(); itPartitions != mHelperPartitions.end(); ++itPartitions, ++partitionIndex)
+	{
+		// Palette index -> bone id
+		mReport.getStream() << "partition " << partitionIndex << " bone palette =";
+		std::vector<unsigned int>::const_iterator itBones;
+		for (itBones = itPartitions->mBonePalette.begin(); itBones != itPartitions->mBonePalette.end(); ++itBones)
+			mReport.getStream() << " " << *itBones;
+		mReport.getStream() << "\n";
+
+		mStagedSubmesh.swap(*itPartitions);
+		writeStagedSubmeshToMesh(dst, materialName, description, data, node, primitive, startBinaryBuffer);
+	}
+	mDrawCallsWithoutMerge += mHelperPartitions.size() - 1;
+	mHelperPartitions.clear();
 
-	// Read indices
-	readIndicesFromUriOrFile (primitive, data, startBinaryBuffer);
+	return true;
+}
 
-	// Write indices
-	dst << TABx3 << "<faces count = \"" << indicesAccessor.mCount / 3 << "\">\n";
-	
-	for (int i = 0; i < indicesAccessor.mCount; i+=3)
-	{
-		dst << TABx4 << "<face v1 = \"" << mIndicesMap[i + 0] <<
-			"\" v2 = \"" << mIndicesMap[i + 1] <<
-			"\" v3 = \"" << mIndicesMap[i + 2] << "\" />\n";
-
-		// For anticlockwise, swap around indices; convert ccw to cw for front face
-		/*
-		dst << TABx4 << "<face v1 = \"" << mIndicesMap[i] <<
-			"\" v2 = \"" << mIndicesMap[i + 2] <<
-			"\" v3 = \"" << mIndicesMap[i + 1] << "\" />\n";
-		*/
+//---------------------------------------------------------------------
+bool gLTFImportOgreMeshCreator::writeStagedSubmeshToMesh (std::ofstream& dst,
+	const std::string& materialName,
+	const std::string& description,
+	Ogre::HlmsEditorPluginData* data,
+	const gLTFNode* node,
+	const gLTFPrimitive* primitive,
+	int startBinaryBuffer)
+{
+	/* Write submesh definition
+	 * Do not share vertices. It is not clear whether gLTF shares geometry data, so use the default 'false' value,
+	 * until proven otherwise.
+	 * 16 bit indices are used, unless the submesh has too many vertices
+	 */
+	dst << TABx2 << "<submesh material = \"" + materialName + "\"";
+	dst << " usesharedvertices = \"false\" use32bitindexes = \"" <<
+		(mStagedSubmesh.needs32BitIndices() ? "true" : "false") <<
+		"\" ";
+
+	// Write operation type
+	switch (mStagedSubmesh.mMode)
+	{
+	case gLTFPrimitive::POINTS:
+		dst << "operationtype = \"point_list\">\n";
+		break;
+	case gLTFPrimitive::LINES:
+		dst << "operationtype = \"line_list\">\n";
+		break;
+	default:
+		dst << "operationtype = \"triangle_list\">\n";
+		break;
 	}
 
-	// Closing tag
-	dst << TABx3 << "</faces>\n";
+	// Write faces
+	if (mStagedSubmesh.mHasIndices)
+	{
+		writeFacesToMesh(dst);
+	}
+
+	// Write geometry
+	if (mStagedSubmesh.getVertexCount() > 0)
+	{
+		dst << TABx3 << "<geometry vertexcount=\"" << mStagedSubmesh.getVertexCount() << "\">\n";
+
+		// Write vertexbuffer header; the attributes are derived from the staged data (which may be a merged batch)
+		bool hasTexcoords_0 = !mStagedSubmesh.mTexcoords_0.empty();
+		bool hasTexcoords_1 = hasTexcoords_0 && !mStagedSubmesh.mTexcoords_1.empty();
+		bool hasTangents = !mStagedSubmesh.mTangentsX.empty() && !mOptions->mGenerateTangents;
+		std::string hasPositionsText = "\"true\""; // Assume there are always positions, right?
+		std::string hasNormalsText = "\"true\"";
+		std::string hasTangentsText = "\"true\"";
+		std::string numTextCoordsText = "\"0\"";
+		if (mStagedSubmesh.mNormalsX.empty())
+			hasNormalsText = "\"false\"";
+		if (!hasTangents)
+			hasTangentsText = "\"false\"";
+		if (hasTexcoords_0)
+			numTextCoordsText = "\"1\"";
+		if (hasTexcoords_1)
+			numTextCoordsText = "\"2\"";
+
+		std::ostringstream attributesText;
+		attributesText << " normals = " << hasNormalsText;
+
+		// Colours
+		if (!mStagedSubmesh.mColours.empty())
+			attributesText << " colours_diffuse = \"true\"";
+
+		// Texture coordinate dimensions (assume float2 for now)
+		if (hasTexcoords_0)
+			attributesText << " texture_coord_dimensions_0 = \"float2\"";
+		if (hasTexcoords_1)
+			attributesText << " texture_coord_dimensions_1 = \"float2\"";
+
+		// Tangents
+		attributesText << " tangents = " << hasTangentsText;
+		if (hasTangents)
+			attributesText << " tangent_dimensions = \"4\"";
+
+		// Texcoords
+		attributesText << " texture_coords = " << numTextCoordsText;
+
+		if (useSeparatePositionBuffer())
+		{
+			/* The positions are written to the first vertex buffer (source 0) and all other attributes to
+			 * the second vertex buffer (source 1), so depth and shadow passes only fetch the positions.
+			 */
+			dst << TABx4 << "<vertexbuffer positions = " << hasPositionsText << ">\n";
+			writeVerticesToMesh(dst, data, true, false);
+			dst << TABx4 << "</vertexbuffer>\n";
+			dst << TABx4 << "<vertexbuffer positions = \"false\"" << attributesText.str() << ">\n";
+			writeVerticesToMesh(dst, data, false, true);
+			dst << TABx4 << "</vertexbuffer>\n";
+		}
+		else
+		{
+			dst << TABx4 << "<vertexbuffer positions = " << hasPositionsText << attributesText.str() << ">\n";
+			writeVerticesToMesh(dst, data);
+			dst << TABx4 << "</vertexbuffer>\n";
+		}
+
+		// Closing tag
+		dst << TABx3 << "</geometry>\n";
+
+		/* Write the bone assignments; the bone influences are only staged in case there are animations.
+		 * Merged batches are static and do not have a primitive.
+		 */
+		if (primitive && node && !mStagedSubmesh.mBoneInfluences.empty())
+		{
+			dst << TABx3 << "<boneassignments>\n";
+
+			// Write bone assignments
+			writeBoneAssignmentsToMesh(dst);
+
+			dst << TABx3 << "</boneassignments>\n";
+		}
+	}
+
+	dst << TABx2 << "</submesh>\n";
+
+	// Poses and the edge list refer to the index of the submesh; this is the number of submeshes written before
+	unsigned int submeshIndex = static_cast<unsigned int>(mSubmeshBounds.size());
+	if (primitive && mPoseBuilder.hasStagedTargets())
+		mPoseBuilder.addPoses(mStagedSubmesh, submeshIndex);
+
+	// Keep the bounds; they are written as submesh extremes and added to the report
+	writeBoundsToReport(description);
+	mSubmeshBounds.push_back(mStagedSubmesh.mBounds);
+
+	// Keep the positions and indices for the edge list
+	if (mOptions->mGenerateEdgeLists)
+		mEdgeListBuilder.addSubmesh(mStagedSubmesh, submeshIndex);
 
 	return true;
 }
 
 //---------------------------------------------------------------------
-bool gLTFImportOgreMeshCreator::writeVerticesToMesh(std::ofstream& dst,
-	const gLTFPrimitive& primitive,
+bool gLTFImportOgreMeshCreator::stageSubmesh (const gLTFPrimitive& primitive,
 	Ogre::HlmsEditorPluginData* data,
 	int startBinaryBuffer,
-	Ogre::Matrix4 matrix)
+	const Ogre::Matrix4& matrix)
 {
 	// Read positions, normals, tangents,... etc.
-	readPositionsFromUriOrFile(primitive, 
-		data, 
-		startBinaryBuffer, 
-		matrix); // Read the positions
+	readPositionsFromUriOrFile(primitive, data, startBinaryBuffer); // Read the positions
 	readNormalsFromUriOrFile(primitive, data, startBinaryBuffer); // Read the normals
 	readTangentsFromUriOrFile(primitive, data, startBinaryBuffer); // Read the tangents
 	readColorsFromUriOrFile(primitive, data, startBinaryBuffer); // Read the diffuse colours
 	readTexCoords0FromUriOrFile(primitive, data, startBinaryBuffer); // Read the uv's set 0
 	readTexCoords1FromUriOrFile(primitive, data, startBinaryBuffer); // Read the uv's set 1
+	readIndicesFromUriOrFile(primitive, data, startBinaryBuffer); // Read the indices
 
-	// Write vertices; Assume that count of positions, texcoords, etc. is the same
-	gLTFAccessor  positionAccessor = mAccessorMap[primitive.mPositionAccessorDerived];
-	for (int i = 0; i < positionAccessor.mCount; i++)
+	/* Convert strips, fans and loops into lists and create an index buffer for non-indexed triangles.
+	 * Vertices of skinned primitives are not welded, because their joints and weights are not part of the staged data
+	 */
+	bool weld = primitive.mJoints_0AccessorDerived < 0 && (primitive.mTargets.empty() || !mOptions->mImportMorphTargets);
+	if (!mTopologyConverter.convertToIndexedList(mStagedSubmesh, weld))
+		return false;
+
+	// Transform the (welded) vertices in one batch; an identity matrix is skipped
+	if (matrix != Ogre::Matrix4::IDENTITY)
+		mVertexTransformer.transformSubmesh(mStagedSubmesh, matrix);
+
+	computeBounds(primitive, matrix);
+	return true;
+}
+
+//---------------------------------------------------------------------
+void gLTFImportOgreMeshCreator::computeBounds (const gLTFPrimitive& primitive, const Ogre::Matrix4& matrix)
+{
+	gLTFStagedSubmesh::Bounds& bounds = mStagedSubmesh.mBounds;
+	bounds = gLTFStagedSubmesh::Bounds();
+
+	/* Use the min/max of the position accessor if available (it is required by the gLTF specs, but not all exporters
+	 * write it). This avoids a pass over the vertices. The transformed box may be slightly larger than the box of the 
+	 * transformed vertices, which is ok for culling.
+	 */
+	const gLTFAccessor* positionAccessor = getElementByIndex(mDocument->mAccessors, primitive.mPositionAccessorDerived);
+	if (positionAccessor && positionAccessor->mMinAvailable && positionAccessor->mMaxAvailable)
+	{
+		bounds.min = Ogre::Vector3(positionAccessor->mMinFloat[0], positionAccessor->mMinFloat[1], positionAccessor->mMinFloat[2]);
+		bounds.max = Ogre::Vector3(positionAccessor->mMaxFloat[0], positionAccessor->mMaxFloat[1], positionAccessor->mMaxFloat[2]);
+		if (matrix != Ogre::Matrix4::IDENTITY)
+			mVertexTransformer.transformAabb(bounds.min, bounds.max, matrix);
+		bounds.valid = true;
+		bounds.fromAccessor = true;
+	}
+	else
+	{
+		// Fallback; determine the box from the staged (already transformed) positions
+		unsigned int vertexCount = mStagedSubmesh.getVertexCount();
+		if (vertexCount > 0)
+		{
+			bounds.valid = mVertexTransformer.computeMinMax(&mStagedSubmesh.mPositionsX[0],
+				&mStagedSubmesh.mPositionsY[0],
+				&mStagedSubmesh.mPositionsZ[0],
+				vertexCount,
+				bounds.min,
+				bounds.max);
+		}
+	}
+
+	if (!bounds.valid)
+		return;
+
+	// The sphere encloses the box
+	bounds.center = (bounds.min + bounds.max) * 0.5f;
+	bounds.radius = (bounds.max - bounds.min).length() * 0.5f;
+}
+
+//---------------------------------------------------------------------
+void gLTFImportOgreMeshCreator::addStagedSubmeshToMergeBatch (std::ofstream& dst,
+	const std::string& materialName,
+	Ogre::HlmsEditorPluginData* data)
+{
+	/* Submeshes can only be merged if they have the same material, the same operation type and the same vertex
+	 * layout, so this is the key of a batch.
+	 */
+	std::ostringstream key;
+	key << materialName << "|" << mStagedSubmesh.mMode << "|" << mStagedSubmesh.mHasIndices << "|" <<
+		!mStagedSubmesh.mNormalsX.empty() << !mStagedSubmesh.mTangentsX.empty() << !mStagedSubmesh.mColours.empty() <<
+		!mStagedSubmesh.mTexcoords_0.empty() << !mStagedSubmesh.mTexcoords_1.empty();
+
+	MergeBatch& batch = mMergeBatches[key.str()];
+	batch.materialName = materialName;
+
+	// Write the batch if it would become too large
+	unsigned int maxVertexCount = mOptions->mMergeMaxVertices;
+	if (maxVertexCount > 0 && 
+		batch.primitiveCount > 0 &&
+		batch.submesh.getVertexCount() + mStagedSubmesh.getVertexCount() > maxVertexCount)
+	{
+		writeMergeBatchToMesh(dst, batch, data);
+	}
+
+	if (batch.primitiveCount == 0)
+		batch.submesh.swap(mStagedSubmesh);
+	else
+		batch.submesh.append(mStagedSubmesh);
+	++batch.primitiveCount;
+}
+
+//---------------------------------------------------------------------
+void gLTFImportOgreMeshCreator::writeMergeBatchToMesh (std::ofstream& dst, 
+	MergeBatch& batch, 
+	Ogre::HlmsEditorPluginData* data)
+{
+	if (batch.primitiveCount == 0)
+		return;
+
+	// The batch becomes the staged submesh, so it is written the same way as a regular submesh
+	std::ostringstream description;
+	description << "material " << batch.materialName << ", " << batch.primitiveCount << " merged primitives";
+	mStagedSubmesh.swap(batch.submesh);
+	writeStagedSubmeshToMesh(dst, batch.materialName, description.str(), data);
+	batch.submesh.clear();
+	batch.primitiveCount = 0;
+}
+
+//---------------------------------------------------------------------
+void gLTFImportOgreMeshCreator::writeBoundsToReport (const std::string& description)
+{
+	const gLTFStagedSubmesh::Bounds& bounds = mStagedSubmesh.mBounds;
+	std::ostringstream& report = mReport.getStream();
+	report << "submesh " << mSubmeshBounds.size() << " (" << description << "): ";
+	if (!bounds.valid)
+	{
+		report << "no bounds\n";
+		return;
+	}
+
+	report << "min = (" << bounds.min.x << ", " << bounds.min.y << ", " << bounds.min.z << ") " <<
+		"max = (" << bounds.max.x << ", " << bounds.max.y << ", " << bounds.max.z << ") " <<
+		"center = (" << bounds.center.x << ", " << bounds.center.y << ", " << bounds.center.z << ") " <<
+		"radius = " << bounds.radius <<
+		(bounds.fromAccessor ? " [accessor min/max]" : " [computed]") << "\n";
+}
+
+//---------------------------------------------------------------------
+bool gLTFImportOgreMeshCreator::writeEdgeListsToMesh (std::ofstream& dst, 
+	Ogre::HlmsEditorPluginData* data,
+	const std::string& meshName)
+{
+	mEdgeListsWritten = false;
+	if (!mOptions->mGenerateEdgeLists)
+		return false;
+
+	/* The edge list is built in-process, so the OgreMeshTool does not have to rebuild the adjacency.
+	 * If a triangle list without indices is part of the mesh, the edge list is left to the OgreMeshTool.
+	 */
+	mEdgeListBuilder.build(mThreadPool);
+	mEdgeListsWritten = mEdgeListBuilder.writeToMesh(dst);
+
+	mReport.beginSection("Edge list of mesh " + meshName);
+	if (mEdgeListsWritten)
+	{
+		mReport.getStream() << "edges = " << mEdgeListBuilder.getEdgeCount() << "\n";
+		mReport.getStream() << "degenerate edges = " << mEdgeListBuilder.getDegenerateEdgeCount() << "\n";
+	}
+	else
+		mReport.getStream() << "generated by OgreMeshTool\n";
+
+	mEdgeListBuilder.clear();
+	return mEdgeListsWritten;
+}
+
+//---------------------------------------------------------------------
+bool gLTFImportOgreMeshCreator::writeExtremesToMesh (std::ofstream& dst)
+{
+	/* Ogre uses the extreme points of a submesh to sort transparent submeshes. The corners of the bounding box
+	 * and the center of the bounding sphere are written, so the bounds are available in the mesh without
+	 * processing the vertices again.
+	 */
+	bool hasBounds = false;
+	std::vector<gLTFStagedSubmesh::Bounds>::const_iterator it;
+	for (it = mSubmeshBounds.begin(); it != mSubmeshBounds.end() && !hasBounds; ++it)
+		hasBounds = it->valid;
+	if (!hasBounds)
+		return false;
+
+	dst << TAB << "<extremes>\n";
+	unsigned int submeshIndex = 0;
+	for (it = mSubmeshBounds.begin(); it != mSubmeshBounds.end(); ++it, ++submeshIndex)
+	{
+		if (!it->valid)
+			continue;
+
+		dst << TABx2 << "<submesh_extremes index = \"" << submeshIndex << "\">\n";
+		dst << TABx3 << "<position x=\"" << it->min.x << "\" y=\"" << it->min.y << "\" z=\"" << it->min.z << "\" />\n";
+		dst << TABx3 << "<position x=\"" << it->max.x << "\" y=\"" << it->max.y << "\" z=\"" << it->max.z << "\" />\n";
+		dst << TABx3 << "<position x=\"" << it->center.x << "\" y=\"" << it->center.y << "\" z=\"" << it->center.z << "\" />\n";
+		dst << TABx2 << "</submesh_extremes>\n";
+	}
+	dst << TAB << "</extremes>\n";
+
+	return true;
+}
+
+//---------------------------------------------------------------------
+bool gLTFImportOgreMeshCreator::writeFacesToMesh(std::ofstream& dst)
+{
+	const std::vector<unsigned int>& indices = mStagedSubmesh.mIndices;
+	if (indices.empty())
+		return false;
+
+	// After topology conversion the staged submesh is either a line list or a triangle list
+	if (mStagedSubmesh.mMode == gLTFPrimitive::LINES)
+	{
+		size_t lineCount = indices.size() / 2;
+		dst << TABx3 << "<faces count = \"" << lineCount << "\">\n";
+		for (size_t i = 0; i < lineCount * 2; i += 2)
+		{
+			dst << TABx4 << "<face v1 = \"" << indices[i + 0] <<
+				"\" v2 = \"" << indices[i + 1] << "\" />\n";
+		}
+	}
+	else
+	{
+		size_t triangleCount = indices.size() / 3;
+		dst << TABx3 << "<faces count = \"" << triangleCount << "\">\n";
+		for (size_t i = 0; i < triangleCount * 3; i += 3)
+		{
+			dst << TABx4 << "<face v1 = \"" << indices[i + 0] <<
+				"\" v2 = \"" << indices[i + 1] <<
+				"\" v3 = \"" << indices[i + 2] << "\" />\n";
+
+			// For anticlockwise, swap around indices; convert ccw to cw for front face
+			/*
+			dst << TABx4 << "<face v1 = \"" << indices[i] <<
+				"\" v2 = \"" << indices[i + 2] <<
+				"\" v3 = \"" << indices[i + 1] << "\" />\n";
+			*/
+		}
+	}
+
+	// Closing tag
+	dst << TABx3 << "</faces>\n";
+
+	return true;
+}
+
+//---------------------------------------------------------------------
+bool gLTFImportOgreMeshCreator::writeVerticesToMesh(std::ofstream& dst,
+	Ogre::HlmsEditorPluginData* data,
+	bool writePositions,
+	bool writeOtherAttributes)
+{
+	// Write vertices; the staged attributes all have the same count as the positions
+	unsigned int vertexCount = mStagedSubmesh.getVertexCount();
+	bool writeTangents = !mStagedSubmesh.mTangentsX.empty() && !mOptions->mGenerateTangents;
+	bool writeTexcoords_1 = !mStagedSubmesh.mTexcoords_0.empty() && !mStagedSubmesh.mTexcoords_1.empty();
+	for (unsigned int i = 0; i < vertexCount; i++)
 	{
 		// Open vertex
 		dst << TABx5 << "<vertex>\n";
 		
 		// Position
-		Ogre::Vector3 vec3 = mPositionsMap[i];
-		dst << TABx6 << "<position x=\"" << vec3.x << "\" y=\"" << vec3.y << "\" z=\"" << vec3.z << "\" />\n";
+		if (writePositions)
+		{
+			dst << TABx6 << "<position x=\"" << mStagedSubmesh.mPositionsX[i] << 
+				"\" y=\"" << mStagedSubmesh.mPositionsY[i] << 
+				"\" z=\"" << mStagedSubmesh.mPositionsZ[i] << "\" />\n";
+		}
+
+		// Only the positions are written to this vertex buffer
+		if (!writeOtherAttributes)
+		{
+			dst << TABx5 << "</vertex>\n";
+			continue;
+		}
 
 		// Normal
-		if (mNormalsMap.size() > 0)
+		if (!mStagedSubmesh.mNormalsX.empty())
 		{
-			vec3 = mNormalsMap[i];
-			dst << TABx6 << "<normal x=\"" << vec3.x << "\" y=\"" << vec3.y << "\" z=\"" << vec3.z << "\" />\n";
+			dst << TABx6 << "<normal x=\"" << mStagedSubmesh.mNormalsX[i] << 
+				"\" y=\"" << mStagedSubmesh.mNormalsY[i] << 
+				"\" z=\"" << mStagedSubmesh.mNormalsZ[i] << "\" />\n";
 		}
 
 		// Tangent
-		if (mTangentsMap.size() > 0 && !isGenerateTangentsProperty(data))
+		if (writeTangents)
 		{
-			Ogre::Vector4 vec4 = mTangentsMap[i];
 			// Take value 'a' (= w) into account for handedness
-			dst << TABx6 << "<tangent x=\"" << vec4.x << 
-				"\" y=\"" << vec4.y << 
-				"\" z=\"" << vec4.z << 
-				"\" w=\"" << vec4.w <<
+			dst << TABx6 << "<tangent x=\"" << mStagedSubmesh.mTangentsX[i] << 
+				"\" y=\"" << mStagedSubmesh.mTangentsY[i] << 
+				"\" z=\"" << mStagedSubmesh.mTangentsZ[i] << 
+				"\" w=\"" << mStagedSubmesh.mTangentsW[i] <<
 				"\" />\n";
 		}
 
 		// Diffuse color
-		if (mColor_0AccessorMap.size() > 0)
+		if (!mStagedSubmesh.mColours.empty())
 		{
-			Ogre::Vector4 vec4 = mColor_0AccessorMap[i];
-			dst << TABx6 << "<colour_diffuse value=\"" << vec4.x << " " <<
-				vec4.y << " " <<
-				vec4.z << " " <<
-				vec4.w << "\" />\n";
+			const Ogre::Vector4& colour = mStagedSubmesh.mColours[i];
+			dst << TABx6 << "<colour_diffuse value=\"" << colour.x << " " <<
+				colour.y << " " <<
+				colour.z << " " <<
+				colour.w << "\" />\n";
 		}
 
 		// Texcoord 0
-		if (mTexcoords_0Map.size() > 0)
+		if (!mStagedSubmesh.mTexcoords_0.empty())
 		{
-			Ogre::Vector2 vec2 = mTexcoords_0Map[i];
-			dst << TABx6 << "<texcoord u=\"" << vec2.x << "\" v=\"" << vec2.y << "\" />\n";
+			const Ogre::Vector2& texcoord = mStagedSubmesh.mTexcoords_0[i];
+			dst << TABx6 << "<texcoord u=\"" << texcoord.x << "\" v=\"" << texcoord.y << "\" />\n";
 		}
 
 		// Texcoord 1
-		if (mTexcoords_1Map.size() > 0)
+		if (writeTexcoords_1)
 		{
-			Ogre::Vector2 vec2 = mTexcoords_1Map[i];
-			dst << TABx6 << "<texcoord u=\"" << vec2.x << "\" v=\"" << vec2.y << "\" />\n";
+			const Ogre::Vector2& texcoord = mStagedSubmesh.mTexcoords_1[i];
+			dst << TABx6 << "<texcoord u=\"" << texcoord.x << "\" v=\"" << texcoord.y << "\" />\n";
 		}
 
 		// Close vertex
@@ -535,106 +887,465 @@ bool gLTFImportOgreMeshCreator::writeVerticesToMesh(std::ofstream& dst,
 }
 
 //---------------------------------------------------------------------
-bool gLTFImportOgreMeshCreator::writeBoneAssignmentsToMesh (std::ofstream& dst,
-	gLTFNode node,
+bool gLTFImportOgreMeshCreator::useSeparatePositionBuffer (void)
+{
+	/* Only triangle submeshes are rendered in depth and shadow passes. A separate position buffer is also
+	 * useless if the submesh has no other attributes than positions.
+	 */
+	if (mStagedSubmesh.mMode != gLTFPrimitive::TRIANGLES)
+		return false;
+
+	if (mStagedSubmesh.mNormalsX.empty() &&
+		mStagedSubmesh.mTangentsX.empty() &&
+		mStagedSubmesh.mColours.empty() &&
+		mStagedSubmesh.mTexcoords_0.empty())
+		return false;
+
+	return mOptions->mSeparatePositionBuffer;
+}
+
+//---------------------------------------------------------------------
+bool gLTFImportOgreMeshCreator::readInfluenceSet (int jointAccessorIndex,
+	int weightAccessorIndex,
+	Ogre::HlmsEditorPluginData* data,
+	int startBinaryBuffer,
+	std::vector<float>& joints,
+	std::vector<float>& weights)
+{
+	joints.clear();
+	weights.clear();
+	const gLTFAccessor* pJointAccessor = getElementByIndex(mDocument->mAccessors, jointAccessorIndex);
+	const gLTFAccessor* pWeightAccessor = getElementByIndex(mDocument->mAccessors, weightAccessorIndex);
+	if (!pJointAccessor || !pWeightAccessor)
+		return false;
+
+	// Decode all joints and weights of the accessors at once
+	const gLTFAccessor& jointAccessor = *pJointAccessor;
+	const gLTFAccessor& weightAccessor = *pWeightAccessor;
+	char* jointBuffer = getBufferChunk(jointAccessor.mUriDerived, data, jointAccessor, startBinaryBuffer);
+	char* weightBuffer = getBufferChunk(weightAccessor.mUriDerived, data, weightAccessor, startBinaryBuffer);
+	bool result = mBufferReader.readVec4ArrayFromBuffer(jointBuffer, jointAccessor, joints) &&
+		mBufferReader.readVec4ArrayFromBuffer(weightBuffer, weightAccessor, weights);
+	delete[] weightBuffer;
+	delete[] jointBuffer;
+
+	if (!result)
+	{
+		joints.clear();
+		weights.clear();
+	}
+
+	return result;
+}
+
+//---------------------------------------------------------------------
+bool gLTFImportOgreMeshCreator::stageBoneInfluences (const gLTFNode& node,
 	const gLTFPrimitive& primitive,
 	Ogre::HlmsEditorPluginData* data,
 	int startBinaryBuffer)
 {
-	gLTFAccessor positionAccessor = mAccessorMap[primitive.mPositionAccessorDerived]; // To determine number of vertices
-	gLTFAccessor jointAccessor = mAccessorMap[primitive.mJoints_0AccessorDerived];
-	gLTFAccessor weightAccessor = mAccessorMap[primitive.mWeights_0AccessorDerived];
-	Ogre::Vector4 joint;
-	Ogre::Vector4 weight;
-	unsigned short fCount;
-
-	// Get the buffer
-	char* jointBuffer = getBufferChunk(weightAccessor.mUriDerived, data, jointAccessor, startBinaryBuffer);
-	char* weightBuffer = getBufferChunk(weightAccessor.mUriDerived, data, weightAccessor, startBinaryBuffer);
+	/* The skin is the same for all vertices of the primitive. Note that a gLTF file may contains
+	 * multiple skins. The relation between the joint and the skin may not dissapear
+	 */
+	int skinIndex = findSkinIndexByNodeIndex(node.mNodeIndex);
+	float threshold = mOptions->mBoneWeightThreshold;
+	const SkinTables* skin = getElementByIndex(mSkinTables, skinIndex);
+	float jointCount = skin ? (float)skin->boneIds.size() : 0.0f;
+
+	// A vertex without joints and weights follows the first bone of the skin
+	unsigned int defaultBone = 0;
+	if (skin)
+	{
+		for (size_t j = 0; j < skin->boneIds.size(); ++j)
+		{
+			if (skin->boneIds[j] > -1)
+			{
+				defaultBone = skin->boneIds[j];
+				break;
+			}
+		}
+	}
 
-	// Iterate through all vertices
-	for (int i = 0; i < positionAccessor.mCount; i++)
+	// Decode JOINTS_0/WEIGHTS_0 and (if present) JOINTS_1/WEIGHTS_1
+	readInfluenceSet(primitive.mJoints_0AccessorDerived, primitive.mWeights_0AccessorDerived, data, startBinaryBuffer,
+		mHelperJoints[0], mHelperWeights[0]);
+	readInfluenceSet(primitive.mJoints_1AccessorDerived, primitive.mWeights_1AccessorDerived, data, startBinaryBuffer,
+		mHelperJoints[1], mHelperWeights[1]);
+
+	// Iterate through all vertices; the joints and weights are taken from the gLTF vertex they originate from
+	unsigned int vertexCount = mStagedSubmesh.getVertexCount();
+	mStagedSubmesh.mBoneInfluences.resize(vertexCount);
+	unsigned int sourceIndex;
+	unsigned int candidateBones[8];
+	float candidateWeights[8];
+	size_t candidateCount;
+	size_t prunedCount = 0;
+	for (unsigned int i = 0; i < vertexCount; i++)
 	{
-		joint = Ogre::Vector4(0.0f, 0.0f, 0.0f, 0.0f);
-		weight = Ogre::Vector4(1.0f, 1.0f, 1.0f, 1.0f);
+		sourceIndex = mStagedSubmesh.getSourceVertexIndex(i);
 
-		// Get the joint (= bone). A joint must be a VEC4/UNSIGNED_BYTE/UNSIGNED_SHORT, otherwise it doesn't get read
-		if (jointAccessor.mType == "VEC4" && jointAccessor.mComponentType == gLTFAccessor::UNSIGNED_BYTE)
+		// Collect the influences; influences of the same bone are combined
+		candidateCount = 0;
+		for (size_t set = 0; set < 2; ++set)
 		{
-			// Get the joint
-			joint = mBufferReader.readVec4FromUnsignedByteBuffer(jointBuffer,
-				i,
-				jointAccessor,
-				getCorrectForMinMaxPropertyValue(data));
+			if ((sourceIndex + 1) * 4 > mHelperWeights[set].size())
+				continue;
+
+			const float* joints = &mHelperJoints[set][sourceIndex * 4];
+			const float* weights = &mHelperWeights[set][sourceIndex * 4];
+			for (size_t j = 0; j < 4; ++j)
+			{
+				if (weights[j] <= 0.0f || joints[j] >= jointCount)
+					continue; // No influence or the joint does not exist in the skin
+
+				int boneId = getBoneId(*skin, (unsigned int)joints[j]);
+				if (boneId < 0)
+					continue; // The joint is pruned
+
+				unsigned int bone = (unsigned int)boneId;
+				size_t c = 0;
+				while (c < candidateCount && candidateBones[c] != bone)
+					++c;
+				if (c == candidateCount)
+				{
+					candidateBones[c] = bone;
+					candidateWeights[c] = 0.0f;
+					++candidateCount;
+				}
+				candidateWeights[c] += weights[j];
+			}
 		}
-		else if (jointAccessor.mType == "VEC4" && jointAccessor.mComponentType == gLTFAccessor::UNSIGNED_SHORT)
+
+		// Without joints and weights, the vertex follows the first bone of the skin
+		if (candidateCount == 0)
 		{
-			// Get the joint
-			joint = mBufferReader.readVec4FromUnsignedShortBuffer(jointBuffer,
-				i,
-				jointAccessor,
-				getCorrectForMinMaxPropertyValue(data));
+			candidateBones[0] = defaultBone;
+			candidateWeights[0] = 1.0f;
+			candidateCount = 1;
 		}
 
-		// Get the weight. A weight must be a VEC4/FLOAT/UNSIGNED_BYTE/UNSIGNED_SHORT, otherwise it doesn't get read
-		if (weightAccessor.mType == "VEC4" && weightAccessor.mComponentType == gLTFAccessor::FLOAT)
+		/* Scale the weights to a total of one before the threshold is applied. Normalized UNSIGNED_BYTE and UNSIGNED_SHORT
+		 * weights are read as 0..255 and 0..65535, so the threshold would not cut anything otherwise.
+		 */
+		float total = 0.0f;
+		for (size_t c = 0; c < candidateCount; ++c)
+			total += candidateWeights[c];
+		for (size_t c = 0; c < candidateCount; ++c)
+			candidateWeights[c] /= total;
+
+		// Sort by weight (insertion sort; at most 8 influences)
+		for (size_t c = 1; c < candidateCount; ++c)
 		{
-			// Get the weight
-			weight = mBufferReader.readVec4FromFloatBuffer(weightBuffer,
-				i,
-				weightAccessor,
-				getCorrectForMinMaxPropertyValue(data));
+			for (size_t d = c; d > 0 && candidateWeights[d] > candidateWeights[d - 1]; --d)
+			{
+				std::swap(candidateWeights[d], candidateWeights[d - 1]);
+				std::swap(candidateBones[d], candidateBones[d - 1]);
+			}
 		}
-		else if (weightAccessor.mType == "VEC4" && weightAccessor.mComponentType == gLTFAccessor::UNSIGNED_BYTE)
+
+		// Keep the 4 most important influences above the threshold; the strongest influence is always kept
+		size_t keep = candidateCount < 4 ? candidateCount : 4;
+		while (keep > 1 && candidateWeights[keep - 1] < threshold)
+			--keep;
+		prunedCount += candidateCount - keep;
+
+		// Renormalize, so the weights sum up to one
+		float sum = 0.0f;
+		for (size_t c = 0; c < keep; ++c)
+			sum += candidateWeights[c];
+		gLTFStagedSubmesh::BoneInfluences& influences = mStagedSubmesh.mBoneInfluences[i];
+		for (size_t c = 0; c < 4; ++c)
 		{
-			// Get the weight
-			weight = mBufferReader.readVec4FromUnsignedByteBuffer(weightBuffer,
-				i,
-				weightAccessor,
-				getCorrectForMinMaxPropertyValue(data));
+			influences.bones[c] = c < keep ? candidateBones[c] : 0;
+			influences.weights[c] = c < keep ? candidateWeights[c] / sum : 0.0f;
+		}
+	}
+
+	if (prunedCount > 0)
+		OUT << TABx3 << "Pruned " << prunedCount << " bone influences of " << vertexCount << " vertices\n";
+
+	return true;
+}
+
+//---------------------------------------------------------------------
+bool gLTFImportOgreMeshCreator::writeBoneAssignmentsToMesh (std::ofstream& dst)
+{
+	// Write the staged bone influences; only bones with a weight are written
+	unsigned int vertexCount = (unsigned int)mStagedSubmesh.mBoneInfluences.size();
+	for (unsigned int i = 0; i < vertexCount; i++)
+	{
+		const gLTFStagedSubmesh::BoneInfluences& influences = mStagedSubmesh.mBoneInfluences[i];
+		for (unsigned short fCount = 0; fCount < 4; ++fCount)
+		{
+			if (influences.weights[fCount] > 0.0f)
+			{
+				dst << TABx4 <<
+					"<vertexboneassignment vertexindex=\"" <<
+					i <<
+					"\" boneindex = \"" <<
+					influences.bones[fCount] <<
+					"\" weight=\"" <<
+					influences.weights[fCount] <<
+					"\" />\n";
+			}
 		}
-		else if (weightAccessor.mType == "VEC4" && weightAccessor.mComponentType == gLTFAccessor::UNSIGNED_SHORT)
+	}
+
+	return true;
+}
+
+//---------------------------------------------------------------------
+bool gLTFImportOgreMeshCreator::readMorphTargetAttribute (const std::map<std::string, int>& target,
+	const std::string& attribute,
+	int vertexCount,
+	Ogre::HlmsEditorPluginData* data,
+	int startBinaryBuffer,
+	std::vector<float>& values)
+{
+	values.clear();
+	std::map<std::string, int>::const_iterator it = target.find(attribute);
+	if (it == target.end() || !getElementByIndex(mDocument->mAccessors, it->second))
+		return false;
+
+	// Displacements must be VEC3/Float and have the same count as the positions of the primitive
+	const gLTFAccessor& accessor = mDocument->mAccessors[it->second];
+	if (accessor.mType != "VEC3" || accessor.mCount != vertexCount)
+		return false;
+
+	char* buffer = getBufferChunk(accessor.mUriDerived, data, accessor, startBinaryBuffer);
+	bool result = mBufferReader.readFloatArrayFromBuffer(buffer, accessor, values);
+	delete[] buffer;
+
+	return result;
+}
+
+//---------------------------------------------------------------------
+bool gLTFImportOgreMeshCreator::stageMorphTargets (const gLTFNode& node,
+	const gLTFMesh& mesh,
+	const gLTFPrimitive& primitive,
+	Ogre::HlmsEditorPluginData* data,
+	int startBinaryBuffer,
+	const Ogre::Matrix4& matrix)
+{
+	// Always reset the staged targets, so a primitive without targets does not get the poses of the previous one
+	mPoseBuilder.beginStagedTargets(node.mNodeIndex, mesh.mMeshIndex, mesh.mName);
+	const gLTFAccessor* positionAccessor = getElementByIndex(mDocument->mAccessors, primitive.mPositionAccessorDerived);
+	if (primitive.mTargets.empty() || !positionAccessor || !mOptions->mImportMorphTargets)
+		return false;
+
+	/* Decode the targets one by one and only keep the displaced vertices. A target that cannot be read still gets
+	 * an (empty) entry, because the target index must match the index of the morph weight.
+	 */
+	int vertexCount = positionAccessor->mCount;
+	bool hasPositions;
+	bool hasNormals;
+	std::vector<std::map<std::string, int> >::const_iterator it;
+	for (it = primitive.mTargets.begin(); it != primitive.mTargets.end(); ++it)
+	{
+		hasPositions = readMorphTargetAttribute(*it, "POSITION", vertexCount, data, startBinaryBuffer, mHelperTargetPositions);
+		hasNormals = readMorphTargetAttribute(*it, "NORMAL", vertexCount, data, startBinaryBuffer, mHelperTargetNormals);
+		if (!hasPositions && hasNormals)
+			mHelperTargetPositions.assign(3 * vertexCount, 0.0f);
+
+		if (hasPositions || hasNormals)
+			mPoseBuilder.addStagedTarget(&mHelperTargetPositions[0], hasNormals ? &mHelperTargetNormals[0] : 0, vertexCount);
+		else
+			mPoseBuilder.addStagedTarget(0, 0, 0);
+	}
+	mHelperTargetPositions.clear();
+	mHelperTargetNormals.clear();
+
+	// The displacements are in the space of the staged vertices
+	if (matrix != Ogre::Matrix4::IDENTITY)
+		mPoseBuilder.transformStagedTargets(matrix);
+
+	/* Default weights (of the node, or else of the mesh) are applied to the vertices, unless they are animated; in
+	 * that case the pose animation drives them
+	 */
+	const std::vector<float>& weights = node.mWeights.empty() ? mesh.mWeights : node.mWeights;
+	if (!weights.empty() && !isMorphWeightsAnimated(node.mNodeIndex, mesh.mMeshIndex))
+	{
+		mPoseBuilder.applyStagedTargets(mStagedSubmesh, weights);
+
+		// The min/max of the position accessor does not include the displacements
+		gLTFStagedSubmesh::Bounds& bounds = mStagedSubmesh.mBounds;
+		unsigned int count = mStagedSubmesh.getVertexCount();
+		if (count > 0 && mVertexTransformer.computeMinMax(&mStagedSubmesh.mPositionsX[0],
+			&mStagedSubmesh.mPositionsY[0],
+			&mStagedSubmesh.mPositionsZ[0],
+			count,
+			bounds.min,
+			bounds.max))
 		{
-			// Get the weight
-			weight = mBufferReader.readVec4FromUnsignedShortBuffer(weightBuffer,
-				i,
-				weightAccessor,
-				getCorrectForMinMaxPropertyValue(data));
+			bounds.valid = true;
+			bounds.fromAccessor = false;
+			bounds.center = (bounds.min + bounds.max) * 0.5f;
+			bounds.radius = (bounds.max - bounds.min).length() * 0.5f;
 		}
+	}
+
+	return true;
+}
+
+//---------------------------------------------------------------------
+bool gLTFImportOgreMeshCreator::isMorphWeightsAnimated (int nodeIndex, int meshIndex)
+{
+	/* If all meshes are combined, the channel must target the node itself. If each mesh gets its own file (nodeIndex
+	 * is -1), any node that refers to the mesh counts.
+	 */
+	if (nodeIndex > -1)
+	{
+		const gLTFNode* node = getElementByIndex(mDocument->mNodes, nodeIndex);
+		return node && isMorphWeightsAnimated(*node);
+	}
+
+	std::vector<gLTFNode>::const_iterator itNode;
+	for (itNode = mDocument->mNodes.begin(); itNode != mDocument->mNodes.end(); ++itNode)
+	{
+		if (itNode->mMesh == meshIndex && isMorphWeightsAnimated(*itNode))
+			return true;
+	}
+
+	return false;
+}
+
+//---------------------------------------------------------------------
+bool gLTFImportOgreMeshCreator::isMorphWeightsAnimated (const gLTFNode& node)
+{
+	std::vector<gLTFAnimationChannelHandle>::const_iterator itHandles;
+	const gLTFAnimationChannel* channel;
+	const std::vector<gLTFAnimationChannelHandle>& handles = node.mAnimationChannelsDerived;
+	for (itHandles = handles.begin(); itHandles != handles.end(); ++itHandles)
+	{
+		channel = getAnimationChannel(*itHandles);
+		if (channel && channel->mTargetPath == "weights")
+			return true;
+	}
+
+	return false;
+}
+
+//---------------------------------------------------------------------
+bool gLTFImportOgreMeshCreator::writePosesToMesh (std::ofstream& dst,
+	Ogre::HlmsEditorPluginData* data,
+	int startBinaryBuffer)
+{
+	if (!mPoseBuilder.writePosesToMesh(dst))
+		return false;
+
+	const std::vector<gLTFImportPoseBuilder::Pose>& poses = mPoseBuilder.getPoses();
+	mReport.beginSection("Poses of mesh");
+	size_t offsets = 0;
+	std::vector<gLTFImportPoseBuilder::Pose>::const_iterator itPoses;
+	for (itPoses = poses.begin(); itPoses != poses.end(); ++itPoses)
+		offsets += itPoses->vertices.size();
+	mReport.getStream() << "poses = " << poses.size() << "\n";
+	mReport.getStream() << "pose offsets = " << offsets << "\n";
+	if (!mOptions->mGenerateAnimation)
+		return true;
+
+	/* Each gLTF animation with 'weights' channels becomes a pose animation with one track per submesh. A keyframe 
+	 * refers to the poses of the submesh with the morph weights as influence; zero weights are not written.
+	 */
+	bool animationsWritten = false;
+	std::vector<gLTFAnimation>::const_iterator itAnimations;
+	std::vector<gLTFAnimationChannel>::const_iterator itChannels;
+	const gLTFNode* targetNode;
+	std::vector<float> times;
+	std::vector<float> values;
+	std::set<unsigned int> submeshesWithTrack;
+	unsigned int animationIndex = 0;
+	for (itAnimations = mDocument->mAnimations.begin(); itAnimations != mDocument->mAnimations.end(); ++itAnimations, ++animationIndex)
+	{
+		std::ostringstream tracks;
+		float length = 0.0f;
+		submeshesWithTrack.clear();
+		const std::vector<gLTFAnimationChannel>& channels = itAnimations->mAnimationChannels;
+		for (itChannels = channels.begin(); itChannels != channels.end(); ++itChannels)
+		{
+			const gLTFAnimationChannel& channel = *itChannels;
+			targetNode = getElementByIndex(mDocument->mNodes, channel.mTargetNode);
+			if (channel.mTargetPath != "weights" || !targetNode)
+				continue;
+			if (!getElementByIndex(mDocument->mAccessors, channel.mInputDerived) ||
+				!getElementByIndex(mDocument->mAccessors, channel.mOutputDerived))
+				continue;
+
+			// Decode the key times and the weights (a CUBICSPLINE key has an in-tangent, a value and an out-tangent)
+			const gLTFAccessor& inputAccessor = mDocument->mAccessors[channel.mInputDerived];
+			const gLTFAccessor& outputAccessor = mDocument->mAccessors[channel.mOutputDerived];
+			char* buffer = getBufferChunk(inputAccessor.mUriDerived, data, inputAccessor, startBinaryBuffer);
+			bool result = mBufferReader.readFloatArrayFromBuffer(buffer, inputAccessor, times);
+			delete[] buffer;
+			buffer = getBufferChunk(outputAccessor.mUriDerived, data, outputAccessor, startBinaryBuffer);
+			result = mBufferReader.readFloatArrayFromBuffer(buffer, outputAccessor, values) && result;
+			delete[] buffer;
+			if (!result || times.empty())
+				continue;
+
+			size_t keyCount = times.size();
+			bool cubic = channel.mInterpolationDerived == "CUBICSPLINE";
+			size_t elementsPerKey = cubic ? 3 : 1;
+			size_t targetCount = values.size() / (keyCount * elementsPerKey);
+			if (targetCount == 0)
+				continue;
+
+			// The poses of one submesh are contiguous; write a track per submesh of the target node (or mesh)
+			size_t poseIndex = 0;
+			while (poseIndex < poses.size())
+			{
+				const gLTFImportPoseBuilder::Pose& first = poses[poseIndex];
+				size_t poseEnd = poseIndex + 1;
+				while (poseEnd < poses.size() && poses[poseEnd].submeshIndex == first.submeshIndex)
+					++poseEnd;
+
+				bool isTarget = first.nodeIndex > -1 ? first.nodeIndex == channel.mTargetNode : first.meshIndex == targetNode->mMesh;
+				if (isTarget && submeshesWithTrack.insert(first.submeshIndex).second)
+				{
+					tracks << TABx3 << "<track target=\"submesh\" index=\"" << first.submeshIndex << "\" type=\"pose\">\n";
+					tracks << TABx4 << "<keyframes>\n";
+					for (size_t key = 0; key < keyCount; ++key)
+					{
+						const float* keyWeights = &values[(key * elementsPerKey + (cubic ? 1 : 0)) * targetCount];
+						tracks << TABx5 << "<keyframe time=\"" << times[key] << "\">\n";
+						for (size_t pose = poseIndex; pose < poseEnd; ++pose)
+						{
+							if (poses[pose].targetIndex < targetCount && keyWeights[poses[pose].targetIndex] != 0.0f)
+							{
+								tracks << TABx6 << "<poseref poseindex=\"" << pose << 
+									"\" influence=\"" << keyWeights[poses[pose].targetIndex] << "\" />\n";
+							}
+						}
+						tracks << TABx5 << "</keyframe>\n";
+					}
+					tracks << TABx4 << "</keyframes>\n";
+					tracks << TABx3 << "</track>\n";
+					length = std::max(length, getMaxTimeOfKeyframes(&channel, data, startBinaryBuffer));
+				}
 
-		// Write the xml entry. A vertex can be influenced by max. 4 bones/joints. Note that a gLTF file may contains
-		// multiple skins. The relation between the joint and the skin may not dissapear
-		unsigned int joints[4];
-		float weights[4];
-		joints[0] = getBoneId(joint.x, findSkinIndexByNodeIndex(node.mNodeIndex));
-		joints[1] = getBoneId(joint.y, findSkinIndexByNodeIndex(node.mNodeIndex));
-		joints[2] = getBoneId(joint.z, findSkinIndexByNodeIndex(node.mNodeIndex));
-		joints[3] = getBoneId(joint.w, findSkinIndexByNodeIndex(node.mNodeIndex));
-		weights[0] = weight.x;
-		weights[1] = weight.y;
-		weights[2] = weight.z;
-		weights[3] = weight.w;
-		fCount = 0;
-		while (fCount < 4)
-		{
-			//weights[fCount] = weights[fCount] < 0.00000001f ? 1.0f : weights[fCount];
-			if (weights[fCount] > 0.0f)
-			{
-				dst << TABx4 <<
-					"<vertexboneassignment vertexindex=\"" <<
-					i <<
-					"\" boneindex = \"" <<
-					joints[fCount] <<
-					"\" weight=\"" <<
-					weights[fCount] <<
-					"\" />\n";
+				poseIndex = poseEnd;
 			}
-			++fCount;
 		}
+
+		if (submeshesWithTrack.empty())
+			continue;
+
+		if (!animationsWritten)
+			dst << TAB << "<animations>\n";
+		animationsWritten = true;
+
+		const std::string& name = mAnimationNames[animationIndex];
+		dst << TABx2 << "<animation name=\"" << name << "\" length=\"" << length << "\">\n";
+		dst << TABx3 << "<tracks>\n";
+		dst << tracks.str();
+		dst << TABx3 << "</tracks>\n";
+		dst << TABx2 << "</animation>\n";
+		mReport.getStream() << "pose animation " << name << " has " << submeshesWithTrack.size() << " tracks\n";
 	}
 
-	delete[] weightBuffer;
-	delete[] jointBuffer;
+	if (animationsWritten)
+		dst << TAB << "</animations>\n";
+
 	return true;
 }
 
@@ -645,94 +1356,61 @@ bool gLTFImportOgreMeshCreator::writeBonesToSkeleton (std::ofstream& dst,
 {
 	OUT << TABx3 << "Perform gLTFImportOgreMeshCreator::writeBonesToSkeleton\n";
 
-	/* Each bone is a joint in the skin object, A joint refers to a node.
-	 * Iterate through the joints and get the node.
+	/* Each bone is a joint in the skin object, A joint refers to a node. Joints of different skins that refer
+	 * to the same node are one bone (see buildSkeleton); the bind poses of all bones are decomposed at once.
 	 */
-	std::map<int, gLTFSkin>::iterator itSkin;
-	std::map<int, gLTFSkin>::iterator itSkinEnd = mSkinsMap.end();
-	std::map<int, gLTFNode>::iterator itNode;
-	std::map<int, gLTFNode>::iterator itNodeEnd;
-	gLTFSkin skin;
-	gLTFNode node;
-
-	// Iterate through all skins, get the nodes that correspond to the joints
-	unsigned int skinIndex = 0;
-	unsigned int jointIndex = 0;
-	for (itSkin = mSkinsMap.begin(); itSkin != itSkinEnd; itSkin++)
+	Ogre::Vector3 axis;
+	Ogre::Radian angle;
+	unsigned int boneId;
+	for (boneId = 0; boneId < mSkeletonBones.size(); ++boneId)
 	{
-		skin = itSkin->second;
-		itNodeEnd = skin.mNodesDerived.end();
-		jointIndex = 0;
-		for (itNode = skin.mNodesDerived.begin(); itNode != itNodeEnd; itNode++)
-		{
-			node = itNode->second;
-			dst << TABx2 <<
-				"<bone id=\"" <<
-				getBoneId(jointIndex, skinIndex) <<
-				"\" name=\"" <<
-				getBoneName(jointIndex, skinIndex) <<
-				"\">\n";
-
-			Ogre::Matrix4 matrix4;
-			Ogre::Vector3 position;
-			Ogre::Quaternion orientation;
-			Ogre::Vector3 axis;
-			Ogre::Radian angle;
-			Ogre::Vector3 scale;
-			
-			/* Determine the bone pose matrix.
-			 * TODO: What is the math??? The line below isn'y correct, but it is unclear what it must be!!!
-			 */
-			//matrix4 = node.mLocalTransformation * getInverseBindMatrix(skin.mInverseBindMatrices, jointIndex, data, startBinaryBuffer);
-			//matrix4 = node.mLocalTransformation * mNodesMap[skin.mSkeleton].mLocalTransformation.inverse();
-			//matrix4 = getInverseBindMatrix(skin.mInverseBindMatrices, jointIndex, data, startBinaryBuffer);
-			matrix4 = node.mLocalTransformation;
-			//TODO TODO TODO TODO TODO TODO TODO TODO TODO TODO TODO TODO TODO TODO TODO TODO TODO TODO TODO TODO TODO 
-
-			matrix4.decomposition(position, scale, orientation);
-
-			// Position
-			dst << TABx3 << "<position x= \"" <<
-				position.x <<
-				"\" y=\"" <<
-				position.y <<
-				"\" z=\"" <<
-				position.z <<
-				"\" />\n";
-
-			// Orientation
-			orientation.normalise();
-			//orientation = Ogre::Quaternion(orientation.x, orientation.z, orientation.y, orientation.w); // TEST
-			//orientation = orientation * Ogre::Quaternion(Ogre::Degree(180), Ogre::Vector3::UNIT_Z);
-			//orientation = orientation * Ogre::Quaternion(Ogre::Degree(90), Ogre::Vector3::UNIT_X);
-			//orientation = orientation * Ogre::Quaternion(Ogre::Degree(-90), Ogre::Vector3::UNIT_Y);
-			orientation.ToAngleAxis(angle, axis);
-			dst << TABx3 << "<rotation angle=\"" <<
-				angle.valueRadians() <<
-				"\">\n";
-			dst << TABx4 << "<axis x= \"" <<
-				axis.x <<
-				"\" y=\"" <<
-				axis.y <<
-				"\" z=\"" <<
-				axis.z <<
-				"\" />\n";
-			dst << TABx3 << "</rotation>\n";
-
-			// Scale
-			dst << TABx3 << "<scale x= \"" <<
-				scale.x <<
-				"\" y=\"" <<
-				scale.y <<
-				"\" z=\"" <<
-				scale.z <<
-				"\" />\n";
+		const Ogre::Vector3& position = mBindPoses[boneId].position;
+		const Ogre::Quaternion& orientation = mBindPoses[boneId].orientation;
+		const Ogre::Vector3& scale = mBindPoses[boneId].scale;
+		dst << TABx2 <<
+			"<bone id=\"" <<
+			boneId <<
+			"\" name=\"" <<
+			mSkeletonBones[boneId].name <<
+			"\">\n";
 
-			dst << TABx2 << "</bone>\n";
-			++jointIndex;
-		}
-		
-		++skinIndex;
+		// Position
+		dst << TABx3 << "<position x= \"" <<
+			position.x <<
+			"\" y=\"" <<
+			position.y <<
+			"\" z=\"" <<
+			position.z <<
+			"\" />\n";
+
+		// Orientation
+		//orientation = Ogre::Quaternion(orientation.x, orientation.z, orientation.y, orientation.w); // TEST
+		//orientation = orientation * Ogre::Quaternion(Ogre::Degree(180), Ogre::Vector3::UNIT_Z);
+		//orientation = orientation * Ogre::Quaternion(Ogre::Degree(90), Ogre::Vector3::UNIT_X);
+		//orientation = orientation * Ogre::Quaternion(Ogre::Degree(-90), Ogre::Vector3::UNIT_Y);
+		orientation.ToAngleAxis(angle, axis);
+		dst << TABx3 << "<rotation angle=\"" <<
+			angle.valueRadians() <<
+			"\">\n";
+		dst << TABx4 << "<axis x= \"" <<
+			axis.x <<
+			"\" y=\"" <<
+			axis.y <<
+			"\" z=\"" <<
+			axis.z <<
+			"\" />\n";
+		dst << TABx3 << "</rotation>\n";
+
+		// Scale
+		dst << TABx3 << "<scale x= \"" <<
+			scale.x <<
+			"\" y=\"" <<
+			scale.y <<
+			"\" z=\"" <<
+			scale.z <<
+			"\" />\n";
+
+		dst << TABx2 << "</bone>\n";
 	}
 
 	return true;
@@ -743,62 +1421,18 @@ bool gLTFImportOgreMeshCreator::writeBoneHierarchyToSkeleton (std::ofstream& dst
 {
 	OUT << TABx3 << "Perform gLTFImportOgreMeshCreator::writeBoneHierarchyToSkeleton\n";
 
-	/* Iterate trough all joints, search its node and determine the parentnode of the node.
-	 * Search the joint index of the parent node.
-	 */
-	std::map<int, gLTFSkin>::iterator itSkin;
-	std::map<int, gLTFSkin>::iterator itSkinEnd = mSkinsMap.end();
-	std::map<int, gLTFNode>::iterator itNode;
-	std::map<int, gLTFNode>::iterator itNodeEnd;
-	std::map<int, gLTFNode>::iterator itNodeParent;
-	std::map<int, gLTFNode>::iterator itNodeParentEnd;
-	gLTFSkin skin;
-	gLTFNode node;
-	gLTFNode* nodeParent;
-
-	// Iterate through all skins, get the nodes that correspond to the joints
-	unsigned int skinIndex = 0;
-	unsigned int jointIndexChild = 0;
-	unsigned int jointIndexParent = 0;
-	std::string boneNameChild;
-	std::string boneNameParent;
-	for (itSkin = mSkinsMap.begin(); itSkin != itSkinEnd; itSkin++)
-	{
-		skin = itSkin->second;
-		itNodeEnd = skin.mNodesDerived.end();
-		for (itNode = skin.mNodesDerived.begin(); itNode != itNodeEnd; itNode++)
-		{
-			node = itNode->second;
-
-			// Determine the parent node and search it back in the node list
-			nodeParent = node.mParentNode;
-			itNodeParentEnd = skin.mNodesDerived.end();
-			jointIndexParent = 0;
-			for (itNodeParent = skin.mNodesDerived.begin(); itNodeParent != itNodeParentEnd; itNodeParent++)
-			{
-				// If node indices are equal, this must be the node
-				if (nodeParent->mNodeIndex == (itNodeParent->second).mNodeIndex)
-					break;
-				++jointIndexParent;
-			}
-			
-			if (jointIndexParent < skin.mNodesDerived.size())
-			{
-				// Use separate strings for the names and do not use getBoneName twice in the stream, because  it
-				// does not return the correct parent bone name
-				boneNameChild = getBoneName(jointIndexChild, skinIndex);
-				boneNameParent = getBoneName(jointIndexParent, skinIndex);
-				dst << TABx2 << "<boneparent bone=\"" <<
-					boneNameChild <<
-					"\" parent=\"" <<
-					boneNameParent <<
-					"\" />\n";
-			}
-
-			++jointIndexChild;
-		}
-
-		++skinIndex;
+	// The parent of each bone is determined by buildSkeleton
+	std::vector<SkeletonBone>::const_iterator itBones;
+	for (itBones = mSkeletonBones.begin(); itBones != mSkeletonBones.end(); ++itBones)
+	{
+		if (itBones->parent < 0)
+			continue;
+
+		dst << TABx2 << "<boneparent bone=\"" <<
+			itBones->name <<
+			"\" parent=\"" <<
+			mSkeletonBones[itBones->parent].name <<
+			"\" />\n";
 	}
 
 	return true;
@@ -813,95 +1447,153 @@ bool gLTFImportOgreMeshCreator::writeAnimationsToSkeleton(std::ofstream& dst,
 
 	dst << TAB << "<animations>\n";
 
+	bool reduceKeyframes = mOptions->mReduceKeyframes;
+	if (reduceKeyframes)
+	{
+		mKeyframeReducer.setTolerances(mOptions->mKeyframePositionTolerance,
+			Ogre::Degree(mOptions->mKeyframeRotationTolerance).valueRadians(),
+			mOptions->mKeyframeScaleTolerance);
+	}
 
-	/* Iterate through all skins and joints (use nodes instead of joints for convenience).
-	 * Assume, that each gLTF skin represents an Ogre3d animation (not sure whether this is true, but it seems
-	 * logical).
+	/* 1. Each gLTF animation becomes a clip with its own name (see buildAnimationNames) and length. The index of a
+	 * clip is the index of its gLTF animation.
 	 */
-	std::map<int, gLTFSkin>::iterator itSkin;
-	std::map<int, gLTFSkin>::iterator itSkinEnd = mSkinsMap.end();
-	std::map<int, gLTFNode>::iterator itNode;
-	std::map<int, gLTFNode>::iterator itNodeEnd;
-	std::map<int, gLTFNode>::iterator itNodeJoint;
-	std::map<int, gLTFAnimation>::iterator itAnimation;
-	gLTFSkin skin;
-	unsigned int skinIndex = 0;
-	unsigned int jointIndex = 0;
-	bool hasTrackAndKeyframesHeader;
-	std::vector<gLTFAnimationChannel> animationChannelsForNode; // All the animation channels in this animation for this node
-	std::map<int, gLTFAnimationChannel>::iterator itAnimationChannel;
-	gLTFNode node;
-	gLTFAnimation animation;
-	gLTFAnimationChannel animationChannel;
+	mAnimationClips.clear();
+	mBoneTracks.clear();
+	size_t animationIndex;
+	for (animationIndex = 0; animationIndex < mDocument->mAnimations.size(); ++animationIndex)
+	{
+		const gLTFAnimation& animation = mDocument->mAnimations[animationIndex];
+		mAnimationClips.push_back(AnimationClip());
+		AnimationClip& clip = mAnimationClips.back();
+		clip.name = mAnimationNames[animationIndex];
+		clip.length = getMaxTimeOfAnimation(animation, data, startBinaryBuffer);
+	}
 
-	for (itSkin = mSkinsMap.begin(); itSkin != itSkinEnd; itSkin++)
+	/* 2. Decode and merge the keyframes of each bone per gLTF animation. The buffers are read on this thread;
+	 * each (bone, gLTF animation) pair becomes a bone track of the clip of that animation. Pruned joints are
+	 * no bones, so they have no tracks.
+	 */
+	const gLTFNode* node;
+	std::vector<gLTFAnimationChannelHandle>::const_iterator itHandles;
+	std::vector<gLTFAnimationChannelHandle>::const_iterator itHandlesNext;
+	unsigned int boneId;
+	for (boneId = 0; boneId < mSkeletonBones.size(); ++boneId)
 	{
-		skin = itSkin->second;
-		dst << TABx2 << "<animation name=\"" <<
-			skin.mName <<
-			"\" length=\"" <<
-			getMaxTimeOfAnimation(skin, data, startBinaryBuffer) <<
-			"\">\n";
-		dst << TABx3 << "<tracks>\n";
+		node = getElementByIndex(mDocument->mNodes, mSkeletonBones[boneId].nodeIndex);
+		if (!node)
+			continue;
 
-		jointIndex = 0;
-		hasTrackAndKeyframesHeader = false;
-		itNodeEnd = skin.mNodesDerived.end();
-		
-		for (itNode = skin.mNodesDerived.begin(); itNode != itNodeEnd; itNode++)
+		// The handles of the node are ordered by animation; each run of handles is one animation
+		const std::vector<gLTFAnimationChannelHandle>& handles = node->mAnimationChannelsDerived;
+		for (itHandles = handles.begin(); itHandles != handles.end(); itHandles = itHandlesNext)
 		{
-			node = itNode->second;
-			hasTrackAndKeyframesHeader = false;
-
-			// Iterate through all gLTF animations
-			for (itAnimation = mAnimationsMap.begin(); itAnimation != mAnimationsMap.end(); itAnimation++)
-			{
-				animation = itAnimation->second;
-				animationChannelsForNode.clear();
+			itHandlesNext = itHandles;
+			while (itHandlesNext != handles.end() && itHandlesNext->mAnimation == itHandles->mAnimation)
+				++itHandlesNext;
+
+			// The channels of the node in this animation are read in place
+			if (!mergeKeyframes(itHandles, itHandlesNext, data, startBinaryBuffer))
+				continue;
+
+			mBoneTracks.push_back(BoneTrack());
+			BoneTrack& boneTrack = mBoneTracks.back();
+			boneTrack.clip = itHandles->mAnimation;
+			boneTrack.boneId = boneId;
+			boneTrack.boneName = &mSkeletonBones[boneId].name;
+			boneTrack.keyframes = mKeyframeMerger.getKeyframes();
+			boneTrack.bindPosition = mBindPoses[boneId].position;
+			boneTrack.bindOrientation = mBindPoses[boneId].orientation;
+			boneTrack.bindScale = mBindPoses[boneId].scale;
+			mAnimationClips[boneTrack.clip].keyframesBefore += boneTrack.keyframes.size();
+		}
+	}
 
-				// Iterate through all animations channels within the animation
-				for (itAnimationChannel = animation.mAnimationChannelsMap.begin();
-					itAnimationChannel != animation.mAnimationChannelsMap.end();
-					itAnimationChannel++)
-				{
-					animationChannel = itAnimationChannel->second;
-					if (animationChannel.mTargetNode == node.mNodeIndex)
-					{
-						if (!hasTrackAndKeyframesHeader)
-						{
-							dst << TABx4 <<
-								"<track bone=\"" <<
-								getBoneName(jointIndex, skinIndex) <<
-								"\">\n";
-							dst << TABx5 <<
-								"<keyframes>\n";
-							hasTrackAndKeyframesHeader = true;
-						}
+	// Group the tracks per clip; within a clip the tracks keep the order of the bones
+	std::stable_sort(mBoneTracks.begin(), mBoneTracks.end(), [](const BoneTrack& a, const BoneTrack& b)
+	{
+		return a.clip < b.clip;
+	});
+	size_t i;
+	for (i = 0; i < mBoneTracks.size(); ++i)
+	{
+		AnimationClip& clip = mAnimationClips[mBoneTracks[i].clip];
+		if (clip.trackCount == 0)
+			clip.firstTrack = i;
+		++clip.trackCount;
+	}
 
-						animationChannelsForNode.push_back(animationChannel);
-					}
-				}
+	// 3. Reduce the keyframes of all tracks in parallel
+	if (reduceKeyframes)
+	{
+		mThreadPool.parallelFor(mBoneTracks.size(), [this](size_t i)
+		{
+			BoneTrack& boneTrack = mBoneTracks[i];
+			boneTrack.constant = mKeyframeReducer.isConstant(boneTrack.keyframes, 
+				boneTrack.bindPosition, 
+				boneTrack.bindOrientation, 
+				boneTrack.bindScale);
+			mKeyframeReducer.reduce(boneTrack.keyframes);
+		});
+	}
 
-				// Now we know which channels refer to this bone. Write the keyframes
-				if (!animationChannelsForNode.empty())
-					writeKeyframesToSkeleton(dst, &animationChannelsForNode, data, startBinaryBuffer);
-					//writeKeyframesToSkeleton(dst, skin, jointIndex, &animationChannelsForNode, data, startBinaryBuffer);
-			}
+	// 4. Encode the clips in parallel. A bone that never leaves its bind pose is skipped
+	mThreadPool.parallelFor(mAnimationClips.size(), [this](size_t c)
+	{
+		AnimationClip& clip = mAnimationClips[c];
+		if (clip.trackCount == 0)
+			return;
 
-			if (hasTrackAndKeyframesHeader)
+		std::ostringstream xml;
+		xml << TABx2 << "<animation name=\"" <<
+			clip.name <<
+			"\" length=\"" <<
+			clip.length <<
+			"\">\n";
+		xml << TABx3 << "<tracks>\n";
+		for (size_t t = clip.firstTrack; t < clip.firstTrack + clip.trackCount; ++t)
+		{
+			const BoneTrack& boneTrack = mBoneTracks[t];
+			if (boneTrack.constant)
 			{
-				dst << TABx5 << "</keyframes>\n";
-				dst << TABx4 << "</track>\n";
+				++clip.removedTracks;
+				continue;
 			}
 
-			++jointIndex;
+			xml << TABx4 <<
+				"<track bone=\"" <<
+				*boneTrack.boneName <<
+				"\">\n";
+			xml << TABx5 <<
+				"<keyframes>\n";
+			writeKeyframesToSkeleton(xml, boneTrack.keyframes);
+			xml << TABx5 << "</keyframes>\n";
+			xml << TABx4 << "</track>\n";
+			clip.keyframesAfter += boneTrack.keyframes.size();
 		}
+		xml << TABx3 << "</tracks>\n";
+		xml << TABx2 << "</animation>\n";
+		clip.xml = xml.str();
+	});
+
+	// 5. Write the clips in the order of the gLTF animations; animations that do not move any bone are left out
+	std::vector<AnimationClip>::const_iterator itClips;
+	for (itClips = mAnimationClips.begin(); itClips != mAnimationClips.end(); ++itClips)
+	{
+		if (itClips->trackCount == 0)
+			continue;
 
-		++skinIndex;
-	
-		dst << TABx3 << "</tracks>\n";
-		dst << TABx2 << "</animation>\n";
+		dst << itClips->xml;
+		if (reduceKeyframes)
+		{
+			mReport.beginSection("Keyframes of skeleton animation " + itClips->name);
+			mReport.getStream() << "keyframes before reduction = " << itClips->keyframesBefore << "\n";
+			mReport.getStream() << "keyframes after reduction = " << itClips->keyframesAfter << "\n";
+			mReport.getStream() << "constant tracks removed = " << itClips->removedTracks << "\n";
+		}
 	}
+	mBoneTracks.clear();
+	mAnimationClips.clear();
 	
 	dst << TAB << "</animations>\n";
 	
@@ -909,224 +1601,146 @@ bool gLTFImportOgreMeshCreator::writeAnimationsToSkeleton(std::ofstream& dst,
 }
 
 //---------------------------------------------------------------------
-float gLTFImportOgreMeshCreator::getMaxTimeOfAnimation (const gLTFSkin& skin,
+float gLTFImportOgreMeshCreator::getMaxTimeOfAnimation (const gLTFAnimation& animation,
 	Ogre::HlmsEditorPluginData* data,
 	int startBinaryBuffer)
 {
 	OUT << TABx4 << "Perform gLTFImportOgreMeshCreator::getMaxTimeOfAnimation\n";
 
+	// The length of an animation is the largest key time of all its channels
 	float maxTime = 0.0f;
-	float time = 0.0f;
-
-	// Iterate through all bones (nodes) within this animation
-	std::map<int, gLTFNode>::iterator itNode;
-	std::map<int, gLTFAnimation>::iterator itAnimation;
-	std::map<int, gLTFAnimationChannel>::iterator itAnimationChannel;
-	gLTFNode node;
-	gLTFAnimation animation;
-	gLTFAnimationChannel animationChannel;
-	unsigned int nodeIndex = 0;
-	for (itNode = mNodesMap.begin(); itNode != mNodesMap.end(); itNode++)
-	{
-		node = itNode->second;
-		if (isNodeAJointInThisSkin(skin, node))
-		{
-			// The node is a joint of this skin. Iterate through all animations
-			for (itAnimation = mAnimationsMap.begin(); itAnimation != mAnimationsMap.end(); itAnimation++)
-			{
-				animation = itAnimation->second;
-
-				// Iterate through all animations channels within the animation
-				for (itAnimationChannel = animation.mAnimationChannelsMap.begin();
-					itAnimationChannel != animation.mAnimationChannelsMap.end();
-					itAnimationChannel++)
-				{
-					animationChannel = itAnimationChannel->second;
-					if (animationChannel.mTargetNode == nodeIndex)
-					{
-						// The node (bone) is defined in this channel
-						time = getMaxTimeOfKeyframes(&animationChannel, data, startBinaryBuffer);
-						maxTime = std::max(time, maxTime);
-					}
-				}
-			}
-		}
-
-		++nodeIndex;
-
-	}
+	std::vector<gLTFAnimationChannel>::const_iterator itChannels;
+	for (itChannels = animation.mAnimationChannels.begin(); itChannels != animation.mAnimationChannels.end(); ++itChannels)
+		maxTime = std::max(getMaxTimeOfKeyframes(&*itChannels, data, startBinaryBuffer), maxTime);
 
 	return maxTime;
 }
 
 //---------------------------------------------------------------------
-bool gLTFImportOgreMeshCreator::isNodeAJointInThisSkin (const gLTFSkin& skin, const gLTFNode& node)
+bool gLTFImportOgreMeshCreator::isNodeAJointInThisSkin (const SkinTables& skin, const gLTFNode& node) const
 {
-	std::map<int, gLTFNode>::const_iterator itNode;
-	std::map<int, gLTFNode>::const_iterator itNodeEnd = skin.mNodesDerived.end();
-	gLTFNode nodeAsJoint;
-
-	for (itNode = skin.mNodesDerived.begin(); itNode != itNodeEnd; itNode++)
-	{
-		nodeAsJoint = itNode->second;
-		if (node.mNodeIndex == nodeAsJoint.mNodeIndex)
-			return true;
-	}
-
-	return false;
+	return getJointIndex(skin, node.mNodeIndex) > -1;
 }
 
 //---------------------------------------------------------------------
-float gLTFImportOgreMeshCreator::getMaxTimeOfKeyframes (gLTFAnimationChannel* animationChannel,
+float gLTFImportOgreMeshCreator::getMaxTimeOfKeyframes (const gLTFAnimationChannel* animationChannel,
 	Ogre::HlmsEditorPluginData* data,
 	int startBinaryBuffer)
 {
+	// Channels often share their input accessor; each accessor is only evaluated once
+	std::map<int, float>::const_iterator itCache = mMaxTimeCache.find(animationChannel->mInputDerived);
+	if (itCache != mMaxTimeCache.end())
+		return itCache->second;
+
 	OUT << TABx4 << "Perform gLTFImportOgreMeshCreator::getMaxTimeOfKeyframes\n";
 
+	// The gLTF specs require min/max for animation inputs; only scan the buffer if max is not available
 	float maxTime = 0.0f;
-	float time = 0.0f;
-	gLTFAccessor  animationChannelAccessor;
-	animationChannelAccessor = mAccessorMap[animationChannel->mInputDerived];
-	char* buffer = getBufferChunk(animationChannelAccessor.mUriDerived, data, animationChannelAccessor, startBinaryBuffer);
-
-	// Iterate through the chunk
-	// You may assume that keyframeAccessor.mCount represents the max. time, but better be safe and read them all
-	for (int i = 0; i < animationChannelAccessor.mCount; i++)
+	const gLTFAccessor* animationChannelAccessor = getElementByIndex(mDocument->mAccessors, animationChannel->mInputDerived);
+	if (!animationChannelAccessor)
+		maxTime = 0.0f;
+	else if (animationChannelAccessor->mMaxAvailable)
+		maxTime = animationChannelAccessor->mMaxFloat[0];
+	else if (animationChannelAccessor->mType == "SCALAR")
 	{
-		// A position must be a SCALAR/Float, otherwise it doesn't get read
-		if (animationChannelAccessor.mType == "SCALAR" && animationChannelAccessor.mComponentType == gLTFAccessor::FLOAT)
-		{
-			time = mBufferReader.readFromFloatBuffer(buffer,
-				i,
-				animationChannelAccessor,
-				getCorrectForMinMaxPropertyValue(data));
-			maxTime = std::max(time, maxTime);
-		}
+		char* buffer = getBufferChunk(animationChannelAccessor->mUriDerived, data, *animationChannelAccessor, startBinaryBuffer);
+		if (mBufferReader.readFloatArrayFromBuffer(buffer, *animationChannelAccessor, mHelperTimes))
+			maxTime = std::max(mBufferReader.computeMaxOfArray(&mHelperTimes[0], mHelperTimes.size()), 0.0f);
+		delete[] buffer;
 	}
 
-	delete[] buffer;
-
+	mMaxTimeCache[animationChannel->mInputDerived] = maxTime;
 	return maxTime;
 }
 
 //---------------------------------------------------------------------
-bool gLTFImportOgreMeshCreator::writeKeyframesToSkeleton (std::ofstream& dst,
-	std::vector<gLTFAnimationChannel>* animationChannelsForNode,
+bool gLTFImportOgreMeshCreator::mergeKeyframes (std::vector<gLTFAnimationChannelHandle>::const_iterator first,
+	std::vector<gLTFAnimationChannelHandle>::const_iterator last,
 	Ogre::HlmsEditorPluginData* data,
 	int startBinaryBuffer)
 {
-	float time = 0.0f;
-	gLTFAccessor  inputAccessor;
-	gLTFAccessor  outputAccessor;
-	gLTFAnimationChannel animationChannel;
-	Ogre::Vector3 axis;
-	Ogre::Radian angle;
-	char* inputBuffer;
-	char* outputBuffer;
-	Ogre::Vector3 translation;
-	Ogre::Vector4 vec4Rotation;
-	Ogre::Quaternion rotation;
-	Ogre::Vector3 scale;
-	std::map<float, Keyframe> keyframes;
-	std::map<int, char*> inputBufferMap;
-	std::map<int, char*> outputBufferMap;
-
-
-	// The animation channels are all part of the same animation and the same node, assume they all refer to the 
-	// same accessor (otherwise it isn't part of same set of keyframes)
-
-	// Iterate through the channels and create the in- and output buffers
-	unsigned int index = 0;
-	std::vector<gLTFAnimationChannel>::iterator it;
-	for (it = animationChannelsForNode->begin(); it != animationChannelsForNode->end(); it++)
-	{
-		animationChannel = *it;
-		inputAccessor = mAccessorMap[animationChannel.mInputDerived];
-		outputAccessor = mAccessorMap[animationChannel.mOutputDerived];
-		inputBuffer = getBufferChunk(inputAccessor.mUriDerived, data, inputAccessor, startBinaryBuffer);
-		outputBuffer = getBufferChunk(outputAccessor.mUriDerived, data, outputAccessor, startBinaryBuffer);
-		inputBufferMap[index] = inputBuffer;
-		outputBufferMap[index] = outputBuffer;
-		++index;
-	}
+	gLTFImportKeyframeMerger::Path path;
+	gLTFImportKeyframeMerger::Interpolation interpolation;
+	bool correctForMinMax = mOptions->mCorrectForMinMax;
 
-	// Iterate through the buffers to get the time and TRS values. According to the specs, the number of entries in the
-	// inputbuffer must match the number of entries in the outputbuffer
-	index = 0;
-	for (it = animationChannelsForNode->begin(); it != animationChannelsForNode->end(); it++)
+	/* Decode the times and TRS values of each channel at once into flat arrays. According to the specs, the number
+	 * of entries in the input buffer must match the number of entries in the output buffer.
+	 */
+	mKeyframeMerger.clear();
+	const gLTFAnimationChannel* channel;
+	bool hasChannels = false;
+	for (; first != last; ++first)
 	{
-		animationChannel = *it;
-		inputAccessor = mAccessorMap[animationChannel.mInputDerived];
-		outputAccessor = mAccessorMap[animationChannel.mOutputDerived];
+		channel = getAnimationChannel(*first);
+		if (!channel)
+			continue;
+
+		hasChannels = true;
+		if (channel->mTargetPath == "translation")
+			path = gLTFImportKeyframeMerger::TRANSLATION;
+		else if (channel->mTargetPath == "rotation")
+			path = gLTFImportKeyframeMerger::ROTATION;
+		else if (channel->mTargetPath == "scale")
+			path = gLTFImportKeyframeMerger::SCALE;
+		else
+			continue; // Weights are written as pose animations in the mesh file
+
+		interpolation = gLTFImportKeyframeMerger::LINEAR;
+		if (channel->mInterpolationDerived == "STEP")
+			interpolation = gLTFImportKeyframeMerger::STEP;
+		else if (channel->mInterpolationDerived == "CUBICSPLINE")
+			interpolation = gLTFImportKeyframeMerger::CUBICSPLINE;
+
+		if (!getElementByIndex(mDocument->mAccessors, channel->mInputDerived) || !getElementByIndex(mDocument->mAccessors, channel->mOutputDerived))
+			continue;
+
+		const gLTFAccessor& inputAccessor = mDocument->mAccessors[channel->mInputDerived];
+		const gLTFAccessor& outputAccessor = mDocument->mAccessors[channel->mOutputDerived];
+		if (inputAccessor.mType != "SCALAR")
+			continue;
+
+		char* inputBuffer = getBufferChunk(inputAccessor.mUriDerived, data, inputAccessor, startBinaryBuffer);
+		char* outputBuffer = getBufferChunk(outputAccessor.mUriDerived, data, outputAccessor, startBinaryBuffer);
+		bool result = mBufferReader.readFloatArrayFromBuffer(inputBuffer, inputAccessor, mHelperTimes) &&
+			mBufferReader.readFloatArrayFromBuffer(outputBuffer, outputAccessor, mHelperValues);
+		delete[] outputBuffer;
+		delete[] inputBuffer;
+		if (!result)
+			continue;
 
-		for (int i = 0; i < inputAccessor.mCount; i++)
+		if (correctForMinMax)
 		{
-			if (inputAccessor.mType == "SCALAR" && inputAccessor.mComponentType == gLTFAccessor::FLOAT)
-			{
-				time = mBufferReader.readFromFloatBuffer(inputBufferMap[index],
-					i,
-					inputAccessor,
-					getCorrectForMinMaxPropertyValue(data));
-				keyframes[time].time = time;
-			}
-
-			// TRS
-			if (animationChannel.mTargetPath == "translation")
-			{
-				translation = mBufferReader.readVec3FromFloatBuffer(outputBufferMap[index],
-					i,
-					outputAccessor,
-					getCorrectForMinMaxPropertyValue(data));
-				keyframes[time].hasTranslation = true;
-				keyframes[time].translation = translation;
-			}
-			else if (animationChannel.mTargetPath == "rotation")
-			{
-				vec4Rotation = mBufferReader.readVec4FromFloatBuffer(outputBufferMap[index],
-					i,
-					outputAccessor,
-					getCorrectForMinMaxPropertyValue(data));
-				rotation.x = vec4Rotation.x;
-				rotation.y = vec4Rotation.y;
-				rotation.z = vec4Rotation.z;
-				rotation.w = vec4Rotation.w;
-				keyframes[time].rotation = rotation;
-				keyframes[time].hasRotation = true;
-			}
-			else if (animationChannel.mTargetPath == "scale")
-			{
-				scale = mBufferReader.readVec3FromFloatBuffer(outputBufferMap[index],
-					i,
-					outputAccessor,
-					getCorrectForMinMaxPropertyValue(data));
-				keyframes[time].scale = scale;
-				keyframes[time].hasScale = true;
-			}
-			// Weights are not supported
+			mBufferReader.correctArrayWithMinMax(inputAccessor, mHelperTimes);
+			mBufferReader.correctArrayWithMinMax(outputAccessor, mHelperValues);
 		}
-
-		++index;
+		mKeyframeMerger.addChannel(path, interpolation, mHelperTimes, mHelperValues);
 	}
 
-	// Iterate through the in/outputbuffers and delete them
-	std::map<int, char*>::iterator itOutputBuffers;
-	for (itOutputBuffers = outputBufferMap.begin(); itOutputBuffers != outputBufferMap.end(); itOutputBuffers++)
-	{
-		outputBuffer = itOutputBuffers->second;
-		delete[] outputBuffer;
-	}
-	std::map<int, char*>::iterator itInputBuffers;
-	for (itInputBuffers = inputBufferMap.begin(); itInputBuffers != inputBufferMap.end(); itInputBuffers++)
-	{
-		inputBuffer = itInputBuffers->second;
-		delete[] inputBuffer;
-	}
-	
+	/* Either sample the channels at a fixed rate (Ogre interpolates linearly, so STEP and CUBICSPLINE channels are 
+	 * only reproduced between the original keyframes when resampled), or combine the sorted times of the channels; 
+	 * times that only differ by float noise become one keyframe.
+	 */
+	unsigned int resampleRate = mOptions->mAnimationResampleRate;
+	if (resampleRate > 0)
+		mKeyframeMerger.resample(static_cast<float>(resampleRate));
+	else
+		mKeyframeMerger.merge(KEYFRAME_TIME_TOLERANCE);
+
+	return hasChannels;
+}
+
+//---------------------------------------------------------------------
+bool gLTFImportOgreMeshCreator::writeKeyframesToSkeleton (std::ostream& dst,
+	const std::vector<gLTFImportKeyframeMerger::Keyframe>& keyframes)
+{
+	Ogre::Vector3 axis;
+	Ogre::Radian angle;
+
 	// Iterate through the keyframes
-	std::map<float, Keyframe>::iterator itKeyframes;
+	std::vector<gLTFImportKeyframeMerger::Keyframe>::const_iterator itKeyframes;
 	for (itKeyframes = keyframes.begin(); itKeyframes != keyframes.end(); itKeyframes++)
 	{
-		Keyframe keyframe = itKeyframes->second;
+		const gLTFImportKeyframeMerger::Keyframe& keyframe = *itKeyframes;
 		dst << TABx6 <<
 			"<keyframe time=\"" <<
 			keyframe.time <<
@@ -1177,27 +1791,31 @@ bool gLTFImportOgreMeshCreator::writeKeyframesToSkeleton (std::ofstream& dst,
 //---------------------------------------------------------------------
 void gLTFImportOgreMeshCreator::readPositionsFromUriOrFile (const gLTFPrimitive& primitive,
 	Ogre::HlmsEditorPluginData* data,
-	int startBinaryBuffer,
-	Ogre::Matrix4 matrix)
+	int startBinaryBuffer)
 {
+	const gLTFAccessor* accessor = getElementByIndex(mDocument->mAccessors, primitive.mPositionAccessorDerived);
+	if (!accessor)
+		return;
+
 	// Open the buffer file and read positions
-	gLTFAccessor  positionAccessor = mAccessorMap[primitive.mPositionAccessorDerived];
+	gLTFAccessor  positionAccessor = *accessor;
 	char* buffer = getBufferChunk(positionAccessor.mUriDerived, data, positionAccessor, startBinaryBuffer);
 
 	// Iterate through the chunk
-	mPositionsMap.clear();
+	mStagedSubmesh.resizePositions(positionAccessor.mCount);
 	for (int i = 0; i < positionAccessor.mCount; i++)
 	{
 		// A position must be a VEC3/Float, otherwise it doesn't get read
 		if (positionAccessor.mType == "VEC3" && positionAccessor.mComponentType == gLTFAccessor::FLOAT)
 		{
-			// Perform the transformation; use Ogre's classes, because they are proven
+			// The transformation is performed afterwards on the staged submesh
 			Ogre::Vector3 pos = mBufferReader.readVec3FromFloatBuffer(buffer,
 				i, 
 				positionAccessor, 
-				getCorrectForMinMaxPropertyValue(data));
-			pos = matrix * pos;
-			mPositionsMap[i] = pos;
+				mOptions->mCorrectForMinMax);
+			mStagedSubmesh.mPositionsX[i] = pos.x;
+			mStagedSubmesh.mPositionsY[i] = pos.y;
+			mStagedSubmesh.mPositionsZ[i] = pos.z;
 		}
 	}
 
@@ -1209,15 +1827,16 @@ void gLTFImportOgreMeshCreator::readNormalsFromUriOrFile (const gLTFPrimitive& p
 	Ogre::HlmsEditorPluginData* data,
 	int startBinaryBuffer)
 {
-	if (primitive.mNormalAccessorDerived < 0)
+	const gLTFAccessor* accessor = getElementByIndex(mDocument->mAccessors, primitive.mNormalAccessorDerived);
+	if (!accessor)
 		return;
 
 	// Get the buffer and read positions
-	gLTFAccessor  normalAccessor = mAccessorMap[primitive.mNormalAccessorDerived];
+	gLTFAccessor  normalAccessor = *accessor;
 	char* buffer = getBufferChunk(normalAccessor.mUriDerived, data, normalAccessor, startBinaryBuffer);
 
 	// Iterate through the chunk
-	mNormalsMap.clear();
+	mStagedSubmesh.resizeNormals(normalAccessor.mCount);
 	for (int i = 0; i < normalAccessor.mCount; i++)
 	{
 		// A normal  must be a VEC3/Float, otherwise it doesn't get read
@@ -1226,8 +1845,10 @@ void gLTFImportOgreMeshCreator::readNormalsFromUriOrFile (const gLTFPrimitive& p
 			Ogre::Vector3 pos = mBufferReader.readVec3FromFloatBuffer(buffer,
 				i, 
 				normalAccessor, 
-				getCorrectForMinMaxPropertyValue(data));
-			mNormalsMap[i] = pos;
+				mOptions->mCorrectForMinMax);
+			mStagedSubmesh.mNormalsX[i] = pos.x;
+			mStagedSubmesh.mNormalsY[i] = pos.y;
+			mStagedSubmesh.mNormalsZ[i] = pos.z;
 		}
 	}
 
@@ -1239,15 +1860,16 @@ void gLTFImportOgreMeshCreator::readTangentsFromUriOrFile (const gLTFPrimitive&
 	Ogre::HlmsEditorPluginData* data,
 	int startBinaryBuffer)
 {
-	if (primitive.mTangentAccessorDerived < 0)
+	const gLTFAccessor* accessor = getElementByIndex(mDocument->mAccessors, primitive.mTangentAccessorDerived);
+	if (!accessor)
 		return;
 
 	// Get the buffer file and read positions
-	gLTFAccessor  tangentAccessor = mAccessorMap[primitive.mTangentAccessorDerived];
+	gLTFAccessor  tangentAccessor = *accessor;
 	char* buffer = getBufferChunk(tangentAccessor.mUriDerived, data, tangentAccessor, startBinaryBuffer);
 
 	// Iterate through the chunk
-	mTangentsMap.clear();
+	mStagedSubmesh.resizeTangents(tangentAccessor.mCount);
 	for (int i = 0; i < tangentAccessor.mCount; i++)
 	{
 		// A tangent must be a VEC4/Float, otherwise it doesn't get read
@@ -1256,8 +1878,11 @@ void gLTFImportOgreMeshCreator::readTangentsFromUriOrFile (const gLTFPrimitive&
 			Ogre::Vector4 pos = mBufferReader.readVec4FromFloatBuffer(buffer,
 				i, 
 				tangentAccessor, 
-				getCorrectForMinMaxPropertyValue(data));
-			mTangentsMap[i] = pos;
+				mOptions->mCorrectForMinMax);
+			mStagedSubmesh.mTangentsX[i] = pos.x;
+			mStagedSubmesh.mTangentsY[i] = pos.y;
+			mStagedSubmesh.mTangentsZ[i] = pos.z;
+			mStagedSubmesh.mTangentsW[i] = pos.w;
 		}
 	}
 
@@ -1269,15 +1894,16 @@ void gLTFImportOgreMeshCreator::readColorsFromUriOrFile (const gLTFPrimitive& pr
 	Ogre::HlmsEditorPluginData* data,
 	int startBinaryBuffer)
 {
-	if (primitive.mColor_0AccessorDerived < 0)
+	const gLTFAccessor* accessor = getElementByIndex(mDocument->mAccessors, primitive.mColor_0AccessorDerived);
+	if (!accessor)
 		return;
 
 	// Get the buffer file and read colours
-	gLTFAccessor  mColor_0Accessor = mAccessorMap[primitive.mColor_0AccessorDerived];
+	gLTFAccessor  mColor_0Accessor = *accessor;
 	char* buffer = getBufferChunk(mColor_0Accessor.mUriDerived, data, mColor_0Accessor, startBinaryBuffer);
 
 	// Iterate through the chunk
-	mColor_0AccessorMap.clear();
+	mStagedSubmesh.mColours.assign(mColor_0Accessor.mCount, Ogre::Vector4::ZERO);
 	for (int i = 0; i < mColor_0Accessor.mCount; i++)
 	{
 		// A colour can be a VEC3 (Float)
@@ -1286,21 +1912,21 @@ void gLTFImportOgreMeshCreator::readColorsFromUriOrFile (const gLTFPrimitive& pr
 			Ogre::Vector3 v3 = mBufferReader.readVec3FromFloatBuffer(buffer,
 				i, 
 				mColor_0Accessor, 
-				getCorrectForMinMaxPropertyValue(data));
+				mOptions->mCorrectForMinMax);
 			Ogre::Vector4 col;
 			col.x = v3.x;
 			col.y = v3.y;
 			col.z = v3.z;
 			col.w = 1.0f;
-			mColor_0AccessorMap[i] = col;
+			mStagedSubmesh.mColours[i] = col;
 		}
 		else if (mColor_0Accessor.mType == "VEC4")
 		{
 			Ogre::Vector4 col = mBufferReader.readVec4FromFloatBuffer(buffer,
 				i, 
 				mColor_0Accessor, 
-				getCorrectForMinMaxPropertyValue(data));
-			mColor_0AccessorMap[i] = col;
+				mOptions->mCorrectForMinMax);
+			mStagedSubmesh.mColours[i] = col;
 		}
 	}
 
@@ -1312,38 +1938,47 @@ void gLTFImportOgreMeshCreator::readIndicesFromUriOrFile (const gLTFPrimitive& p
 	Ogre::HlmsEditorPluginData* data,
 	int startBinaryBuffer)
 {
-	if (primitive.mIndicesAccessor < 0)
+	const gLTFAccessor* accessor = getElementByIndex(mDocument->mAccessors, primitive.mIndicesAccessor);
+	if (!accessor)
 		return;
 
 	// Get the buffer file and read indices
-	gLTFAccessor indicesAccessor = mAccessorMap[primitive.mIndicesAccessor];
+	gLTFAccessor indicesAccessor = *accessor;
 	char* buffer = getBufferChunk(indicesAccessor.mUriDerived, data, indicesAccessor, startBinaryBuffer);
 
 	// Iterate through the chunk
-	mIndicesMap.clear();
+	std::vector<unsigned int>& indices = mStagedSubmesh.mIndices;
+	indices.assign(indicesAccessor.mCount, 0);
+	mStagedSubmesh.mHasIndices = indicesAccessor.mCount > 0;
 	if (indicesAccessor.mType == "SCALAR" && indicesAccessor.mComponentType == gLTFAccessor::UNSIGNED_BYTE)
 	{
 		for (int i = 0; i < indicesAccessor.mCount; i++)
-			mIndicesMap[i] = mBufferReader.readFromUnsignedByteBuffer(buffer, 
+			indices[i] = mBufferReader.readFromUnsignedByteBuffer(buffer, 
 				i, 
 				indicesAccessor,
-				getCorrectForMinMaxPropertyValue(data));
+				mOptions->mCorrectForMinMax);
 	}
 	else if (indicesAccessor.mType == "SCALAR" && indicesAccessor.mComponentType == gLTFAccessor::UNSIGNED_SHORT)
 	{
 		for (int i = 0; i < indicesAccessor.mCount; i++)
-			mIndicesMap[i] = mBufferReader.readFromUnsignedShortBuffer(buffer, 
+			indices[i] = mBufferReader.readFromUnsignedShortBuffer(buffer, 
 				i, 
 				indicesAccessor,
-				getCorrectForMinMaxPropertyValue(data));
+				mOptions->mCorrectForMinMax);
 	}
 	else if (indicesAccessor.mType == "SCALAR" && indicesAccessor.mComponentType == gLTFAccessor::UNSIGNED_INT)
 	{
 		for (int i = 0; i < indicesAccessor.mCount; i++)
-			mIndicesMap[i] = mBufferReader.readFromUnsignedIntBuffer(buffer, 
+			indices[i] = mBufferReader.readFromUnsignedIntBuffer(buffer, 
 				i, 
 				indicesAccessor,
-				getCorrectForMinMaxPropertyValue(data));
+				mOptions->mCorrectForMinMax);
+	}
+	else
+	{
+		// Unsupported index type; handle the primitive as non-indexed
+		indices.clear();
+		mStagedSubmesh.mHasIndices = false;
 	}
 
 	delete[] buffer;
@@ -1354,15 +1989,16 @@ void gLTFImportOgreMeshCreator::readTexCoords0FromUriOrFile (const gLTFPrimitive
 	Ogre::HlmsEditorPluginData* data,
 	int startBinaryBuffer)
 {
-	if (primitive.mTexcoord_0AccessorDerived < 0)
+	const gLTFAccessor* accessor = getElementByIndex(mDocument->mAccessors, primitive.mTexcoord_0AccessorDerived);
+	if (!accessor)
 		return;
 
 	// Get the buffer file and read positions
-	gLTFAccessor  mTexcoord_0Accessor = mAccessorMap[primitive.mTexcoord_0AccessorDerived];
+	gLTFAccessor  mTexcoord_0Accessor = *accessor;
 	char* buffer = getBufferChunk(mTexcoord_0Accessor.mUriDerived, data, mTexcoord_0Accessor, startBinaryBuffer);
 
 	// Iterate through the chunk
-	mTexcoords_0Map.clear();
+	mStagedSubmesh.mTexcoords_0.assign(mTexcoord_0Accessor.mCount, Ogre::Vector2::ZERO);
 	for (int i = 0; i < mTexcoord_0Accessor.mCount; i++)
 	{
 		// A position must be a VEC3/Float, otherwise it doesn't get read
@@ -1371,24 +2007,24 @@ void gLTFImportOgreMeshCreator::readTexCoords0FromUriOrFile (const gLTFPrimitive
 			Ogre::Vector2 pos = mBufferReader.readVec2FromFloatBuffer(buffer,
 				i, 
 				mTexcoord_0Accessor, 
-				getCorrectForMinMaxPropertyValue(data));
-			mTexcoords_0Map[i] = pos;
+				mOptions->mCorrectForMinMax);
+			mStagedSubmesh.mTexcoords_0[i] = pos;
 		}
 		else if (mTexcoord_0Accessor.mType == "VEC2" && mTexcoord_0Accessor.mComponentType == gLTFAccessor::UNSIGNED_BYTE)
 		{
 			Ogre::Vector2 pos = mBufferReader.readVec2FromUnsignedByteBuffer(buffer,
 				i, 
 				mTexcoord_0Accessor, 
-				getCorrectForMinMaxPropertyValue(data));
-			mTexcoords_0Map[i] = pos;
+				mOptions->mCorrectForMinMax);
+			mStagedSubmesh.mTexcoords_0[i] = pos;
 		}
 		else if (mTexcoord_0Accessor.mType == "VEC2" && mTexcoord_0Accessor.mComponentType == gLTFAccessor::UNSIGNED_SHORT)
 		{
 			Ogre::Vector2 pos = mBufferReader.readVec2FromUnsignedShortBuffer(buffer,
 				i, 
 				mTexcoord_0Accessor, 
-				getCorrectForMinMaxPropertyValue(data));
-			mTexcoords_0Map[i] = pos;
+				mOptions->mCorrectForMinMax);
+			mStagedSubmesh.mTexcoords_0[i] = pos;
 		}
 	}
 
@@ -1400,15 +2036,16 @@ void gLTFImportOgreMeshCreator::readTexCoords1FromUriOrFile (const gLTFPrimitive
 	Ogre::HlmsEditorPluginData* data,
 	int startBinaryBuffer)
 {
-	if (primitive.mTexcoord_1AccessorDerived < 0)
+	const gLTFAccessor* accessor = getElementByIndex(mDocument->mAccessors, primitive.mTexcoord_1AccessorDerived);
+	if (!accessor)
 		return;
 
 	// Get the buffer file and read positions
-	gLTFAccessor  mTexcoord_1Accessor = mAccessorMap[primitive.mTexcoord_1AccessorDerived];
+	gLTFAccessor  mTexcoord_1Accessor = *accessor;
 	char* buffer = getBufferChunk(mTexcoord_1Accessor.mUriDerived, data, mTexcoord_1Accessor, startBinaryBuffer);
 
 	// Iterate through the chunk
-	mTexcoords_1Map.clear();
+	mStagedSubmesh.mTexcoords_1.assign(mTexcoord_1Accessor.mCount, Ogre::Vector2::ZERO);
 	for (int i = 0; i < mTexcoord_1Accessor.mCount; i++)
 	{
 		// A position must be a VEC3, otherwise it doesn't get read
@@ -1417,24 +2054,24 @@ void gLTFImportOgreMeshCreator::readTexCoords1FromUriOrFile (const gLTFPrimitive
 			Ogre::Vector2 pos = mBufferReader.readVec2FromFloatBuffer(buffer,
 				i, 
 				mTexcoord_1Accessor, 
-				getCorrectForMinMaxPropertyValue(data));
-			mTexcoords_1Map[i] = pos;
+				mOptions->mCorrectForMinMax);
+			mStagedSubmesh.mTexcoords_1[i] = pos;
 		}
 		else if (mTexcoord_1Accessor.mType == "VEC2" && mTexcoord_1Accessor.mComponentType == gLTFAccessor::UNSIGNED_BYTE)
 		{
 			Ogre::Vector2 pos = mBufferReader.readVec2FromUnsignedByteBuffer(buffer,
 				i, 
 				mTexcoord_1Accessor, 
-				getCorrectForMinMaxPropertyValue(data));
-			mTexcoords_1Map[i] = pos;
+				mOptions->mCorrectForMinMax);
+			mStagedSubmesh.mTexcoords_1[i] = pos;
 		}
 		else if (mTexcoord_1Accessor.mType == "VEC2" && mTexcoord_1Accessor.mComponentType == gLTFAccessor::UNSIGNED_SHORT)
 		{
 			Ogre::Vector2 pos = mBufferReader.readVec2FromUnsignedShortBuffer(buffer,
 				i, 
 				mTexcoord_1Accessor, 
-				getCorrectForMinMaxPropertyValue(data));
-			mTexcoords_1Map[i] = pos;
+				mOptions->mCorrectForMinMax);
+			mStagedSubmesh.mTexcoords_1[i] = pos;
 		}
 	}
 
@@ -1496,18 +2133,13 @@ bool gLTFImportOgreMeshCreator::convertXmlFileToMesh (Ogre::HlmsEditorPluginData
 	std::string meshToolGenerateEdgeLists = "-e ";
 	std::string meshToolOptimize = "-O qs ";
 	
-	// First get the property values (from the HLMS Editor)
-	std::map<std::string, Ogre::HlmsEditorPluginData::PLUGIN_PROPERTY> properties = data->mInPropertiesMap;
-	std::map<std::string, Ogre::HlmsEditorPluginData::PLUGIN_PROPERTY>::iterator it = properties.find("generate_edge_lists");
-	if (it != properties.end() && (it->second).boolValue)
-		meshToolGenerateEdgeLists = "";
-
-	it = properties.find("generate_tangents");
-	if (it != properties.end() && (it->second).boolValue)
+	if (mOptions->mGenerateEdgeLists && !mEdgeListsWritten)
+		meshToolGenerateEdgeLists = ""; // Only if the edge lists are not written to the xml file already
+
+	if (mOptions->mGenerateTangents)
 		meshToolGenerateTangents = "-t -ts 4 ";
 
-	it = properties.find("optimize_for_desktop");
-	if (it != properties.end() && (it->second).boolValue)
+	if (mOptions->mOptimizeForDesktop)
 		meshToolOptimize = "-O puqs ";
 
 	meshToolCmd += meshToolGenerateEdgeLists + meshToolGenerateTangents + meshToolOptimize;
@@ -1532,21 +2164,6 @@ bool gLTFImportOgreMeshCreator::convertXmlFileToSkeleton (Ogre::HlmsEditorPlugin
 	return true;
 }
 
-//---------------------------------------------------------------------
-bool gLTFImportOgreMeshCreator::getCorrectForMinMaxPropertyValue (Ogre::HlmsEditorPluginData* data)
-{
-	// First get the property value (from the HLMS Editor)
-	std::map<std::string, Ogre::HlmsEditorPluginData::PLUGIN_PROPERTY> properties = data->mInPropertiesMap;
-	std::map<std::string, Ogre::HlmsEditorPluginData::PLUGIN_PROPERTY>::iterator it = properties.find("correct_min_max");
-	if (it != properties.end())
-	{
-		// Property found; determine its value
-		return (it->second).boolValue;
-	}
-
-	return false;
-}
-
 //---------------------------------------------------------------------
 bool gLTFImportOgreMeshCreator::setMeshFileNamePropertyValue (Ogre::HlmsEditorPluginData* data, const std::string& fileName)
 {
@@ -1572,148 +2189,306 @@ bool gLTFImportOgreMeshCreator::setSkeletonFileNamePropertyValue(Ogre::HlmsEdito
 }
 
 //---------------------------------------------------------------------
-std::vector<gLTFAnimationChannel> gLTFImportOgreMeshCreator::getAnimationChannelsByNode (int nodeIndex)
+const gLTFAnimationChannel* gLTFImportOgreMeshCreator::getAnimationChannel (const gLTFAnimationChannelHandle& handle) const
 {
-	mHelperAnimationChannelVector.clear();
-	std::map<int, gLTFAnimation>::iterator it;
-	std::map<int, gLTFAnimation>::iterator itEnd = mAnimationsMap.end();
-	std::map<int, gLTFAnimationChannel>::iterator itChannels;
-	std::map<int, gLTFAnimationChannel>::iterator itChannelsEnd;
-	gLTFAnimation animation;
-	gLTFAnimationChannel animationChannel;
-	for (it = mAnimationsMap.begin(); it != itEnd; it++)
-	{
-		animation = it->second;
-		for (itChannels = animation.mAnimationChannelsMap.begin(); itChannels != animation.mAnimationChannelsMap.end(); itChannels++)
-		{
-			animationChannel = itChannels->second;
-			if (animationChannel.mTargetNode == nodeIndex)
-				mHelperAnimationChannelVector.push_back(animationChannel);
-		}
-	}
+	const gLTFAnimation* animation = getElementByIndex(mDocument->mAnimations, handle.mAnimation);
+	if (!animation)
+		return 0;
 
-	return mHelperAnimationChannelVector;
+	return getElementByIndex(animation->mAnimationChannels, handle.mChannel);
 }
 
 //---------------------------------------------------------------------
-gLTFAnimation gLTFImportOgreMeshCreator::getAnimationByIndex (int animationIndex)
+void gLTFImportOgreMeshCreator::writePrunedAttributesToReport (void)
 {
-	mHelperAnimation = gLTFAnimation();
-	std::map<int, gLTFAnimation>::iterator it = mAnimationsMap.find(animationIndex);
-	if (it != mAnimationsMap.end())
+	std::vector<gLTFMesh>::const_iterator itMeshes;
+	unsigned int totalBytes = 0;
+	bool sectionStarted = false;
+	for (itMeshes = mDocument->mMeshes.begin(); itMeshes != mDocument->mMeshes.end(); itMeshes++)
 	{
-		// Found the node
-		mHelperAnimation = it->second;
-		return mHelperAnimation;
+		for (size_t primitiveIndex = 0; primitiveIndex < itMeshes->mPrimitives.size(); ++primitiveIndex)
+		{
+			const gLTFPrimitive& primitive = itMeshes->mPrimitives[primitiveIndex];
+			if (primitive.mPrunedAttributesDerived == "")
+				continue;
+
+			if (!sectionStarted)
+			{
+				mReport.beginSection("Pruned vertex attributes");
+				sectionStarted = true;
+			}
+			mReport.getStream() << "mesh " << itMeshes->mName << ", primitive " << primitiveIndex <<
+				": " << primitive.mPrunedAttributesDerived << " (" << primitive.mPrunedBytesDerived << " bytes saved)\n";
+			totalBytes += primitive.mPrunedBytesDerived;
+		}
 	}
 
-	return mHelperAnimation;
+	if (sectionStarted)
+		mReport.getStream() << "total: " << totalBytes << " bytes saved\n";
 }
 
 //---------------------------------------------------------------------
-gLTFNode gLTFImportOgreMeshCreator::getNodeByIndex (int nodeIndex)
+int gLTFImportOgreMeshCreator::findSkinIndexByNodeIndex (unsigned int nodeIndex)
 {
-	mHelperNode = gLTFNode();
-	std::map<int, gLTFNode>::iterator it = mNodesMap.find(nodeIndex);
-	if (it != mNodesMap.end())
-	{
-		// Found the node
-		mHelperNode = it->second;
-		return mHelperNode;
-	}
+	const gLTFNode* node = getElementByIndex(mDocument->mNodes, nodeIndex);
+	if (node)
+		return node->mSkin;
 
-	return mHelperNode;
+	return 0; // Use default skin
 }
 
+
 //---------------------------------------------------------------------
-bool gLTFImportOgreMeshCreator::isGenerateTangentsProperty (Ogre::HlmsEditorPluginData* data)
+int gLTFImportOgreMeshCreator::getBoneId (const SkinTables& skin, unsigned int jointIndex) const
 {
-	std::map<std::string, Ogre::HlmsEditorPluginData::PLUGIN_PROPERTY> properties = data->mInPropertiesMap;
-	std::map<std::string, Ogre::HlmsEditorPluginData::PLUGIN_PROPERTY>::iterator it = properties.find("generate_tangents");
-	if (it != properties.end())
-		return (it->second).boolValue;
-
-	return false;
+	return skin.boneIds[jointIndex];
 }
 
 //---------------------------------------------------------------------
-bool gLTFImportOgreMeshCreator::isGenerateAnimationProperty (Ogre::HlmsEditorPluginData* data)
+const std::string& gLTFImportOgreMeshCreator::getBoneName (const SkinTables& skin, unsigned int jointIndex) const
 {
-	std::map<std::string, Ogre::HlmsEditorPluginData::PLUGIN_PROPERTY> properties = data->mInPropertiesMap;
-	std::map<std::string, Ogre::HlmsEditorPluginData::PLUGIN_PROPERTY>::iterator it = properties.find("generate_animation");
-	if (it != properties.end())
-		return (it->second).boolValue;
+	return skin.boneNames[jointIndex];
+}
 
-	return false;
+//---------------------------------------------------------------------
+void gLTFImportOgreMeshCreator::buildAnimationNames (void)
+{
+	/* Ogre requires unique animation names; an animation without a name (or with a name that is already used) gets
+	 * its index as (part of the) name. The skeleton animation and the pose animation of a gLTF animation use the 
+	 * same name, so they are played together.
+	 */
+	std::set<std::string> names;
+	mAnimationNames.resize(mDocument->mAnimations.size());
+	for (size_t animationIndex = 0; animationIndex < mDocument->mAnimations.size(); ++animationIndex)
+	{
+		std::string& name = mAnimationNames[animationIndex];
+		name = mDocument->mAnimations[animationIndex].mName;
+		if (name.empty())
+			name = "Animation_" + std::to_string(animationIndex);
+		while (names.find(name) != names.end())
+			name += "_" + std::to_string(animationIndex);
+		names.insert(name);
+	}
 }
 
 //---------------------------------------------------------------------
-int gLTFImportOgreMeshCreator::findSkinIndexByNodeIndex (unsigned int nodeIndex)
+void gLTFImportOgreMeshCreator::buildSkinTables (void)
 {
-	std::map<int, gLTFNode>::iterator itNode;
-	gLTFNode node;
-	for (itNode = mNodesMap.begin(); itNode != mNodesMap.end(); itNode++)
+	// The table only depends on the joints of the skin, so it is built once instead of being searched for every joint
+	int nodeCount = (int)mDocument->mNodes.size();
+	unsigned int jointIndex;
+	int nodeIndex;
+	for (size_t skinIndex = 0; skinIndex < mDocument->mSkins.size(); ++skinIndex)
 	{
-		node = itNode->second;
-		if (node.mNodeIndex == nodeIndex)
+		const gLTFSkin& skin = mDocument->mSkins[skinIndex];
+		SkinTables& tables = mSkinTables[skinIndex];
+		tables.jointIndicesByNode.assign(nodeCount, -1);
+		for (jointIndex = 0; jointIndex < skin.mJoints.size(); ++jointIndex)
 		{
-			return node.mSkin;
+			nodeIndex = skin.mJoints[jointIndex];
+			if (nodeIndex > -1 && nodeIndex < nodeCount && tables.jointIndicesByNode[nodeIndex] == -1)
+				tables.jointIndicesByNode[nodeIndex] = jointIndex;
 		}
 	}
-
-	return 0; // Use default skin
 }
 
-
 //---------------------------------------------------------------------
-unsigned int gLTFImportOgreMeshCreator::getBoneId (unsigned int jointIndex, unsigned int skinIndex)
+void gLTFImportOgreMeshCreator::buildSkeleton (Ogre::HlmsEditorPluginData* data, int startBinaryBuffer)
 {
-	return jointIndex + MAX_JOINTS_PER_SKIN * skinIndex; // Must be a unique id over all the skins
+	OUT << TABx2 << "Perform gLTFImportOgreMeshCreator::buildSkeleton\n";
+
+	mSkeletonBones.clear();
+	int nodeCount = (int)mDocument->mNodes.size();
+	mBoneIdsByNode.assign(nodeCount, -1);
+	if (mDocument->mSkins.empty())
+		return;
+
+	/* 1. Determine which nodes are kept. A joint is kept if it has a weight or if it is an ancestor of a weighted 
+	 * joint. Walking up stops at a node that is already kept, so each node is visited once. A skin without any 
+	 * weighted joint (e.g. a skin that is not used by a mesh) keeps all its joints.
+	 */
+	std::map<int, std::vector<bool> > weightedJoints;
+	bool prune = mOptions->mOptimizeSkeleton && findWeightedJoints(data, startBinaryBuffer, weightedJoints);
+	std::vector<bool> keepNode(nodeCount, !prune);
+	std::vector<gLTFSkin>::const_iterator itSkin;
+	std::map<int, std::vector<bool> >::const_iterator itWeighted;
+	const gLTFNode* node;
+	unsigned int jointIndex;
+	int nodeIndex;
+	size_t jointCount = 0;
+	for (itSkin = mDocument->mSkins.begin(); prune && itSkin != mDocument->mSkins.end(); ++itSkin)
+	{
+		const gLTFSkin& skin = *itSkin;
+		itWeighted = weightedJoints.find((int)(itSkin - mDocument->mSkins.begin()));
+		bool keepAll = itWeighted == weightedJoints.end();
+		for (jointIndex = 0; jointIndex < skin.mJoints.size(); ++jointIndex)
+		{
+			if (!keepAll && !itWeighted->second[jointIndex])
+				continue;
+
+			node = mDocument->getJointNode(skin, jointIndex);
+			while (node && node->mNodeIndex > -1 && node->mNodeIndex < nodeCount && !keepNode[node->mNodeIndex])
+			{
+				keepNode[node->mNodeIndex] = true;
+				node = mDocument->getParentNode(*node);
+			}
+		}
+	}
+
+	// 2. Assign consecutive bone ids; a node that is a joint of more than one skin gets one bone
+	unsigned int mergedJoints = 0;
+	unsigned int prunedJoints = 0;
+	for (itSkin = mDocument->mSkins.begin(); itSkin != mDocument->mSkins.end(); ++itSkin)
+	{
+		const gLTFSkin& skin = *itSkin;
+		SkinTables& tables = mSkinTables[itSkin - mDocument->mSkins.begin()];
+		tables.boneIds.assign(skin.mJoints.size(), -1);
+		tables.boneNames.assign(skin.mJoints.size(), "");
+		jointCount += skin.mJoints.size();
+		for (jointIndex = 0; jointIndex < skin.mJoints.size(); ++jointIndex)
+		{
+			nodeIndex = skin.mJoints[jointIndex];
+			if (nodeIndex < 0 || nodeIndex >= nodeCount || !keepNode[nodeIndex])
+			{
+				++prunedJoints;
+				continue;
+			}
+
+			if (mBoneIdsByNode[nodeIndex] > -1)
+				++mergedJoints;
+			else
+			{
+				mBoneIdsByNode[nodeIndex] = (int)mSkeletonBones.size();
+				mSkeletonBones.push_back(SkeletonBone());
+				mSkeletonBones.back().nodeIndex = nodeIndex;
+				mSkeletonBones.back().name = "Bone_" + std::to_string(mSkeletonBones.size() - 1);
+			}
+			tables.boneIds[jointIndex] = mBoneIdsByNode[nodeIndex];
+			tables.boneNames[jointIndex] = mSkeletonBones[mBoneIdsByNode[nodeIndex]].name;
+		}
+	}
+
+	// 3. The parent of a bone is the bone of its parent node (if that node is a bone)
+	std::vector<SkeletonBone>::iterator itBones;
+	for (itBones = mSkeletonBones.begin(); itBones != mSkeletonBones.end(); ++itBones)
+	{
+		node = getElementByIndex(mDocument->mNodes, itBones->nodeIndex);
+		node = node ? mDocument->getParentNode(*node) : 0;
+		if (node && node->mNodeIndex > -1 && node->mNodeIndex < nodeCount)
+			itBones->parent = mBoneIdsByNode[node->mNodeIndex];
+	}
+
+	decomposeBindPoses();
+
+	mReport.beginSection("Skeleton");
+	mReport.getStream() << "joints = " << jointCount << "\n";
+	mReport.getStream() << "bones = " << mSkeletonBones.size() << "\n";
+	mReport.getStream() << "joints merged (shared by skins) = " << mergedJoints << "\n";
+	mReport.getStream() << "joints pruned (unweighted) = " << prunedJoints << "\n";
 }
 
 //---------------------------------------------------------------------
-const std::string& gLTFImportOgreMeshCreator::getBoneName (unsigned int jointIndex, unsigned int skinIndex)
+bool gLTFImportOgreMeshCreator::findWeightedJoints (Ogre::HlmsEditorPluginData* data, 
+	int startBinaryBuffer, 
+	std::map<int, std::vector<bool> >& weightedJoints)
 {
-	unsigned int indexForName = getBoneId(jointIndex, skinIndex);
-	std::stringstream ss;
-	ss << "Bone_" << indexForName;
-	mHelperString = ss.str();
-	return mHelperString;
+	/* Read the joints and weights of the primitives of each skinned node. A mesh that is used by more nodes with 
+	 * the same skin is read once.
+	 */
+	weightedJoints.clear();
+	std::set<std::pair<int, int> > meshesRead;
+	std::vector<gLTFNode>::const_iterator itNode;
+	const gLTFSkin* skin;
+	const gLTFMesh* mesh;
+	std::vector<gLTFPrimitive>::const_iterator itPrimitives;
+	bool found = false;
+	int skinIndex;
+	size_t jointCount;
+	size_t set;
+	size_t i;
+	size_t joint;
+	for (itNode = mDocument->mNodes.begin(); itNode != mDocument->mNodes.end(); ++itNode)
+	{
+		skinIndex = findSkinIndexByNodeIndex(itNode->mNodeIndex);
+		skin = getElementByIndex(mDocument->mSkins, skinIndex);
+		mesh = getElementByIndex(mDocument->mMeshes, itNode->mMesh);
+		if (!skin || !mesh)
+			continue;
+		if (!meshesRead.insert(std::make_pair(itNode->mMesh, skinIndex)).second)
+			continue;
+
+		jointCount = skin->mJoints.size();
+		std::vector<bool>& weighted = weightedJoints[skinIndex];
+		weighted.resize(jointCount, false);
+		const std::vector<gLTFPrimitive>& primitives = mesh->mPrimitives;
+		for (itPrimitives = primitives.begin(); itPrimitives != primitives.end(); ++itPrimitives)
+		{
+			const gLTFPrimitive& primitive = *itPrimitives;
+			readInfluenceSet(primitive.mJoints_0AccessorDerived, primitive.mWeights_0AccessorDerived, data, startBinaryBuffer,
+				mHelperJoints[0], mHelperWeights[0]);
+			readInfluenceSet(primitive.mJoints_1AccessorDerived, primitive.mWeights_1AccessorDerived, data, startBinaryBuffer,
+				mHelperJoints[1], mHelperWeights[1]);
+			for (set = 0; set < 2; ++set)
+			{
+				const std::vector<float>& joints = mHelperJoints[set];
+				const std::vector<float>& weights = mHelperWeights[set];
+				for (i = 0; i < weights.size() && i < joints.size(); ++i)
+				{
+					joint = (size_t)joints[i];
+					if (weights[i] > 0.0f && joint < jointCount && !weighted[joint])
+					{
+						weighted[joint] = true;
+						found = true;
+					}
+				}
+			}
+		}
+	}
+
+	// Skins without any weighted joint keep all their joints
+	std::map<int, std::vector<bool> >::iterator itWeighted = weightedJoints.begin();
+	while (itWeighted != weightedJoints.end())
+	{
+		if (std::find(itWeighted->second.begin(), itWeighted->second.end(), true) == itWeighted->second.end())
+			itWeighted = weightedJoints.erase(itWeighted);
+		else
+			++itWeighted;
+	}
+
+	return found;
 }
 
 //---------------------------------------------------------------------
-const Ogre::Matrix4& gLTFImportOgreMeshCreator::getInverseBindMatrix (unsigned int inverseBindMatricesAccessorIndex,
-	unsigned int jointIndex,
-	Ogre::HlmsEditorPluginData* data,
-	int startBinaryBuffer)
+int gLTFImportOgreMeshCreator::getJointIndex (const SkinTables& skin, int nodeIndex) const
 {
-	mHelperMatrix4 = Ogre::Matrix4();
-	gLTFAccessor  inverseBindMatricesAccessor;
-	inverseBindMatricesAccessor = mAccessorMap[inverseBindMatricesAccessorIndex];
-	char* buffer = getBufferChunk(inverseBindMatricesAccessor.mUriDerived, data, inverseBindMatricesAccessor, startBinaryBuffer);
-
-	// Assume that jointIndex also represents the index of the matrix4 in this buffer
-	mHelperMatrix4 = mBufferReader.readMatrix4FromFloatBuffer(buffer,
-		jointIndex,
-		inverseBindMatricesAccessor,
-		getCorrectForMinMaxPropertyValue(data));
-	
-	delete[] buffer;
-	return mHelperMatrix4;
-}
+	if (nodeIndex < 0 || nodeIndex >= (int)skin.jointIndicesByNode.size())
+		return -1;
 
+	return skin.jointIndicesByNode[nodeIndex];
+}
 
 //---------------------------------------------------------------------
-/*
-gLTFNode* gLTFImportOgreMeshCreator::findNodeByIndex (int nodeIndex)
+void gLTFImportOgreMeshCreator::decomposeBindPoses (void)
 {
-	std::map<int, gLTFNode>::iterator it = mNodesMap.find(nodeIndex);
-	if (it != mNodesMap.end())
+	/* Determine the bone pose matrix of each bone first (indexed by bone id), so the decomposition can be
+	 * done for all bones at once. The bind pose of a bone is the local transformation of its node; the
+	 * inverse bind matrices of the skin are not used.
+	 */
+	mHelperBindMatrices.clear();
+	mHelperBindMatrices.reserve(mSkeletonBones.size());
+	std::vector<SkeletonBone>::const_iterator itBones;
+	const gLTFNode* node;
+	for (itBones = mSkeletonBones.begin(); itBones != mSkeletonBones.end(); ++itBones)
 	{
-		// Found the node
-		return &(it->second);
+		node = getElementByIndex(mDocument->mNodes, itBones->nodeIndex);
+		mHelperBindMatrices.push_back(node ? node->mLocalTransformation : Ogre::Matrix4::IDENTITY);
 	}
 
-	return 0;
+	mBindPoses.resize(mHelperBindMatrices.size());
+	mThreadPool.parallelFor(mBindPoses.size(), [this](size_t i)
+	{
+		BindPose& bindPose = mBindPoses[i];
+		mHelperBindMatrices[i].decomposition(bindPose.position, bindPose.scale, bindPose.orientation);
+		bindPose.orientation.normalise();
+	});
 }
-*/
\ No newline at end of file
@@ -0,0 +1,107 @@
+/*
+  -----------------------------------------------------------------------------
+  This source file is part of OGRE
+  (Object-oriented Graphics Rendering Engine)
+  For the latest info, see http://www.ogre3d.org/
+
+  Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+  -----------------------------------------------------------------------------
+*/
+
+#include "gLTFImportOptions.h"
+
+typedef std::map<std::string, Ogre::HlmsEditorPluginData::PLUGIN_PROPERTY> PropertiesMap;
+
+//---------------------------------------------------------------------
+static void readProperty (const PropertiesMap& properties, const std::string& name, bool& value)
+{
+	PropertiesMap::const_iterator it = properties.find(name);
+	if (it != properties.end())
+		value = (it->second).boolValue;
+}
+
+//---------------------------------------------------------------------
+static void readProperty (const PropertiesMap& properties, const std::string& name, unsigned int& value)
+{
+	PropertiesMap::const_iterator it = properties.find(name);
+	if (it != properties.end())
+		value = (it->second).uintValue;
+}
+
+//---------------------------------------------------------------------
+static void readProperty (const PropertiesMap& properties, const std::string& name, float& value)
+{
+	PropertiesMap::const_iterator it = properties.find(name);
+	if (it != properties.end())
+		value = (it->second).floatValue;
+}
+
+//---------------------------------------------------------------------
+gLTFImportOptions::gLTFImportOptions (void) :
+	mMeshIsSubmesh(false),
+	mGenerateTangents(false),
+	mGenerateEdgeLists(false),
+	mOptimizeForDesktop(false),
+	mCorrectForMinMax(false),
+	mPruneVertexAttributes(false),
+	mSeparatePositionBuffer(false),
+	mImportMorphTargets(true),
+	mSplitPrimitiveTriangles(0),
+	mMergeStaticSubmeshes(false),
+	mMergeMaxVertices(65535),
+	mBoneWeightThreshold(0.0f),
+	mMaxBonesPerSubmesh(0),
+	mGenerateAnimation(false),
+	mOptimizeSkeleton(true),
+	mReduceKeyframes(false),
+	mKeyframePositionTolerance(0.0001f),
+	mKeyframeRotationTolerance(0.05f),
+	mKeyframeScaleTolerance(0.0001f),
+	mAnimationResampleRate(0)
+{
+}
+
+//---------------------------------------------------------------------
+void gLTFImportOptions::resolve (const Ogre::HlmsEditorPluginData* data)
+{
+	*this = gLTFImportOptions(); // Reset to the default values
+	const PropertiesMap& properties = data->mInPropertiesMap;
+	readProperty(properties, "mesh_is_submesh", mMeshIsSubmesh);
+	readProperty(properties, "generate_tangents", mGenerateTangents);
+	readProperty(properties, "generate_edge_lists", mGenerateEdgeLists);
+	readProperty(properties, "optimize_for_desktop", mOptimizeForDesktop);
+	readProperty(properties, "correct_min_max", mCorrectForMinMax);
+	readProperty(properties, "prune_vertex_attributes", mPruneVertexAttributes);
+	readProperty(properties, "separate_position_buffer", mSeparatePositionBuffer);
+	readProperty(properties, "import_morph_targets", mImportMorphTargets);
+	readProperty(properties, "split_primitive_triangles", mSplitPrimitiveTriangles);
+	readProperty(properties, "merge_static_submeshes", mMergeStaticSubmeshes);
+	readProperty(properties, "merge_max_vertices", mMergeMaxVertices);
+	readProperty(properties, "bone_weight_threshold", mBoneWeightThreshold);
+	readProperty(properties, "max_bones_per_submesh", mMaxBonesPerSubmesh);
+	readProperty(properties, "generate_animation", mGenerateAnimation);
+	readProperty(properties, "optimize_skeleton", mOptimizeSkeleton);
+	readProperty(properties, "reduce_keyframes", mReduceKeyframes);
+	readProperty(properties, "keyframe_position_tolerance", mKeyframePositionTolerance);
+	readProperty(properties, "keyframe_rotation_tolerance", mKeyframeRotationTolerance);
+	readProperty(properties, "keyframe_scale_tolerance", mKeyframeScaleTolerance);
+	readProperty(properties, "animation_resample_rate", mAnimationResampleRate);
+}
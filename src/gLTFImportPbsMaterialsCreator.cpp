@@ -31,10 +31,7 @@
 
 //---------------------------------------------------------------------
 bool gLTFImportPbsMaterialsCreator::createOgrePbsMaterialFiles(Ogre::HlmsEditorPluginData* data,
-	std::map<int, gLTFMaterial> materialsMap,
-	std::map<int, gLTFTexture> texturesMap,
-	std::map<int, gLTFImage> imagesMap,
-	std::map<int, gLTFSampler> samplersMap)
+	const gLTFDocument& document)
 {
 	OUT << "\nPerform gLTFImportPbsMaterialsCreator::createOgrePbsMaterialFiles\n";
 	OUT << "-----------------------------------------------------------------\n";
@@ -43,10 +40,10 @@ bool gLTFImportPbsMaterialsCreator::createOgrePbsMaterialFiles(Ogre::HlmsEditorP
 	std::string fullyQualifiedImportPath = data->mInImportPath + data->mInFileDialogBaseName + "/";
 
 	// Iterate through materials and create for each material an Ogre Pbs .material.json file
-	std::map<int, gLTFMaterial>::iterator it;
-	for (it = materialsMap.begin(); it != materialsMap.end(); it++)
+	std::vector<gLTFMaterial>::const_iterator it;
+	for (it = document.mMaterials.begin(); it != document.mMaterials.end(); it++)
 	{
-		const gLTFMaterial& material = it->second;
+		const gLTFMaterial& material = *it;
 		std::string ogreFullyQualifiedMaterialFileName = fullyQualifiedImportPath + material.mName + ".material.json";
 		OUT << "Create: material file " << ogreFullyQualifiedMaterialFileName << "\n";
 
@@ -57,19 +54,19 @@ bool gLTFImportPbsMaterialsCreator::createOgrePbsMaterialFiles(Ogre::HlmsEditorP
 		// ------------- SAMPLERS -------------
 		dst << TAB << "\"samplers\" :\n";
 		dst << TAB << "{\n";
-		createSamplerJsonBlock(&dst, it->second, samplersMap);
+		createSamplerJsonBlock(&dst, *it, document.mSamplers);
 		dst << TAB << "},\n";
 
 		// ------------- MACROBLOCKS -------------
 		dst << TAB << "\"macroblocks\" :\n";
 		dst << TAB << "{\n";
-		createMacroJsonBlock(&dst, it->second); // TODO: Pass extra arguments?
+		createMacroJsonBlock(&dst, *it); // TODO: Pass extra arguments?
 		dst << TAB << "},\n";
 
 		// ------------- BLENDBLOCKS -------------
 		dst << TAB << "\"blendblocks\" :\n";
 		dst << TAB << "{\n";
-		createBlendJsonBlock(&dst, it->second); // TODO: Pass extra arguments?
+		createBlendJsonBlock(&dst, *it); // TODO: Pass extra arguments?
 		dst << TAB << "},\n";
 
 		// ------------- PBS -------------
@@ -99,29 +96,29 @@ bool gLTFImportPbsMaterialsCreator::createOgrePbsMaterialFiles(Ogre::HlmsEditorP
 		dst << TABx3 << "\"two_sided\" : " << doubleSidedValue << ",\n";
 
 		// Transparency
-		createTransparencyJsonBlock(&dst, it->second);
+		createTransparencyJsonBlock(&dst, *it);
 
 		// 'textures'
 		if (material.mUseKHR_MaterialsPbrSpecularGlossiness)
 		{
-			createKHRDiffuseJsonBlock(&dst, it->second); // KHR extension
-			createKHRSpecularJsonBlock(&dst, it->second); // KHR extension, specular workflow
-			createKHRGlossinessJsonBlock(&dst, it->second); // KHR extension, specular workflow
+			createKHRDiffuseJsonBlock(&dst, *it); // KHR extension
+			createKHRSpecularJsonBlock(&dst, *it); // KHR extension, specular workflow
+			createKHRGlossinessJsonBlock(&dst, *it); // KHR extension, specular workflow
 		}
 		else
 		{
-			createDiffuseJsonBlock(&dst, it->second);
-			createSpecularJsonBlock(&dst, it->second); // Default, metallic workflow
-			createMetalnessJsonBlock(&dst, it->second); // Default, metallic workflow
-			createRoughnessJsonBlock(&dst, it->second); // Default, metallic workflow
+			createDiffuseJsonBlock(&dst, *it);
+			createSpecularJsonBlock(&dst, *it); // Default, metallic workflow
+			createMetalnessJsonBlock(&dst, *it); // Default, metallic workflow
+			createRoughnessJsonBlock(&dst, *it); // Default, metallic workflow
 		}
 
-		createNormalJsonBlock(&dst, it->second);
-		createReflectionJsonBlock(&dst, it->second);
-		createDetailDiffuseJsonBlock(&dst, it->second);
-		createDetailNormalJsonBlock(&dst, it->second);
-		createDetailWeightJsonBlock(&dst, it->second);
-		createEmissiveJsonBlock(&dst, it->second);
+		createNormalJsonBlock(&dst, *it);
+		createReflectionJsonBlock(&dst, *it);
+		createDetailDiffuseJsonBlock(&dst, *it);
+		createDetailNormalJsonBlock(&dst, *it);
+		createDetailWeightJsonBlock(&dst, *it);
+		createEmissiveJsonBlock(&dst, *it);
 
 		dst << "\n";
 		dst << TABx2 << "}\n";
@@ -146,18 +143,18 @@ bool gLTFImportPbsMaterialsCreator::createOgrePbsMaterialFiles(Ogre::HlmsEditorP
 //---------------------------------------------------------------------
 bool gLTFImportPbsMaterialsCreator::createSamplerJsonBlock (std::ofstream* dst, 
 	const gLTFMaterial& material,
-	std::map<int, gLTFSampler> samplersMap)
+	const std::vector<gLTFSampler>& samplers)
 {
 	bool samplerAdded = false;
-	if (samplersMap.size() > 0)
+	if (samplers.size() > 0)
 	{
-		std::map<int, gLTFSampler>::iterator it;
-		std::map<int, gLTFSampler>::iterator itEnd = samplersMap.end();
+		std::vector<gLTFSampler>::const_iterator it;
+		std::vector<gLTFSampler>::const_iterator itEnd = samplers.end();
 		gLTFSampler sampler;
 		int count = 0;
 		bool first = true;
 		std::string addressingMode = "wrap";
-		for (it = samplersMap.begin(); it != itEnd; ++it)
+		for (it = samplers.begin(); it != itEnd; ++it)
 		{
 			if (samplerInMaterial(count, material))
 			{
@@ -165,7 +162,7 @@ bool gLTFImportPbsMaterialsCreator::createSamplerJsonBlock (std::ofstream* dst,
 				{
 					*dst << ",\n";
 				}
-				sampler = it->second;
+				sampler = *it;
 				*dst << TABx2 << "\"Sampler_" << count << "\" :\n";
 				*dst << TABx2 << "{\n";
 				*dst << TABx3 << "\"min\" : \"anisotropic\",\n";
@@ -165,6 +165,126 @@ namespace Ogre
 		property.boolValue = false;
 		mProperties[property.propertyName] = property;
 
+		// Split large primitives
+		property.propertyName = "split_primitive_triangles";
+		property.labelName = "Split primitives (triangles per chunk)";
+		property.info = "Primitives with more triangles than this value are split into spatially coherent chunks (submeshes), so they\n.\
+						 can be culled individually. Each chunk has at most this number of triangles. Use 0 to disable splitting.";
+		property.type = HlmsEditorPluginData::UINT;
+		property.uintValue = 0;
+		mProperties[property.propertyName] = property;
+
+		// Merge static submeshes
+		property.propertyName = "merge_static_submeshes";
+		property.labelName = "Merge static submeshes per material";
+		property.info = "Only used if all meshes are combined into one mesh. Submeshes without skinning that share the same material\n.\
+						 are merged into one submesh, which reduces the number of draw calls.";
+		property.type = HlmsEditorPluginData::BOOL;
+		property.boolValue = false;
+		mProperties[property.propertyName] = property;
+
+		// Maximum vertices of a merged submesh
+		property.propertyName = "merge_max_vertices";
+		property.labelName = "Maximum vertices per merged submesh";
+		property.info = "A merged submesh does not get more vertices than this value. Use 65535 to keep 16 bit indices and 0 for no limit.";
+		property.type = HlmsEditorPluginData::UINT;
+		property.uintValue = 65535;
+		mProperties[property.propertyName] = property;
+
+		// Prune vertex attributes
+		property.propertyName = "prune_vertex_attributes";
+		property.labelName = "Remove vertex attributes not used by the material";
+		property.info = "Second uv set, tangents and vertex colours are not read if the material of the primitive does not use them.\n.\
+						 The number of bytes saved is written to the report.";
+		property.type = HlmsEditorPluginData::BOOL;
+		property.boolValue = false;
+		mProperties[property.propertyName] = property;
+
+		// Maximum bones per submesh
+		property.propertyName = "max_bones_per_submesh";
+		property.labelName = "Maximum bones per skinned submesh";
+		property.info = "Skinned submeshes that reference more bones are split into partitions that each reference at most this number\n.\
+						 of bones. Use 0 to keep the submeshes unchanged.";
+		property.type = HlmsEditorPluginData::UINT;
+		property.uintValue = 0;
+		mProperties[property.propertyName] = property;
+
+		// Bone weight threshold
+		property.propertyName = "bone_weight_threshold";
+		property.labelName = "Minimum bone weight";
+		property.info = "Bone influences with a lower weight (0 - 1, relative to the total weight of the vertex) are removed.\n.\
+						 Each vertex keeps its 4 most important influences (also from JOINTS_1/WEIGHTS_1) and the weights are renormalized.";
+		property.type = HlmsEditorPluginData::FLOAT;
+		property.floatValue = 0.0f;
+		mProperties[property.propertyName] = property;
+
+		// Separate position buffer
+		property.propertyName = "separate_position_buffer";
+		property.labelName = "Write positions to a separate vertex buffer";
+		property.info = "Triangle submeshes get a vertex buffer with only the positions (source 0) and a vertex buffer with all other attributes\n.\
+						 (source 1). Depth and shadow passes then only fetch the positions.";
+		property.type = HlmsEditorPluginData::BOOL;
+		property.boolValue = false;
+		mProperties[property.propertyName] = property;
+
+		// Morph targets
+		property.propertyName = "import_morph_targets";
+		property.labelName = "Import morph targets as poses";
+		property.info = "Morph targets become poses that only contain the displaced vertices. Animated morph weights become pose\n.\
+						 animations; default weights that are not animated are applied to the vertices.";
+		property.type = HlmsEditorPluginData::BOOL;
+		property.boolValue = true;
+		mProperties[property.propertyName] = property;
+
+		// Resampling
+		property.propertyName = "animation_resample_rate";
+		property.labelName = "Resample skeleton animations (keyframes per second)";
+		property.info = "If not 0, the skeleton animations are sampled at a fixed rate (e.g. 30) using the interpolation of the gLTF\n.\
+						 channels (LINEAR, STEP or CUBICSPLINE). Ogre interpolates linearly, so STEP and CUBICSPLINE channels\n.\
+						 are only reproduced between the original keyframes when they are resampled.";
+		property.type = HlmsEditorPluginData::UINT;
+		property.uintValue = 0;
+		mProperties[property.propertyName] = property;
+
+		// Keyframe reduction
+		property.propertyName = "reduce_keyframes";
+		property.labelName = "Reduce keyframes of skeleton animations";
+		property.info = "Removes keyframes that can be rebuilt by interpolating the remaining keyframes within the tolerances below,\n.\
+						 and removes bone tracks that never leave the bind pose. Useful for sampled (motion capture) animations.";
+		property.type = HlmsEditorPluginData::BOOL;
+		property.boolValue = false;
+		mProperties[property.propertyName] = property;
+
+		property.propertyName = "keyframe_position_tolerance";
+		property.labelName = "Keyframe reduction: position tolerance";
+		property.info = "Maximum position error (in model units) of a removed keyframe.";
+		property.type = HlmsEditorPluginData::FLOAT;
+		property.floatValue = 0.0001f;
+		mProperties[property.propertyName] = property;
+
+		property.propertyName = "keyframe_rotation_tolerance";
+		property.labelName = "Keyframe reduction: rotation tolerance";
+		property.info = "Maximum rotation error (in degrees) of a removed keyframe.";
+		property.type = HlmsEditorPluginData::FLOAT;
+		property.floatValue = 0.05f;
+		mProperties[property.propertyName] = property;
+
+		property.propertyName = "keyframe_scale_tolerance";
+		property.labelName = "Keyframe reduction: scale tolerance";
+		property.info = "Maximum scale error of a removed keyframe.";
+		property.type = HlmsEditorPluginData::FLOAT;
+		property.floatValue = 0.0001f;
+		mProperties[property.propertyName] = property;
+
+		// Skeleton optimization
+		property.propertyName = "optimize_skeleton";
+		property.labelName = "Prune unweighted joints from the skeleton";
+		property.info = "Removes joints (and their animation tracks) that do not influence any vertex and have no weighted\n.\
+						 child joint. Joints that are shared by more skins are always written as one bone.";
+		property.type = HlmsEditorPluginData::BOOL;
+		property.boolValue = true;
+		mProperties[property.propertyName] = property;
+
 		return mProperties;
 	}
 
@@ -0,0 +1,307 @@
+/*
+  -----------------------------------------------------------------------------
+  This source file is part of OGRE
+  (Object-oriented Graphics Rendering Engine)
+  For the latest info, see http://www.ogre3d.org/
+
+  Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+  -----------------------------------------------------------------------------
+*/
+
+#include "gLTFImportPoseBuilder.h"
+#include <algorithm>
+
+//---------------------------------------------------------------------
+void gLTFImportPoseBuilder::clear (void)
+{
+	mStagedTargets.clear();
+	mStagedNodeIndex = -1;
+	mStagedMeshIndex = -1;
+	mStagedName = "";
+	mPoses.clear();
+}
+
+//---------------------------------------------------------------------
+void gLTFImportPoseBuilder::beginStagedTargets (int nodeIndex, int meshIndex, const std::string& name)
+{
+	mStagedTargets.clear();
+	mStagedNodeIndex = nodeIndex;
+	mStagedMeshIndex = meshIndex;
+	mStagedName = name;
+}
+
+//---------------------------------------------------------------------
+void gLTFImportPoseBuilder::addStagedTarget (const float* positions, const float* normals, size_t vertexCount)
+{
+	mStagedTargets.push_back(SparseTarget());
+	SparseTarget& target = mStagedTargets.back();
+	if (!positions)
+		return; // Target without displacements
+
+	findNonZeroVertices(positions, normals, vertexCount, target.vertices);
+
+	// Gather the displacements of the non-zero vertices (SoA)
+	size_t count = target.vertices.size();
+	target.positionsX.resize(count);
+	target.positionsY.resize(count);
+	target.positionsZ.resize(count);
+	if (normals)
+	{
+		target.normalsX.resize(count);
+		target.normalsY.resize(count);
+		target.normalsZ.resize(count);
+	}
+
+	const float* p;
+	const float* n;
+	for (size_t i = 0; i < count; ++i)
+	{
+		p = positions + 3 * target.vertices[i];
+		target.positionsX[i] = p[0];
+		target.positionsY[i] = p[1];
+		target.positionsZ[i] = p[2];
+		if (normals)
+		{
+			n = normals + 3 * target.vertices[i];
+			target.normalsX[i] = n[0];
+			target.normalsY[i] = n[1];
+			target.normalsZ[i] = n[2];
+		}
+	}
+}
+
+//---------------------------------------------------------------------
+void gLTFImportPoseBuilder::findNonZeroVertices (const float* a, const float* b, size_t vertexCount, std::vector<unsigned int>& vertices)
+{
+	vertices.clear();
+	size_t i = 0;
+
+#ifdef GLTF_IMPORT_SSE2
+	/* Compare 4 vertices (12 floats) at a time. The 3 compare masks are combined into one 12 bit mask, in which
+	 * vertex k occupies bits 3k .. 3k+2. Negative zero compares equal to zero, so it is not regarded as displacement.
+	 */
+	const __m128 zero = _mm_setzero_ps();
+	unsigned int mask;
+	const float* pa;
+	const float* pb;
+	for (; i + 4 <= vertexCount; i += 4)
+	{
+		pa = a + 3 * i;
+		mask = _mm_movemask_ps(_mm_cmpneq_ps(_mm_loadu_ps(pa), zero)) |
+			(_mm_movemask_ps(_mm_cmpneq_ps(_mm_loadu_ps(pa + 4), zero)) << 4) |
+			(_mm_movemask_ps(_mm_cmpneq_ps(_mm_loadu_ps(pa + 8), zero)) << 8);
+		if (b)
+		{
+			pb = b + 3 * i;
+			mask |= _mm_movemask_ps(_mm_cmpneq_ps(_mm_loadu_ps(pb), zero)) |
+				(_mm_movemask_ps(_mm_cmpneq_ps(_mm_loadu_ps(pb + 4), zero)) << 4) |
+				(_mm_movemask_ps(_mm_cmpneq_ps(_mm_loadu_ps(pb + 8), zero)) << 8);
+		}
+
+		// Most vertices of a facial target are not displaced
+		if (mask == 0)
+			continue;
+
+		for (unsigned int k = 0; k < 4; ++k)
+			if ((mask >> (3 * k)) & 7)
+				vertices.push_back(static_cast<unsigned int>(i + k));
+	}
+#endif
+
+	// Remaining vertices (or all vertices if SSE2 is not available)
+	const float* p;
+	for (; i < vertexCount; ++i)
+	{
+		p = a + 3 * i;
+		if (p[0] != 0.0f || p[1] != 0.0f || p[2] != 0.0f)
+		{
+			vertices.push_back(static_cast<unsigned int>(i));
+			continue;
+		}
+		if (b)
+		{
+			p = b + 3 * i;
+			if (p[0] != 0.0f || p[1] != 0.0f || p[2] != 0.0f)
+				vertices.push_back(static_cast<unsigned int>(i));
+		}
+	}
+}
+
+//---------------------------------------------------------------------
+void gLTFImportPoseBuilder::transformStagedTargets (const Ogre::Matrix4& matrix)
+{
+	// Displacements are directions; use the upper 3x3 only
+	Ogre::Matrix4 linear = matrix;
+	linear[0][3] = 0.0f;
+	linear[1][3] = 0.0f;
+	linear[2][3] = 0.0f;
+
+	/* Normal displacements use the inverse-transpose, but are not renormalized (unlike the normals themselves), 
+	 * because they are differences. If the matrix is singular, they are left untouched.
+	 */
+	Ogre::Matrix3 linear3;
+	Ogre::Matrix3 inverse;
+	matrix.extract3x3Matrix(linear3);
+	bool transformNormals = linear3.Inverse(inverse);
+	Ogre::Matrix3 inverseTranspose = inverse.Transpose();
+	Ogre::Matrix4 normalMatrix = Ogre::Matrix4::IDENTITY;
+	for (size_t row = 0; row < 3; ++row)
+		for (size_t column = 0; column < 3; ++column)
+			normalMatrix[row][column] = inverseTranspose[row][column];
+
+	std::vector<SparseTarget>::iterator it;
+	std::vector<SparseTarget>::iterator itEnd = mStagedTargets.end();
+	size_t count;
+	for (it = mStagedTargets.begin(); it != itEnd; ++it)
+	{
+		count = it->vertices.size();
+		if (count == 0)
+			continue;
+
+		mVertexTransformer.transformPositions(&it->positionsX[0], &it->positionsY[0], &it->positionsZ[0], count, linear);
+		if (transformNormals && !it->normalsX.empty())
+			mVertexTransformer.transformPositions(&it->normalsX[0], &it->normalsY[0], &it->normalsZ[0], count, normalMatrix);
+	}
+}
+
+//---------------------------------------------------------------------
+int gLTFImportPoseBuilder::findTargetVertex (const SparseTarget& target, unsigned int sourceVertexIndex) const
+{
+	std::vector<unsigned int>::const_iterator it = std::lower_bound(target.vertices.begin(), target.vertices.end(), sourceVertexIndex);
+	if (it == target.vertices.end() || *it != sourceVertexIndex)
+		return -1;
+
+	return static_cast<int>(it - target.vertices.begin());
+}
+
+//---------------------------------------------------------------------
+void gLTFImportPoseBuilder::applyStagedTargets (gLTFStagedSubmesh& submesh, const std::vector<float>& weights)
+{
+	unsigned int vertexCount = submesh.getVertexCount();
+	bool hasNormals = submesh.mNormalsX.size() == vertexCount;
+	size_t targetCount = std::min(weights.size(), mStagedTargets.size());
+	float weight;
+	int index;
+	for (size_t t = 0; t < targetCount; ++t)
+	{
+		weight = weights[t];
+		const SparseTarget& target = mStagedTargets[t];
+		if (weight == 0.0f || target.vertices.empty())
+			continue;
+
+		for (unsigned int i = 0; i < vertexCount; ++i)
+		{
+			index = findTargetVertex(target, submesh.getSourceVertexIndex(i));
+			if (index < 0)
+				continue;
+
+			submesh.mPositionsX[i] += weight * target.positionsX[index];
+			submesh.mPositionsY[i] += weight * target.positionsY[index];
+			submesh.mPositionsZ[i] += weight * target.positionsZ[index];
+			if (hasNormals && !target.normalsX.empty())
+			{
+				submesh.mNormalsX[i] += weight * target.normalsX[index];
+				submesh.mNormalsY[i] += weight * target.normalsY[index];
+				submesh.mNormalsZ[i] += weight * target.normalsZ[index];
+			}
+		}
+	}
+}
+
+//---------------------------------------------------------------------
+void gLTFImportPoseBuilder::addPoses (const gLTFStagedSubmesh& submesh, unsigned int submeshIndex)
+{
+	unsigned int vertexCount = submesh.getVertexCount();
+	unsigned int targetIndex = 0;
+	int index;
+	std::vector<SparseTarget>::const_iterator it;
+	std::vector<SparseTarget>::const_iterator itEnd = mStagedTargets.end();
+	for (it = mStagedTargets.begin(); it != itEnd; ++it, ++targetIndex)
+	{
+		mPoses.push_back(Pose());
+		Pose& pose = mPoses.back();
+		pose.submeshIndex = submeshIndex;
+		pose.nodeIndex = mStagedNodeIndex;
+		pose.meshIndex = mStagedMeshIndex;
+		pose.targetIndex = targetIndex;
+		pose.name = mStagedName + "_" + std::to_string(submeshIndex) + "_" + std::to_string(targetIndex);
+		if (it->vertices.empty())
+			continue;
+
+		/* The submesh can be a split chunk or a partition of the primitive, and a gLTF vertex can be duplicated (e.g.
+		 * point expansion), so iterate over the submesh vertices and look up their displacement.
+		 */
+		bool hasNormals = !it->normalsX.empty();
+		for (unsigned int i = 0; i < vertexCount; ++i)
+		{
+			index = findTargetVertex(*it, submesh.getSourceVertexIndex(i));
+			if (index < 0)
+				continue;
+
+			pose.vertices.push_back(i);
+			pose.positions.push_back(it->positionsX[index]);
+			pose.positions.push_back(it->positionsY[index]);
+			pose.positions.push_back(it->positionsZ[index]);
+			if (hasNormals)
+			{
+				pose.normals.push_back(it->normalsX[index]);
+				pose.normals.push_back(it->normalsY[index]);
+				pose.normals.push_back(it->normalsZ[index]);
+			}
+		}
+	}
+}
+
+//---------------------------------------------------------------------
+bool gLTFImportPoseBuilder::writePosesToMesh (std::ofstream& dst)
+{
+	if (mPoses.empty())
+		return false;
+
+	dst << TAB << "<poses>\n";
+	std::vector<Pose>::const_iterator it;
+	std::vector<Pose>::const_iterator itEnd = mPoses.end();
+	size_t count;
+	for (it = mPoses.begin(); it != itEnd; ++it)
+	{
+		dst << TABx2 << "<pose target=\"submesh\" index=\"" << it->submeshIndex << "\" name=\"" << it->name << "\">\n";
+		count = it->vertices.size();
+		bool hasNormals = it->normals.size() == 3 * count;
+		for (size_t i = 0; i < count; ++i)
+		{
+			dst << TABx3 << "<poseoffset index=\"" << it->vertices[i] <<
+				"\" x=\"" << it->positions[3 * i] <<
+				"\" y=\"" << it->positions[3 * i + 1] <<
+				"\" z=\"" << it->positions[3 * i + 2];
+			if (hasNormals)
+			{
+				dst << "\" nx=\"" << it->normals[3 * i] <<
+					"\" ny=\"" << it->normals[3 * i + 1] <<
+					"\" nz=\"" << it->normals[3 * i + 2];
+			}
+			dst << "\" />\n";
+		}
+		dst << TABx2 << "</pose>\n";
+	}
+	dst << TAB << "</poses>\n";
+
+	return true;
+}
@@ -34,7 +34,7 @@ bool gLTFImportPrimitivesParser::parsePrimitives (rapidjson::Value::ConstMemberI
 	OUT << TABx3 << "Perform gLTFImportPrimitivesParser::parsePrimitives\n";
 
 	int index = 0;
-	mPrimitivesMap.clear();
+	mPrimitives.clear();
 	const rapidjson::Value& array = jsonIterator->value;
 
 	OUT << TABx4 << "Loop through primitives array\n";
@@ -129,12 +129,32 @@ bool gLTFImportPrimitivesParser::parsePrimitives (rapidjson::Value::ConstMemberI
 			if (it->value.IsArray() && key == "targets")
 			{
 				// ******** 5. targets ********
-				// TODO: Parse through 'targets' object
+				// Each morph target is an object with the accessors of the displacements (POSITION, NORMAL, TANGENT)
+				OUT << TABx4 << "Loop through targets\n";
+				const rapidjson::Value& targetsArray = it->value;
+				for (rapidjson::SizeType j = 0; j < targetsArray.Size(); j++)
+				{
+					std::map<std::string, int> target;
+					if (targetsArray[j].IsObject())
+					{
+						rapidjson::Value::ConstMemberIterator itTarget;
+						for (itTarget = targetsArray[j].MemberBegin(); itTarget != targetsArray[j].MemberEnd(); ++itTarget)
+						{
+							if (itTarget->value.IsInt())
+							{
+								target[std::string(itTarget->name.GetString())] = itTarget->value.GetInt();
+								OUT << TABx4 << "key target " << j << " ==> " << itTarget->name.GetString() << 
+									", value ==> " << itTarget->value.GetInt() << "\n";
+							}
+						}
+					}
+					primitive.mTargets.push_back(target);
+				}
 			}
 		}
 		
 		primitive.mPrimitiveIndex = index;
-		mPrimitivesMap[index] = primitive;
+		mPrimitives.push_back(primitive);
 		++index;
 	}
 
@@ -142,7 +162,8 @@ bool gLTFImportPrimitivesParser::parsePrimitives (rapidjson::Value::ConstMemberI
 }
 
 //---------------------------------------------------------------------
-const std::map<int, gLTFPrimitive> gLTFImportPrimitivesParser::getParsedPrimitives (void) const
+void gLTFImportPrimitivesParser::takeParsedPrimitives (std::vector<gLTFPrimitive>& primitives)
 {
-	return mPrimitivesMap;
+	primitives.swap(mPrimitives);
+	mPrimitives.clear();
 }
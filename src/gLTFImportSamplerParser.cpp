@@ -34,6 +34,7 @@ bool gLTFImportSamplersParser::parseSamplers (rapidjson::Value::ConstMemberItera
 	OUT << TAB << "Perform gLTFImportSamplersParser::parseSamplers\n";
 
 	int source = 0;
+	mSamplers.clear();
 	const rapidjson::Value& array = jsonIterator->value;
 
 	OUT << TAB << "Loop through samplers array\n";
@@ -79,7 +80,7 @@ bool gLTFImportSamplersParser::parseSamplers (rapidjson::Value::ConstMemberItera
 			}
 		}
 		
-		mSamplersMap[source] = sampler;
+		mSamplers.push_back(sampler);
 		++source;
 	}
 
@@ -87,7 +88,8 @@ bool gLTFImportSamplersParser::parseSamplers (rapidjson::Value::ConstMemberItera
 }
 
 //---------------------------------------------------------------------
-const std::map<int, gLTFSampler> gLTFImportSamplersParser::getParsedSamplers (void) const
+void gLTFImportSamplersParser::takeParsedSamplers (std::vector<gLTFSampler>& samplers)
 {
-	return mSamplersMap;
+	samplers.swap(mSamplers);
+	mSamplers.clear();
 }
@@ -34,6 +34,7 @@ bool gLTFImportSkinsParser::parseSkins (rapidjson::Value::ConstMemberIterator js
 	OUT << TAB << "Perform gLTFImportSkinsParser::parseSkins\n";
 
 	int index = 0;
+	mSkins.clear();
 	const rapidjson::Value& array = jsonIterator->value;
 
 	OUT << TAB << "Loop through Skins array\n";
@@ -71,8 +72,8 @@ bool gLTFImportSkinsParser::parseSkins (rapidjson::Value::ConstMemberIterator js
 				{
 					if (jointsArray[iJoint].IsInt())
 					{
-						skin.mJoints[iJoint] = jointsArray[iJoint].GetInt();
-						OUT << TABx2 << "value ==> " << skin.mJoints[iJoint] << "\n";
+						skin.mJoints.push_back(jointsArray[iJoint].GetInt());
+						OUT << TABx2 << "value ==> " << skin.mJoints.back() << "\n";
 					}
 				}
 			}
@@ -91,7 +92,7 @@ bool gLTFImportSkinsParser::parseSkins (rapidjson::Value::ConstMemberIterator js
 			ss << "Animation_" << index;
 			skin.mName = ss.str();
 		}
-		mSkinsMap[index] = skin;
+		mSkins.push_back(skin);
 		++index;
 	}
 
@@ -99,7 +100,8 @@ bool gLTFImportSkinsParser::parseSkins (rapidjson::Value::ConstMemberIterator js
 }
 
 //---------------------------------------------------------------------
-const std::map<int, gLTFSkin> gLTFImportSkinsParser::getParsedSkins(void) const
+void gLTFImportSkinsParser::takeParsedSkins(std::vector<gLTFSkin>& skins)
 {
-	return mSkinsMap;
+	skins.swap(mSkins);
+	mSkins.clear();
 }
@@ -0,0 +1,212 @@
+/*
+  -----------------------------------------------------------------------------
+  This source file is part of OGRE
+  (Object-oriented Graphics Rendering Engine)
+  For the latest info, see http://www.ogre3d.org/
+
+  Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+  -----------------------------------------------------------------------------
+*/
+
+#include <algorithm>
+#include "gLTFImportSpatialSplitter.h"
+#include "gLTFPrimitive.h"
+
+//---------------------------------------------------------------------
+template <typename T> static void gatherChunkAttribute (std::vector<T>& destination, 
+	const std::vector<T>& source,
+	const std::vector<unsigned int>& vertices)
+{
+	destination.clear();
+	if (source.empty())
+		return;
+
+	size_t count = vertices.size();
+	destination.resize(count);
+	for (size_t i = 0; i < count; ++i)
+		destination[i] = source[vertices[i]];
+}
+
+//---------------------------------------------------------------------
+bool gLTFImportSpatialSplitter::split (const gLTFStagedSubmesh& submesh,
+	unsigned int targetTriangleCount,
+	gLTFImportThreadPool& threadPool,
+	std::vector<gLTFStagedSubmesh>& chunks)
+{
+	chunks.clear();
+	if (submesh.mMode != gLTFPrimitive::TRIANGLES || !submesh.mHasIndices || targetTriangleCount == 0)
+		return false;
+
+	size_t triangleCount = submesh.mIndices.size() / 3;
+	if (triangleCount <= targetTriangleCount)
+		return false;
+
+	// Determine the centroids of all triangles (the sum of the corners is sufficient to compare them)
+	mHelperTriangles.resize(triangleCount);
+	mHelperCentroids.resize(triangleCount * 3);
+	const unsigned int* indices = &submesh.mIndices[0];
+	unsigned int v0, v1, v2;
+	for (size_t t = 0; t < triangleCount; ++t)
+	{
+		v0 = indices[t * 3];
+		v1 = indices[t * 3 + 1];
+		v2 = indices[t * 3 + 2];
+		mHelperTriangles[t] = (unsigned int)t;
+		mHelperCentroids[t * 3] = submesh.mPositionsX[v0] + submesh.mPositionsX[v1] + submesh.mPositionsX[v2];
+		mHelperCentroids[t * 3 + 1] = submesh.mPositionsY[v0] + submesh.mPositionsY[v1] + submesh.mPositionsY[v2];
+		mHelperCentroids[t * 3 + 2] = submesh.mPositionsZ[v0] + submesh.mPositionsZ[v1] + submesh.mPositionsZ[v2];
+	}
+
+	// Create the ranges (leaves of the BVH)
+	mHelperRanges.clear();
+	partition(0, triangleCount, targetTriangleCount);
+
+	createChunks(submesh, mHelperTriangles, mHelperRanges, threadPool, chunks);
+
+	OUT << TABx3 << "Split " << triangleCount << " triangles into " << chunks.size() << " chunks\n";
+	return true;
+}
+
+//---------------------------------------------------------------------
+void gLTFImportSpatialSplitter::createChunks (const gLTFStagedSubmesh& submesh,
+	const std::vector<unsigned int>& triangles,
+	const std::vector<Range>& ranges,
+	gLTFImportThreadPool& threadPool,
+	std::vector<gLTFStagedSubmesh>& chunks)
+{
+	// Create the chunks in parallel; each chunk only reads the submesh and writes its own chunk
+	chunks.resize(ranges.size());
+	threadPool.parallelFor(ranges.size(), [this, &submesh, &triangles, &ranges, &chunks](size_t i)
+	{
+		createChunk(submesh, &triangles[ranges[i].begin], ranges[i].end - ranges[i].begin, chunks[i]);
+	});
+}
+
+//---------------------------------------------------------------------
+void gLTFImportSpatialSplitter::partition (size_t begin, size_t end, unsigned int targetTriangleCount)
+{
+	if (end - begin <= targetTriangleCount)
+	{
+		Range range;
+		range.begin = begin;
+		range.end = end;
+		mHelperRanges.push_back(range);
+		return;
+	}
+
+	// Determine the extent of the centroids and split along the longest axis
+	float min[3] = { mHelperCentroids[mHelperTriangles[begin] * 3], mHelperCentroids[mHelperTriangles[begin] * 3 + 1], mHelperCentroids[mHelperTriangles[begin] * 3 + 2] };
+	float max[3] = { min[0], min[1], min[2] };
+	const float* centroid;
+	for (size_t i = begin + 1; i < end; ++i)
+	{
+		centroid = &mHelperCentroids[mHelperTriangles[i] * 3];
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			min[axis] = centroid[axis] < min[axis] ? centroid[axis] : min[axis];
+			max[axis] = centroid[axis] > max[axis] ? centroid[axis] : max[axis];
+		}
+	}
+	int splitAxis = 0;
+	if (max[1] - min[1] > max[splitAxis] - min[splitAxis])
+		splitAxis = 1;
+	if (max[2] - min[2] > max[splitAxis] - min[splitAxis])
+		splitAxis = 2;
+
+	// Median split; this keeps the chunks balanced, even if the triangles are not evenly distributed
+	size_t middle = begin + (end - begin) / 2;
+	const std::vector<float>& centroids = mHelperCentroids;
+	std::nth_element(mHelperTriangles.begin() + begin, 
+		mHelperTriangles.begin() + middle, 
+		mHelperTriangles.begin() + end,
+		[&centroids, splitAxis](unsigned int a, unsigned int b)
+		{
+			return centroids[a * 3 + splitAxis] < centroids[b * 3 + splitAxis];
+		});
+
+	partition(begin, middle, targetTriangleCount);
+	partition(middle, end, targetTriangleCount);
+}
+
+//---------------------------------------------------------------------
+void gLTFImportSpatialSplitter::createChunk (const gLTFStagedSubmesh& submesh, 
+	const unsigned int* triangles, 
+	size_t triangleCount, 
+	gLTFStagedSubmesh& chunk)
+{
+	chunk.clear();
+	chunk.mMode = gLTFPrimitive::TRIANGLES;
+	chunk.mHasIndices = true;
+
+	// Gather the indices of the triangles
+	chunk.mIndices.resize(triangleCount * 3);
+	unsigned int triangle;
+	for (size_t t = 0; t < triangleCount; ++t)
+	{
+		triangle = triangles[t];
+		chunk.mIndices[t * 3] = submesh.mIndices[triangle * 3];
+		chunk.mIndices[t * 3 + 1] = submesh.mIndices[triangle * 3 + 1];
+		chunk.mIndices[t * 3 + 2] = submesh.mIndices[triangle * 3 + 2];
+	}
+
+	// The referenced vertices, in increasing order (keeps the original vertex order within the chunk)
+	std::vector<unsigned int> vertices(chunk.mIndices);
+	std::sort(vertices.begin(), vertices.end());
+	vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+
+	// Remap the indices into the compacted vertex range
+	std::vector<unsigned int>::iterator itIndex;
+	for (itIndex = chunk.mIndices.begin(); itIndex != chunk.mIndices.end(); ++itIndex)
+		*itIndex = (unsigned int)(std::lower_bound(vertices.begin(), vertices.end(), *itIndex) - vertices.begin());
+
+	// Copy the vertex attributes
+	gatherChunkAttribute(chunk.mPositionsX, submesh.mPositionsX, vertices);
+	gatherChunkAttribute(chunk.mPositionsY, submesh.mPositionsY, vertices);
+	gatherChunkAttribute(chunk.mPositionsZ, submesh.mPositionsZ, vertices);
+	gatherChunkAttribute(chunk.mNormalsX, submesh.mNormalsX, vertices);
+	gatherChunkAttribute(chunk.mNormalsY, submesh.mNormalsY, vertices);
+	gatherChunkAttribute(chunk.mNormalsZ, submesh.mNormalsZ, vertices);
+	gatherChunkAttribute(chunk.mTangentsX, submesh.mTangentsX, vertices);
+	gatherChunkAttribute(chunk.mTangentsY, submesh.mTangentsY, vertices);
+	gatherChunkAttribute(chunk.mTangentsZ, submesh.mTangentsZ, vertices);
+	gatherChunkAttribute(chunk.mTangentsW, submesh.mTangentsW, vertices);
+	gatherChunkAttribute(chunk.mColours, submesh.mColours, vertices);
+	gatherChunkAttribute(chunk.mTexcoords_0, submesh.mTexcoords_0, vertices);
+	gatherChunkAttribute(chunk.mTexcoords_1, submesh.mTexcoords_1, vertices);
+	gatherChunkAttribute(chunk.mBoneInfluences, submesh.mBoneInfluences, vertices);
+
+	// Keep the relation with the gLTF vertices (needed for the bone assignments)
+	size_t vertexCount = vertices.size();
+	chunk.mSourceVertexIndices.resize(vertexCount);
+	for (size_t i = 0; i < vertexCount; ++i)
+		chunk.mSourceVertexIndices[i] = submesh.getSourceVertexIndex(vertices[i]);
+
+	// Bounds of the chunk
+	gLTFStagedSubmesh::Bounds& bounds = chunk.mBounds;
+	bounds.valid = mVertexTransformer.computeMinMax(&chunk.mPositionsX[0],
+		&chunk.mPositionsY[0],
+		&chunk.mPositionsZ[0],
+		vertexCount,
+		bounds.min,
+		bounds.max);
+	bounds.center = (bounds.min + bounds.max) * 0.5f;
+	bounds.radius = (bounds.max - bounds.min).length() * 0.5f;
+}
@@ -34,6 +34,7 @@ bool gLTFImportTexturesParser::parseTextures (rapidjson::Value::ConstMemberItera
 	OUT << TAB << "Perform gLTFImportTexturesParser::parseTextures\n";
 
 	int index = 0;
+	mTextures.clear();
 	const rapidjson::Value& array = jsonIterator->value;
 
 	OUT << TAB << "Loop through textures array\n";
@@ -62,7 +63,7 @@ bool gLTFImportTexturesParser::parseTextures (rapidjson::Value::ConstMemberItera
 			}
 		}
 	
-		mTexturesMap[index] = texture;
+		mTextures.push_back(texture);
 		++index;
 	}
 
@@ -71,7 +72,8 @@ bool gLTFImportTexturesParser::parseTextures (rapidjson::Value::ConstMemberItera
 
 
 //---------------------------------------------------------------------
-const std::map<int, gLTFTexture> gLTFImportTexturesParser::getParsedTextures (void) const
+void gLTFImportTexturesParser::takeParsedTextures (std::vector<gLTFTexture>& textures)
 {
-	return mTexturesMap;
+	textures.swap(mTextures);
+	mTextures.clear();
 }
@@ -0,0 +1,143 @@
+/*
+  -----------------------------------------------------------------------------
+  This source file is part of OGRE
+  (Object-oriented Graphics Rendering Engine)
+  For the latest info, see http://www.ogre3d.org/
+
+  Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+  -----------------------------------------------------------------------------
+*/
+
+#include "gLTFImportThreadPool.h"
+
+//---------------------------------------------------------------------
+gLTFImportThreadPool::gLTFImportThreadPool (unsigned int threadCount) :
+	mThreadCount(threadCount),
+	mTask(0),
+	mTaskCount(0),
+	mNextTask(0),
+	mBusyWorkers(0),
+	mGeneration(0),
+	mStop(false)
+{
+	if (mThreadCount == 0)
+		mThreadCount = std::thread::hardware_concurrency();
+	if (mThreadCount == 0)
+		mThreadCount = 1;
+}
+
+//---------------------------------------------------------------------
+gLTFImportThreadPool::~gLTFImportThreadPool (void)
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mStop = true;
+	}
+	mJobAvailable.notify_all();
+
+	std::vector<std::thread>::iterator it;
+	for (it = mWorkers.begin(); it != mWorkers.end(); ++it)
+		it->join();
+}
+
+//---------------------------------------------------------------------
+unsigned int gLTFImportThreadPool::getThreadCount (void) const
+{
+	return mThreadCount;
+}
+
+//---------------------------------------------------------------------
+void gLTFImportThreadPool::parallelFor (size_t count, const std::function<void (size_t)>& task)
+{
+	if (count == 0)
+		return;
+
+	// Not worth to wake up the workers
+	if (count == 1 || mThreadCount == 1)
+	{
+		for (size_t i = 0; i < count; ++i)
+			task(i);
+		return;
+	}
+
+	if (mWorkers.empty())
+		startWorkers();
+
+	// Publish the job
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mTask = &task;
+		mTaskCount = count;
+		mNextTask = 0;
+		mBusyWorkers = (unsigned int)mWorkers.size();
+		++mGeneration;
+	}
+	mJobAvailable.notify_all();
+
+	// The calling thread helps
+	runTasks();
+
+	// Wait until all workers are done with this job
+	std::unique_lock<std::mutex> lock(mMutex);
+	mJobFinished.wait(lock, [this] { return mBusyWorkers == 0; });
+	mTask = 0;
+}
+
+//---------------------------------------------------------------------
+void gLTFImportThreadPool::startWorkers (void)
+{
+	// The calling thread is one of the threads
+	for (unsigned int i = 1; i < mThreadCount; ++i)
+		mWorkers.push_back(std::thread(&gLTFImportThreadPool::workerLoop, this));
+}
+
+//---------------------------------------------------------------------
+void gLTFImportThreadPool::workerLoop (void)
+{
+	unsigned int generation = 0;
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			mJobAvailable.wait(lock, [this, generation] { return mStop || mGeneration != generation; });
+			if (mStop)
+				return;
+			generation = mGeneration;
+		}
+
+		runTasks();
+
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			--mBusyWorkers;
+		}
+		mJobFinished.notify_one();
+	}
+}
+
+//---------------------------------------------------------------------
+void gLTFImportThreadPool::runTasks (void)
+{
+	// Each thread takes the next task index until all tasks are taken
+	size_t i;
+	while ((i = mNextTask.fetch_add(1)) < mTaskCount)
+		(*mTask)(i);
+}
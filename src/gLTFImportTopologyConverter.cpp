@@ -0,0 +1,369 @@
+/*
+  -----------------------------------------------------------------------------
+  This source file is part of OGRE
+  (Object-oriented Graphics Rendering Engine)
+  For the latest info, see http://www.ogre3d.org/
+
+  Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+  -----------------------------------------------------------------------------
+*/
+
+#include <cstring>
+#include "gLTFImportTopologyConverter.h"
+
+static const unsigned int EMPTY_SLOT = 0xFFFFFFFF;
+
+//---------------------------------------------------------------------
+template <typename T> static void gatherAttribute (std::vector<T>& attribute, 
+	const std::vector<unsigned int>& sourceVertexIndices)
+{
+	if (attribute.empty())
+		return;
+
+	// The source indices are not necessarily increasing, so gather into a new vector
+	std::vector<T> gathered(sourceVertexIndices.size());
+	size_t count = sourceVertexIndices.size();
+	for (size_t i = 0; i < count; ++i)
+		gathered[i] = attribute[sourceVertexIndices[i]];
+	attribute.swap(gathered);
+}
+
+//---------------------------------------------------------------------
+template <typename T> static void hashAttribute (unsigned int& hash, 
+	const std::vector<T>& attribute, 
+	unsigned int vertexIndex)
+{
+	if (attribute.empty())
+		return;
+
+	// FNV-1a over the raw bytes of the attribute
+	const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&attribute[vertexIndex]);
+	for (size_t i = 0; i < sizeof(T); ++i)
+	{
+		hash ^= bytes[i];
+		hash *= 16777619u;
+	}
+}
+
+//---------------------------------------------------------------------
+template <typename T> static bool isAttributeEqual (const std::vector<T>& attribute, 
+	unsigned int vertexIndexA, 
+	unsigned int vertexIndexB)
+{
+	if (attribute.empty())
+		return true;
+
+	return memcmp(&attribute[vertexIndexA], &attribute[vertexIndexB], sizeof(T)) == 0;
+}
+
+//---------------------------------------------------------------------
+bool gLTFImportTopologyConverter::convertToIndexedList (gLTFStagedSubmesh& submesh, bool weld)
+{
+	unsigned int vertexCount = submesh.getVertexCount();
+	if (vertexCount == 0)
+		return false;
+
+	if (submesh.mMode == gLTFPrimitive::POINTS)
+	{
+		if (submesh.mHasIndices)
+			expandIndexedPoints(submesh);
+		return true;
+	}
+
+	// Non-indexed triangles; create an index buffer by welding the vertices
+	if (submesh.mMode == gLTFPrimitive::TRIANGLES && !submesh.mHasIndices && weld)
+	{
+		weldVertices(submesh);
+		return true;
+	}
+
+	// Determine the source index sequence; use the gLTF indices or the implicit sequence 0..n-1
+	if (submesh.mHasIndices)
+	{
+		mHelperSourceIndices.swap(submesh.mIndices);
+	}
+	else
+	{
+		mHelperSourceIndices.resize(vertexCount);
+		for (unsigned int i = 0; i < vertexCount; ++i)
+			mHelperSourceIndices[i] = i;
+	}
+
+	generateListIndices(submesh, mHelperSourceIndices);
+	return true;
+}
+
+//---------------------------------------------------------------------
+void gLTFImportTopologyConverter::generateListIndices (gLTFStagedSubmesh& submesh, 
+	const std::vector<unsigned int>& source)
+{
+	/* Lines and triangles that refer to a vertex that does not exist are dropped (like indexed points), so the
+	 * splitter, the bone partitioner and the edge list builder only get valid vertex indices.
+	 */
+	unsigned int vertexCount = submesh.getVertexCount();
+	size_t count = source.size();
+	size_t primitiveCount = 0;
+	size_t written = 0;
+	unsigned int v0, v1, v2;
+	std::vector<unsigned int>& indices = submesh.mIndices;
+	indices.clear();
+
+	switch (submesh.mMode)
+	{
+		case gLTFPrimitive::LINES:
+		{
+			primitiveCount = count / 2;
+			indices.resize(primitiveCount * 2);
+			for (size_t i = 0; i < primitiveCount; ++i)
+			{
+				v0 = source[2 * i];
+				v1 = source[2 * i + 1];
+				if (v0 >= vertexCount || v1 >= vertexCount)
+					continue;
+
+				indices[written++] = v0;
+				indices[written++] = v1;
+			}
+		}
+		break;
+		case gLTFPrimitive::LINE_STRIP:
+		case gLTFPrimitive::LINE_LOOP:
+		{
+			// A loop has one extra segment that connects the last vertex with the first
+			primitiveCount = count > 1 ? count - 1 : 0;
+			bool closeLoop = submesh.mMode == gLTFPrimitive::LINE_LOOP && count > 2;
+			indices.resize((primitiveCount + (closeLoop ? 1 : 0)) * 2);
+			for (size_t i = 0; i < primitiveCount; ++i)
+			{
+				v0 = source[i];
+				v1 = source[i + 1];
+				if (v0 >= vertexCount || v1 >= vertexCount)
+					continue;
+
+				indices[written++] = v0;
+				indices[written++] = v1;
+			}
+			if (closeLoop && source[count - 1] < vertexCount && source[0] < vertexCount)
+			{
+				indices[written++] = source[count - 1];
+				indices[written++] = source[0];
+			}
+		}
+		break;
+		case gLTFPrimitive::TRIANGLES:
+		{
+			primitiveCount = count / 3;
+			indices.resize(primitiveCount * 3);
+			for (size_t i = 0; i < primitiveCount; ++i)
+			{
+				v0 = source[3 * i];
+				v1 = source[3 * i + 1];
+				v2 = source[3 * i + 2];
+				if (v0 >= vertexCount || v1 >= vertexCount || v2 >= vertexCount)
+					continue;
+
+				indices[written++] = v0;
+				indices[written++] = v1;
+				indices[written++] = v2;
+			}
+		}
+		break;
+		case gLTFPrimitive::TRIANGLE_STRIP:
+		case gLTFPrimitive::TRIANGLE_FAN:
+		{
+			/* Triangle i of a strip is {v(i), v(i + 1 + i%2), v(i + 2 - i%2)}, which keeps the winding order
+			 * of the odd triangles. Triangle i of a fan is {v(i + 1), v(i + 2), v(0)}.
+			 * Degenerate triangles (often used to stitch strips) are dropped.
+			 */
+			bool isStrip = submesh.mMode == gLTFPrimitive::TRIANGLE_STRIP;
+			primitiveCount = count > 2 ? count - 2 : 0;
+			indices.resize(primitiveCount * 3);
+			for (size_t i = 0; i < primitiveCount; ++i)
+			{
+				if (isStrip)
+				{
+					v0 = source[i];
+					v1 = source[i + 1 + (i % 2)];
+					v2 = source[i + 2 - (i % 2)];
+				}
+				else
+				{
+					v0 = source[i + 1];
+					v1 = source[i + 2];
+					v2 = source[0];
+				}
+
+				if (v0 == v1 || v1 == v2 || v0 == v2)
+					continue;
+				if (v0 >= vertexCount || v1 >= vertexCount || v2 >= vertexCount)
+					continue;
+
+				indices[written++] = v0;
+				indices[written++] = v1;
+				indices[written++] = v2;
+			}
+		}
+		break;
+	}
+
+	indices.resize(written);
+
+	// Only lists remain
+	if (submesh.mMode == gLTFPrimitive::LINE_STRIP || submesh.mMode == gLTFPrimitive::LINE_LOOP)
+		submesh.mMode = gLTFPrimitive::LINES;
+	else if (submesh.mMode == gLTFPrimitive::TRIANGLE_STRIP || submesh.mMode == gLTFPrimitive::TRIANGLE_FAN)
+		submesh.mMode = gLTFPrimitive::TRIANGLES;
+	submesh.mHasIndices = true;
+}
+
+//---------------------------------------------------------------------
+void gLTFImportTopologyConverter::weldVertices (gLTFStagedSubmesh& submesh)
+{
+	unsigned int vertexCount = submesh.getVertexCount();
+	unsigned int triangleCount = vertexCount / 3;
+	vertexCount = triangleCount * 3;
+
+	// Open addressing hash table with at least twice the number of vertices; each slot holds a welded vertex index
+	unsigned int tableSize = 1;
+	while (tableSize < 2 * vertexCount)
+		tableSize <<= 1;
+	unsigned int mask = tableSize - 1;
+	mHelperHashTable.assign(tableSize, EMPTY_SLOT);
+
+	std::vector<unsigned int>& sourceVertexIndices = submesh.mSourceVertexIndices;
+	sourceVertexIndices.clear();
+	sourceVertexIndices.reserve(vertexCount);
+	submesh.mIndices.resize(vertexCount);
+
+	unsigned int slot;
+	unsigned int weldedIndex;
+	for (unsigned int i = 0; i < vertexCount; ++i)
+	{
+		slot = hashVertex(submesh, i) & mask;
+		weldedIndex = mHelperHashTable[slot];
+		while (weldedIndex != EMPTY_SLOT && !isVertexEqual(submesh, sourceVertexIndices[weldedIndex], i))
+		{
+			slot = (slot + 1) & mask;
+			weldedIndex = mHelperHashTable[slot];
+		}
+
+		if (weldedIndex == EMPTY_SLOT)
+		{
+			// New unique vertex
+			weldedIndex = sourceVertexIndices.size();
+			sourceVertexIndices.push_back(i);
+			mHelperHashTable[slot] = weldedIndex;
+		}
+
+		submesh.mIndices[i] = weldedIndex;
+	}
+
+	submesh.mHasIndices = true;
+
+	// Nothing welded; keep the vertices (and the 1:1 relation with the gLTF accessors)
+	if (sourceVertexIndices.size() == submesh.getVertexCount())
+	{
+		sourceVertexIndices.clear();
+		return;
+	}
+
+	gatherVertices(submesh, sourceVertexIndices);
+}
+
+//---------------------------------------------------------------------
+void gLTFImportTopologyConverter::expandIndexedPoints (gLTFStagedSubmesh& submesh)
+{
+	// Only keep the indices that point to an existing vertex
+	unsigned int vertexCount = submesh.getVertexCount();
+	std::vector<unsigned int>& sourceVertexIndices = submesh.mSourceVertexIndices;
+	sourceVertexIndices.clear();
+	sourceVertexIndices.reserve(submesh.mIndices.size());
+	std::vector<unsigned int>::const_iterator it;
+	std::vector<unsigned int>::const_iterator itEnd = submesh.mIndices.end();
+	for (it = submesh.mIndices.begin(); it != itEnd; ++it)
+	{
+		if (*it < vertexCount)
+			sourceVertexIndices.push_back(*it);
+	}
+
+	gatherVertices(submesh, sourceVertexIndices);
+	submesh.mIndices.clear();
+	submesh.mHasIndices = false;
+}
+
+//---------------------------------------------------------------------
+unsigned int gLTFImportTopologyConverter::hashVertex (const gLTFStagedSubmesh& submesh, unsigned int vertexIndex)
+{
+	unsigned int hash = 2166136261u;
+	hashAttribute(hash, submesh.mPositionsX, vertexIndex);
+	hashAttribute(hash, submesh.mPositionsY, vertexIndex);
+	hashAttribute(hash, submesh.mPositionsZ, vertexIndex);
+	hashAttribute(hash, submesh.mNormalsX, vertexIndex);
+	hashAttribute(hash, submesh.mNormalsY, vertexIndex);
+	hashAttribute(hash, submesh.mNormalsZ, vertexIndex);
+	hashAttribute(hash, submesh.mTangentsX, vertexIndex);
+	hashAttribute(hash, submesh.mTangentsY, vertexIndex);
+	hashAttribute(hash, submesh.mTangentsZ, vertexIndex);
+	hashAttribute(hash, submesh.mTangentsW, vertexIndex);
+	hashAttribute(hash, submesh.mColours, vertexIndex);
+	hashAttribute(hash, submesh.mTexcoords_0, vertexIndex);
+	hashAttribute(hash, submesh.mTexcoords_1, vertexIndex);
+	return hash;
+}
+
+//---------------------------------------------------------------------
+bool gLTFImportTopologyConverter::isVertexEqual (const gLTFStagedSubmesh& submesh, 
+	unsigned int vertexIndexA, 
+	unsigned int vertexIndexB)
+{
+	return isAttributeEqual(submesh.mPositionsX, vertexIndexA, vertexIndexB) &&
+		isAttributeEqual(submesh.mPositionsY, vertexIndexA, vertexIndexB) &&
+		isAttributeEqual(submesh.mPositionsZ, vertexIndexA, vertexIndexB) &&
+		isAttributeEqual(submesh.mNormalsX, vertexIndexA, vertexIndexB) &&
+		isAttributeEqual(submesh.mNormalsY, vertexIndexA, vertexIndexB) &&
+		isAttributeEqual(submesh.mNormalsZ, vertexIndexA, vertexIndexB) &&
+		isAttributeEqual(submesh.mTangentsX, vertexIndexA, vertexIndexB) &&
+		isAttributeEqual(submesh.mTangentsY, vertexIndexA, vertexIndexB) &&
+		isAttributeEqual(submesh.mTangentsZ, vertexIndexA, vertexIndexB) &&
+		isAttributeEqual(submesh.mTangentsW, vertexIndexA, vertexIndexB) &&
+		isAttributeEqual(submesh.mColours, vertexIndexA, vertexIndexB) &&
+		isAttributeEqual(submesh.mTexcoords_0, vertexIndexA, vertexIndexB) &&
+		isAttributeEqual(submesh.mTexcoords_1, vertexIndexA, vertexIndexB);
+}
+
+//---------------------------------------------------------------------
+void gLTFImportTopologyConverter::gatherVertices (gLTFStagedSubmesh& submesh, 
+	const std::vector<unsigned int>& sourceVertexIndices)
+{
+	gatherAttribute(submesh.mPositionsX, sourceVertexIndices);
+	gatherAttribute(submesh.mPositionsY, sourceVertexIndices);
+	gatherAttribute(submesh.mPositionsZ, sourceVertexIndices);
+	gatherAttribute(submesh.mNormalsX, sourceVertexIndices);
+	gatherAttribute(submesh.mNormalsY, sourceVertexIndices);
+	gatherAttribute(submesh.mNormalsZ, sourceVertexIndices);
+	gatherAttribute(submesh.mTangentsX, sourceVertexIndices);
+	gatherAttribute(submesh.mTangentsY, sourceVertexIndices);
+	gatherAttribute(submesh.mTangentsZ, sourceVertexIndices);
+	gatherAttribute(submesh.mTangentsW, sourceVertexIndices);
+	gatherAttribute(submesh.mColours, sourceVertexIndices);
+	gatherAttribute(submesh.mTexcoords_0, sourceVertexIndices);
+	gatherAttribute(submesh.mTexcoords_1, sourceVertexIndices);
+}
@@ -0,0 +1,251 @@
+/*
+  -----------------------------------------------------------------------------
+  This source file is part of OGRE
+  (Object-oriented Graphics Rendering Engine)
+  For the latest info, see http://www.ogre3d.org/
+
+  Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+  -----------------------------------------------------------------------------
+*/
+
+#include "gLTFImportVertexTransformer.h"
+#include <cmath>
+
+//---------------------------------------------------------------------
+void gLTFImportVertexTransformer::transformSubmesh (gLTFStagedSubmesh& submesh, const Ogre::Matrix4& matrix)
+{
+	// Positions
+	size_t count = submesh.mPositionsX.size();
+	if (count > 0)
+		transformPositions(&submesh.mPositionsX[0], &submesh.mPositionsY[0], &submesh.mPositionsZ[0], count, matrix);
+
+	Ogre::Matrix3 linear;
+	matrix.extract3x3Matrix(linear);
+	bool mirrored = linear.Determinant() < 0.0f;
+
+	// Normals; use the inverse-transpose. If the matrix is singular, the normals are left untouched
+	count = submesh.mNormalsX.size();
+	Ogre::Matrix3 inverse;
+	if (count > 0 && linear.Inverse(inverse))
+		transformDirections(&submesh.mNormalsX[0], &submesh.mNormalsY[0], &submesh.mNormalsZ[0], count, inverse.Transpose());
+
+	// Tangents
+	count = submesh.mTangentsX.size();
+	if (count > 0)
+	{
+		transformDirections(&submesh.mTangentsX[0], &submesh.mTangentsY[0], &submesh.mTangentsZ[0], count, linear);
+		if (mirrored)
+			flipHandedness(&submesh.mTangentsW[0], count);
+	}
+}
+
+//---------------------------------------------------------------------
+void gLTFImportVertexTransformer::transformPositions (float* x, float* y, float* z, size_t count, const Ogre::Matrix4& matrix)
+{
+	size_t i = 0;
+
+#ifdef GLTF_IMPORT_SSE2
+	// Broadcast the matrix elements; the last row is ignored, because node matrices are affine
+	const __m128 m00 = _mm_set1_ps(matrix[0][0]), m01 = _mm_set1_ps(matrix[0][1]), m02 = _mm_set1_ps(matrix[0][2]), m03 = _mm_set1_ps(matrix[0][3]);
+	const __m128 m10 = _mm_set1_ps(matrix[1][0]), m11 = _mm_set1_ps(matrix[1][1]), m12 = _mm_set1_ps(matrix[1][2]), m13 = _mm_set1_ps(matrix[1][3]);
+	const __m128 m20 = _mm_set1_ps(matrix[2][0]), m21 = _mm_set1_ps(matrix[2][1]), m22 = _mm_set1_ps(matrix[2][2]), m23 = _mm_set1_ps(matrix[2][3]);
+	__m128 vx, vy, vz;
+	for (; i + 4 <= count; i += 4)
+	{
+		vx = _mm_loadu_ps(x + i);
+		vy = _mm_loadu_ps(y + i);
+		vz = _mm_loadu_ps(z + i);
+		_mm_storeu_ps(x + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, vx), _mm_mul_ps(m01, vy)), _mm_add_ps(_mm_mul_ps(m02, vz), m03)));
+		_mm_storeu_ps(y + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(m10, vx), _mm_mul_ps(m11, vy)), _mm_add_ps(_mm_mul_ps(m12, vz), m13)));
+		_mm_storeu_ps(z + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(m20, vx), _mm_mul_ps(m21, vy)), _mm_add_ps(_mm_mul_ps(m22, vz), m23)));
+	}
+#endif
+
+	// Remaining vertices (or all vertices if SSE2 is not available)
+	float px, py, pz;
+	for (; i < count; ++i)
+	{
+		px = x[i];
+		py = y[i];
+		pz = z[i];
+		x[i] = matrix[0][0] * px + matrix[0][1] * py + matrix[0][2] * pz + matrix[0][3];
+		y[i] = matrix[1][0] * px + matrix[1][1] * py + matrix[1][2] * pz + matrix[1][3];
+		z[i] = matrix[2][0] * px + matrix[2][1] * py + matrix[2][2] * pz + matrix[2][3];
+	}
+}
+
+//---------------------------------------------------------------------
+void gLTFImportVertexTransformer::transformDirections (float* x, float* y, float* z, size_t count, const Ogre::Matrix3& matrix)
+{
+	size_t i = 0;
+
+#ifdef GLTF_IMPORT_SSE2
+	const __m128 m00 = _mm_set1_ps(matrix[0][0]), m01 = _mm_set1_ps(matrix[0][1]), m02 = _mm_set1_ps(matrix[0][2]);
+	const __m128 m10 = _mm_set1_ps(matrix[1][0]), m11 = _mm_set1_ps(matrix[1][1]), m12 = _mm_set1_ps(matrix[1][2]);
+	const __m128 m20 = _mm_set1_ps(matrix[2][0]), m21 = _mm_set1_ps(matrix[2][1]), m22 = _mm_set1_ps(matrix[2][2]);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	__m128 vx, vy, vz, tx, ty, tz, length, invLength;
+	for (; i + 4 <= count; i += 4)
+	{
+		vx = _mm_loadu_ps(x + i);
+		vy = _mm_loadu_ps(y + i);
+		vz = _mm_loadu_ps(z + i);
+		tx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, vx), _mm_mul_ps(m01, vy)), _mm_mul_ps(m02, vz));
+		ty = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m10, vx), _mm_mul_ps(m11, vy)), _mm_mul_ps(m12, vz));
+		tz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m20, vx), _mm_mul_ps(m21, vy)), _mm_mul_ps(m22, vz));
+
+		// Renormalize; zero length vectors remain zero (the mask clears the infinite reciprocal)
+		length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, tx), _mm_mul_ps(ty, ty)), _mm_mul_ps(tz, tz)));
+		invLength = _mm_and_ps(_mm_div_ps(one, length), _mm_cmpgt_ps(length, zero));
+		_mm_storeu_ps(x + i, _mm_mul_ps(tx, invLength));
+		_mm_storeu_ps(y + i, _mm_mul_ps(ty, invLength));
+		_mm_storeu_ps(z + i, _mm_mul_ps(tz, invLength));
+	}
+#endif
+
+	// Remaining vectors (or all vectors if SSE2 is not available)
+	float vx0, vy0, vz0, length0;
+	for (; i < count; ++i)
+	{
+		vx0 = matrix[0][0] * x[i] + matrix[0][1] * y[i] + matrix[0][2] * z[i];
+		vy0 = matrix[1][0] * x[i] + matrix[1][1] * y[i] + matrix[1][2] * z[i];
+		vz0 = matrix[2][0] * x[i] + matrix[2][1] * y[i] + matrix[2][2] * z[i];
+		length0 = sqrt(vx0 * vx0 + vy0 * vy0 + vz0 * vz0);
+		if (length0 > 0.0f)
+		{
+			vx0 /= length0;
+			vy0 /= length0;
+			vz0 /= length0;
+		}
+		x[i] = vx0;
+		y[i] = vy0;
+		z[i] = vz0;
+	}
+}
+
+//---------------------------------------------------------------------
+void gLTFImportVertexTransformer::flipHandedness (float* w, size_t count)
+{
+	size_t i = 0;
+
+#ifdef GLTF_IMPORT_SSE2
+	// Flip the sign bit
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+	for (; i + 4 <= count; i += 4)
+		_mm_storeu_ps(w + i, _mm_xor_ps(_mm_loadu_ps(w + i), signMask));
+#endif
+
+	for (; i < count; ++i)
+		w[i] = -w[i];
+}
+
+//---------------------------------------------------------------------
+bool gLTFImportVertexTransformer::computeMinMax (const float* x, 
+	const float* y, 
+	const float* z, 
+	size_t count, 
+	Ogre::Vector3& min, 
+	Ogre::Vector3& max)
+{
+	if (count == 0)
+		return false;
+
+	min = Ogre::Vector3(x[0], y[0], z[0]);
+	max = min;
+	size_t i = 0;
+
+#ifdef GLTF_IMPORT_SSE2
+	if (count >= 4)
+	{
+		// Keep 4 running minima/maxima per component and reduce them at the end
+		__m128 minX = _mm_loadu_ps(x), minY = _mm_loadu_ps(y), minZ = _mm_loadu_ps(z);
+		__m128 maxX = minX, maxY = minY, maxZ = minZ;
+		__m128 vx, vy, vz;
+		for (i = 4; i + 4 <= count; i += 4)
+		{
+			vx = _mm_loadu_ps(x + i);
+			vy = _mm_loadu_ps(y + i);
+			vz = _mm_loadu_ps(z + i);
+			minX = _mm_min_ps(minX, vx);
+			minY = _mm_min_ps(minY, vy);
+			minZ = _mm_min_ps(minZ, vz);
+			maxX = _mm_max_ps(maxX, vx);
+			maxY = _mm_max_ps(maxY, vy);
+			maxZ = _mm_max_ps(maxZ, vz);
+		}
+
+		float lanes[6][4];
+		_mm_storeu_ps(lanes[0], minX);
+		_mm_storeu_ps(lanes[1], minY);
+		_mm_storeu_ps(lanes[2], minZ);
+		_mm_storeu_ps(lanes[3], maxX);
+		_mm_storeu_ps(lanes[4], maxY);
+		_mm_storeu_ps(lanes[5], maxZ);
+		for (int lane = 0; lane < 4; ++lane)
+		{
+			min.x = lanes[0][lane] < min.x ? lanes[0][lane] : min.x;
+			min.y = lanes[1][lane] < min.y ? lanes[1][lane] : min.y;
+			min.z = lanes[2][lane] < min.z ? lanes[2][lane] : min.z;
+			max.x = lanes[3][lane] > max.x ? lanes[3][lane] : max.x;
+			max.y = lanes[4][lane] > max.y ? lanes[4][lane] : max.y;
+			max.z = lanes[5][lane] > max.z ? lanes[5][lane] : max.z;
+		}
+	}
+#endif
+
+	// Remaining positions (or all positions if SSE2 is not available)
+	for (; i < count; ++i)
+	{
+		min.x = x[i] < min.x ? x[i] : min.x;
+		min.y = y[i] < min.y ? y[i] : min.y;
+		min.z = z[i] < min.z ? z[i] : min.z;
+		max.x = x[i] > max.x ? x[i] : max.x;
+		max.y = y[i] > max.y ? y[i] : max.y;
+		max.z = z[i] > max.z ? z[i] : max.z;
+	}
+
+	return true;
+}
+
+//---------------------------------------------------------------------
+void gLTFImportVertexTransformer::transformAabb (Ogre::Vector3& min, Ogre::Vector3& max, const Ogre::Matrix4& matrix)
+{
+	/* Arvo's method: start with the translation and add the minimum and maximum contribution of each
+	 * matrix element; this gives the same result as transforming all 8 corners.
+	 */
+	Ogre::Vector3 newMin(matrix[0][3], matrix[1][3], matrix[2][3]);
+	Ogre::Vector3 newMax = newMin;
+	float a, b;
+	for (int row = 0; row < 3; ++row)
+	{
+		for (int column = 0; column < 3; ++column)
+		{
+			a = matrix[row][column] * min[column];
+			b = matrix[row][column] * max[column];
+			newMin[row] += a < b ? a : b;
+			newMax[row] += a < b ? b : a;
+		}
+	}
+
+	min = newMin;
+	max = newMax;
+}
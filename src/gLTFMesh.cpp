@@ -35,7 +35,7 @@ gLTFMesh::gLTFMesh (void) :
 	mMeshIndex(-1)
 {
 	mName = "";
-	mPrimitiveMap.clear();
+	mPrimitives.clear();
 }
 
 //---------------------------------------------------------------------
@@ -38,8 +38,7 @@ gLTFNode::gLTFNode(void) :
 	mHasRotation(false),
 	mHasScale(false),
 	mHasTranslation(false),
-	mTransformationCalculated(false),
-	mParentNode(0),
+	mParentNodeDerived(-1),
 	mNodeIndex(-1)
 {
 	mChildren.clear();
@@ -61,7 +60,7 @@ gLTFNode::gLTFNode(void) :
 	mTranslation[1] = 0.0f;
 	mTranslation[2] = 0.0f;
 	
-	mAnimationVector.clear();
+	mAnimationChannelsDerived.clear();
 }
 
 //---------------------------------------------------------------------
@@ -69,16 +68,3 @@ void gLTFNode::out (void)
 {
 	OUT << "***************** Debug: gLTFNode *****************\n";
 }
-
-//---------------------------------------------------------------------
-bool gLTFNode::hasAnimationName (const std::string& animationName)
-{
-	std::vector<gLTFAnimation>::iterator it;
-	std::vector<gLTFAnimation>::iterator itEnd = mAnimationVector.end();
-	for (it = mAnimationVector.begin(); it != itEnd; ++it)
-	{
-		if ((*it).mName == animationName)
-			return true;
-	}
-	return false;
-}
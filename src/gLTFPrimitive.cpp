@@ -42,10 +42,15 @@ gLTFPrimitive::gLTFPrimitive(void) :
 	mColor_0AccessorDerived(-1),
 	mJoints_0AccessorDerived(-1),
 	mWeights_0AccessorDerived(-1),
-	mPrimitiveIndex(-1)
+	mJoints_1AccessorDerived(-1),
+	mWeights_1AccessorDerived(-1),
+	mPrimitiveIndex(-1),
+	mPrunedBytesDerived(0)
 {
 	mMaterialNameDerived = "";
+	mPrunedAttributesDerived = "";
 	mAttributes.clear();
+	mTargets.clear();
 }
 
 //---------------------------------------------------------------------
@@ -36,7 +36,6 @@ gLTFSkin::gLTFSkin(void) :
 {
 	mName = "";
 	mJoints.clear();
-	mNodesDerived.clear();
 }
 
 //---------------------------------------------------------------------
@@ -0,0 +1,198 @@
+/*
+  -----------------------------------------------------------------------------
+  This source file is part of OGRE
+  (Object-oriented Graphics Rendering Engine)
+  For the latest info, see http://www.ogre3d.org/
+
+  Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+  -----------------------------------------------------------------------------
+*/
+
+#include <utility>
+#include "gLTFImportConstants.h"
+#include "gLTFStagedSubmesh.h"
+#include "gLTFPrimitive.h"
+
+//---------------------------------------------------------------------
+template <typename T> static void appendAttribute (std::vector<T>& destination, const std::vector<T>& source)
+{
+	destination.insert(destination.end(), source.begin(), source.end());
+}
+
+//---------------------------------------------------------------------
+gLTFStagedSubmesh::gLTFStagedSubmesh (void) :
+	mHasIndices(false),
+	mMode(gLTFPrimitive::TRIANGLES)
+{
+	clear();
+}
+
+//---------------------------------------------------------------------
+void gLTFStagedSubmesh::out (void)
+{
+	OUT << "***************** Debug: gLTFStagedSubmesh *****************\n";
+	OUT << "vertex count = " << getVertexCount() << "\n";
+	OUT << "index count = " << mIndices.size() << "\n";
+	OUT << "mMode = " << mMode << "\n";
+	if (mBounds.valid)
+	{
+		OUT << "bounds min = " << mBounds.min.x << ", " << mBounds.min.y << ", " << mBounds.min.z << "\n";
+		OUT << "bounds max = " << mBounds.max.x << ", " << mBounds.max.y << ", " << mBounds.max.z << "\n";
+		OUT << "bounds radius = " << mBounds.radius << "\n";
+	}
+}
+
+//---------------------------------------------------------------------
+void gLTFStagedSubmesh::clear (void)
+{
+	// Keep the capacity of the vectors; the object is reused for each primitive
+	resizePositions(0);
+	resizeNormals(0);
+	resizeTangents(0);
+	mColours.clear();
+	mTexcoords_0.clear();
+	mTexcoords_1.clear();
+	mIndices.clear();
+	mSourceVertexIndices.clear();
+	mBoneInfluences.clear();
+	mBonePalette.clear();
+	mHasIndices = false;
+	mMode = gLTFPrimitive::TRIANGLES;
+	mBounds = Bounds();
+}
+
+//---------------------------------------------------------------------
+unsigned int gLTFStagedSubmesh::getVertexCount (void) const
+{
+	return mPositionsX.size();
+}
+
+//---------------------------------------------------------------------
+unsigned int gLTFStagedSubmesh::getSourceVertexIndex (unsigned int vertexIndex) const
+{
+	if (mSourceVertexIndices.empty())
+		return vertexIndex;
+
+	return mSourceVertexIndices[vertexIndex];
+}
+
+//---------------------------------------------------------------------
+bool gLTFStagedSubmesh::needs32BitIndices (void) const
+{
+	// 16 bit indices can address vertex 0..65534; 0xFFFF is reserved as primitive restart index
+	return getVertexCount() > 0xFFFF;
+}
+
+//---------------------------------------------------------------------
+void gLTFStagedSubmesh::resizePositions (unsigned int count)
+{
+	mPositionsX.assign(count, 0.0f);
+	mPositionsY.assign(count, 0.0f);
+	mPositionsZ.assign(count, 0.0f);
+}
+
+//---------------------------------------------------------------------
+void gLTFStagedSubmesh::resizeNormals (unsigned int count)
+{
+	mNormalsX.assign(count, 0.0f);
+	mNormalsY.assign(count, 0.0f);
+	mNormalsZ.assign(count, 0.0f);
+}
+
+//---------------------------------------------------------------------
+void gLTFStagedSubmesh::resizeTangents (unsigned int count)
+{
+	mTangentsX.assign(count, 0.0f);
+	mTangentsY.assign(count, 0.0f);
+	mTangentsZ.assign(count, 0.0f);
+	mTangentsW.assign(count, 1.0f);
+}
+
+//---------------------------------------------------------------------
+void gLTFStagedSubmesh::swap (gLTFStagedSubmesh& other)
+{
+	mPositionsX.swap(other.mPositionsX);
+	mPositionsY.swap(other.mPositionsY);
+	mPositionsZ.swap(other.mPositionsZ);
+	mNormalsX.swap(other.mNormalsX);
+	mNormalsY.swap(other.mNormalsY);
+	mNormalsZ.swap(other.mNormalsZ);
+	mTangentsX.swap(other.mTangentsX);
+	mTangentsY.swap(other.mTangentsY);
+	mTangentsZ.swap(other.mTangentsZ);
+	mTangentsW.swap(other.mTangentsW);
+	mColours.swap(other.mColours);
+	mTexcoords_0.swap(other.mTexcoords_0);
+	mTexcoords_1.swap(other.mTexcoords_1);
+	mIndices.swap(other.mIndices);
+	mSourceVertexIndices.swap(other.mSourceVertexIndices);
+	mBoneInfluences.swap(other.mBoneInfluences);
+	mBonePalette.swap(other.mBonePalette);
+	std::swap(mHasIndices, other.mHasIndices);
+	std::swap(mMode, other.mMode);
+	std::swap(mBounds, other.mBounds);
+}
+
+//---------------------------------------------------------------------
+void gLTFStagedSubmesh::append (const gLTFStagedSubmesh& other)
+{
+	unsigned int vertexOffset = getVertexCount();
+
+	// Vertices
+	appendAttribute(mPositionsX, other.mPositionsX);
+	appendAttribute(mPositionsY, other.mPositionsY);
+	appendAttribute(mPositionsZ, other.mPositionsZ);
+	appendAttribute(mNormalsX, other.mNormalsX);
+	appendAttribute(mNormalsY, other.mNormalsY);
+	appendAttribute(mNormalsZ, other.mNormalsZ);
+	appendAttribute(mTangentsX, other.mTangentsX);
+	appendAttribute(mTangentsY, other.mTangentsY);
+	appendAttribute(mTangentsZ, other.mTangentsZ);
+	appendAttribute(mTangentsW, other.mTangentsW);
+	appendAttribute(mColours, other.mColours);
+	appendAttribute(mTexcoords_0, other.mTexcoords_0);
+	appendAttribute(mTexcoords_1, other.mTexcoords_1);
+	appendAttribute(mBoneInfluences, other.mBoneInfluences);
+
+	// Indices are offset by the number of vertices that were already present
+	size_t indexOffset = mIndices.size();
+	mIndices.resize(indexOffset + other.mIndices.size());
+	for (size_t i = 0; i < other.mIndices.size(); ++i)
+		mIndices[indexOffset + i] = other.mIndices[i] + vertexOffset;
+
+	// The relation with the gLTF vertices is lost
+	mSourceVertexIndices.clear();
+	mBonePalette.clear();
+
+	// Merge the bounds
+	if (!other.mBounds.valid)
+		return;
+	if (!mBounds.valid)
+	{
+		mBounds = other.mBounds;
+		return;
+	}
+	mBounds.min.makeFloor(other.mBounds.min);
+	mBounds.max.makeCeil(other.mBounds.max);
+	mBounds.center = (mBounds.min + mBounds.max) * 0.5f;
+	mBounds.radius = (mBounds.max - mBounds.min).length() * 0.5f;
+	mBounds.fromAccessor = mBounds.fromAccessor && other.mBounds.fromAccessor;
+}